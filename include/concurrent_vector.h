@@ -0,0 +1,291 @@
+/**
+ * @file    concurrent_vector.h
+ * @brief   Append-only sequencial container that many threads can fill at once. The elements live in
+ *          segments of doubling size that are never moved, so push_back only reserves a slot with an
+ *          atomic fetch_add, and references to the elements stay valid while the vector grows.
+ * @author  Bruna Hellen de Castro Dantas Barbosa
+ */
+
+#ifndef CONCURRENT_VECTOR_H
+#define CONCURRENT_VECTOR_H
+
+#include "vector.h"
+#include "index_iterator.h" // sc::detail::index_iterator, floor_log2
+
+#include <atomic> // std::atomic
+#include <limits> // std::numeric_limits
+
+
+namespace sc
+{
+
+	/**
+	 * Thread safety: push_back, emplace_back, grow_by, reserve, size, operator[], at and the iterators may
+	 * be used by any number of threads at once. An element can be read by another thread once that thread
+	 * is synchronized with the one that constructed it (a join, a mutex, an atomic flag, ...); size()
+	 * counts the slots handed out, including those still being constructed. clear(), to_vector() and the
+	 * destructor must not run concurrently with anything else. The allocator must be thread safe.
+	 *
+	 * The appending functions are noexcept: a slot is handed out before its segment is allocated and its
+	 * element constructed, and no other thread could fill it if that failed, so it terminates the program.
+	 */
+	template < typename T, typename Allocator = std::allocator< T > >
+	class concurrent_vector
+	{
+
+		public:
+
+			typedef Allocator allocator_type;
+			typedef size_t size_type;
+			typedef T value_type;
+			typedef detail::index_iterator< concurrent_vector, T > Iterator;
+			typedef detail::index_iterator< const concurrent_vector, const T > const_iterator;
+			typedef T& reference;
+			typedef const T& const_reference;
+			typedef T* pointer;
+
+		private:
+			typedef std::allocator_traits< allocator_type > alloc_traits;
+
+			template < typename C, typename U > friend class detail::index_iterator;
+
+			static const size_type first_log = 3; //<! The first segment holds 2^first_log elements.
+			static const size_type first_size = size_type( 1 ) << first_log;
+			static const size_type max_segments = std::numeric_limits< size_type >::digits - first_log;
+
+			allocator_type m_alloc; //<! Allocator of the segments, also used to construct the elements.
+			std::atomic< size_type > m_end; //<! Number of slots handed out.
+			std::atomic< pointer > m_segments[ max_segments ]; //<! Segment k holds the elements [first_size * (2^k - 1), first_size * (2^(k+1) - 1)).
+
+			static size_type segment_of( size_type index ){	return detail::floor_log2( index + first_size ) - first_log;	}
+			static size_type segment_base( size_type k ){	return ( first_size << k ) - first_size;	}
+			static size_type segment_size( size_type k ){	return first_size << k;	}
+
+			/**
+			 * @brief Returns segment k, allocating it if no thread did yet. Threads racing for the same segment
+			 * allocate it each, the first to publish it wins and the others release theirs.
+			 *
+			 * @param k
+			 * @return pointer
+			 */
+			pointer segment( size_type k )
+			{
+				pointer current = m_segments[k].load( std::memory_order_acquire );
+				if( current != nullptr ){	return current;	}
+
+				pointer fresh = alloc_traits::allocate( m_alloc, segment_size( k ) );
+				if( m_segments[k].compare_exchange_strong( current, fresh, std::memory_order_acq_rel, std::memory_order_acquire ) ){	return fresh;	}
+
+				alloc_traits::deallocate( m_alloc, fresh, segment_size( k ) );
+				return current;
+			}
+
+			/**
+			 * @brief Address of the element at index, whose segment must exist.
+			 *
+			 * @param index
+			 * @return pointer
+			 */
+			pointer slot( size_type index ) const
+			{
+				const size_type k = segment_of( index );
+				return m_segments[k].load( std::memory_order_acquire ) + ( index - segment_base( k ) );
+			}
+
+			/**
+			 * @brief Calls f( first, last ) on the runs of [begin, end) stored in the same segment.
+			 *
+			 * @param begin
+			 * @param end
+			 * @param f
+			 */
+			template < typename Function >
+			void for_each_run( size_type begin, size_type end, Function f ) const
+			{
+				while( begin != end )
+				{
+					const size_type k = segment_of( begin );
+					const size_type run = std::min( end, segment_base( k ) + segment_size( k ) ) - begin;
+					pointer first = slot( begin );
+					f( first, first + run );
+					begin += run;
+				}
+			}
+
+			/**
+			 * @brief Constructs the elements [index, index + n) from args, allocating their segments.
+			 *
+			 * @param index
+			 * @param n
+			 * @param args
+			 */
+			template < typename... Args >
+			void construct_slots( size_type index, size_type n, const Args&... args ) noexcept
+			{
+				for( size_type end = index + n; index != end; )
+				{
+					const size_type k = segment_of( index );
+					pointer first = segment( k ) + ( index - segment_base( k ) );
+					const size_type run = std::min( end, segment_base( k ) + segment_size( k ) ) - index;
+
+					for( pointer last = first + run; first != last; ++first ){	alloc_traits::construct( m_alloc, first, args... );	}
+					index += run;
+				}
+			}
+
+			void destroy_all( void )
+			{
+				allocator_type & alloc = m_alloc;
+				for_each_run( 0, size(), [&alloc]( pointer first, pointer last ){	detail::destroy( alloc, first, last );	} );
+			}
+
+		public:
+
+//############################# [I] SPECIAL MEMBERS
+
+			 /**
+			  * @brief Constructs an empty container, no segment is allocated until the first push_back.
+			  *
+			  * @param alloc
+			  */
+			 explicit concurrent_vector( const allocator_type & alloc = allocator_type() ): m_alloc(alloc), m_end(0)
+			 {
+			 	for( size_type k = 0; k < max_segments; ++k ){	m_segments[k].store( nullptr, std::memory_order_relaxed );	}
+			 }
+
+			 concurrent_vector( const concurrent_vector & ) = delete;
+			 concurrent_vector & operator= ( const concurrent_vector & ) = delete;
+
+			 ~concurrent_vector( )
+			 {
+			 	destroy_all();
+			 	for( size_type k = 0; k < max_segments; ++k )
+			 	{
+			 		pointer seg = m_segments[k].load( std::memory_order_relaxed );
+			 		if( seg != nullptr ){	alloc_traits::deallocate( m_alloc, seg, segment_size( k ) );	}
+			 	}
+			 }
+
+//############################# [II] IteratorS
+
+			 Iterator begin( void ){	return Iterator( this, 0 );	}
+			 Iterator end( void ){	return Iterator( this, size() );	}
+			 const_iterator begin( void ) const{	return cbegin();	}
+			 const_iterator end( void ) const{	return cend();	}
+			 const_iterator cbegin( void ) const{	return const_iterator( this, 0 );	}
+			 const_iterator cend( void ) const{	return const_iterator( this, size() );	}
+
+//############################# [III] Capacity
+
+			 size_type size( void ) const{	return m_end.load( std::memory_order_acquire );	}
+			 bool empty( void ) const{	return size() == 0;	}
+
+			 /**
+			  * @brief Allocates the segments of the first n_size elements, so pushing them allocates nothing.
+			  *
+			  * @param n_size
+			  */
+			 void reserve( size_type n_size )
+			 {
+			 	if( n_size == 0 ){	return;	}
+			 	for( size_type k = 0; k <= segment_of( n_size - 1 ); ++k ){	segment( k );	}
+			 }
+
+			 allocator_type get_allocator( void ) const{	return m_alloc;	}
+
+//############################# [IV] Modifiers
+
+			 /**
+			  * @brief Appends an element constructed from args. Lock-free: the slot is reserved with a single
+			  * fetch_add, and the elements already stored are never moved.
+			  *
+			  * @param args
+			  * @return Iterator to the new element.
+			  */
+			 template < typename... Args >
+			 Iterator emplace_back( Args&&... args ) noexcept
+			 {
+			 	const size_type index = m_end.fetch_add( 1, std::memory_order_relaxed );
+			 	const size_type k = segment_of( index );
+			 	alloc_traits::construct( m_alloc, segment( k ) + ( index - segment_base( k ) ), std::forward< Args >( args )... );
+
+			 	return Iterator( this, index );
+			 }
+
+			 Iterator push_back( const_reference ref ) noexcept{	return emplace_back( ref );	}
+			 Iterator push_back( value_type && ref ) noexcept{	return emplace_back( std::move( ref ) );	}
+
+			 /**
+			  * @brief Appends n value initialized elements at consecutive indices.
+			  *
+			  * @param n
+			  * @return Iterator to the first of them.
+			  */
+			 Iterator grow_by( size_type n ) noexcept
+			 {
+			 	const size_type index = m_end.fetch_add( n, std::memory_order_relaxed );
+			 	construct_slots( index, n );
+			 	return Iterator( this, index );
+			 }
+
+			 /**
+			  * @brief Appends n copies of ref at consecutive indices.
+			  *
+			  * @param n
+			  * @param ref
+			  * @return Iterator to the first of them.
+			  */
+			 Iterator grow_by( size_type n, const_reference ref ) noexcept
+			 {
+			 	const size_type index = m_end.fetch_add( n, std::memory_order_relaxed );
+			 	construct_slots( index, n, ref );
+			 	return Iterator( this, index );
+			 }
+
+			 /**
+			  * @brief Destroys the elements, keeping the segments. Not thread safe.
+			  *
+			  */
+			 void clear( void )
+			 {
+			 	destroy_all();
+			 	m_end.store( 0, std::memory_order_release );
+			 }
+
+//#############################  [V] Element access
+
+			 const_reference operator[]( size_type posi ) const{	return *slot( posi );	}
+
+			 reference operator[]( size_type n )
+			 {
+			 	if( n >= size() ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return *slot( n );
+			 }
+
+			 const_reference at( size_type n ) const
+			 {
+			 	if( n >= size() ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return *slot( n );
+			 }
+
+			 reference at( size_type n )
+			 {
+			 	if( n >= size() ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return *slot( n );
+			 }
+
+			 /**
+			  * @brief Copies the elements into a contiguous sc::vector, one segment at a time. Not thread safe.
+			  *
+			  * @return sc::vector< value_type >
+			  */
+			 sc::vector< value_type > to_vector( void ) const
+			 {
+			 	sc::vector< value_type > flat( size() );
+			 	for_each_run( 0, size(), [&flat]( pointer first, pointer last ){	flat.insert( flat.end(), first, last );	} );
+			 	return flat;
+			 }
+	};
+};
+
+#endif
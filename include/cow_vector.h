@@ -0,0 +1,314 @@
+/**
+ * @file    cow_vector.h
+ * @brief   Copy-on-write sequencial container: copies of a sc::cow_vector< T > share one reference counted
+ *          sc::vector, and a copy gets its own only when it is first modified. Copies that are only read
+ *          cost an atomic increment instead of an allocation and a copy of every element.
+ * @author  Bruna Hellen de Castro Dantas Barbosa
+ */
+
+#ifndef COW_VECTOR_H
+#define COW_VECTOR_H
+
+#include "vector.h"
+
+#include <atomic> // std::atomic
+
+
+namespace sc
+{
+
+	/**
+	 * Thread safety: cow_vectors sharing a buffer may be read, copied, modified and destroyed from
+	 * different threads at once, the reference count being atomic; a single cow_vector is as thread safe
+	 * as a sc::vector.
+	 *
+	 * Element references and iterators handed out by the non-const accessors (operator[], at, front, back,
+	 * begin, end, data, insert, erase) could otherwise write through to later copies, so once one of them
+	 * is called, copies of this vector copy the elements right away. set() writes an element without that.
+	 */
+	template < typename T, typename Allocator = std::allocator< T > >
+	class cow_vector
+	{
+
+		public:
+
+			typedef sc::vector< T, Allocator > vector_type;
+			typedef Allocator allocator_type;
+			typedef size_t size_type;
+			typedef T value_type;
+			typedef typename vector_type::Iterator Iterator;
+			typedef typename vector_type::const_iterator const_iterator;
+			typedef T& reference;
+			typedef const T& const_reference;
+			typedef T* pointer;
+
+		private:
+
+			/// Buffer shared by the copies.
+			struct shared
+			{
+				std::atomic< size_type > refs; //<! cow_vectors pointing to this buffer.
+				bool exposed; //<! A mutable reference or iterator was handed out, the buffer can't be shared anymore.
+				vector_type elements; //<! The elements.
+
+				explicit shared( vector_type && model ): refs(1), exposed(false), elements(std::move(model)){	/* Empty */	}
+			};
+
+			typedef typename std::allocator_traits< allocator_type >::template rebind_alloc< shared > shared_allocator;
+			typedef std::allocator_traits< shared_allocator > shared_traits;
+
+			shared * m_shared; //<! Buffer of the elements, nullptr while the vector has never held any.
+
+			/// Empty vector read by the const members while m_shared is nullptr.
+			static const vector_type & nothing( void )
+			{
+				static const vector_type empty;
+				return empty;
+			}
+
+			static shared * make_shared( vector_type && model )
+			{
+				shared_allocator alloc( model.get_allocator() );
+				shared * block = shared_traits::allocate( alloc, 1 );
+				try{	shared_traits::construct( alloc, block, std::move( model ) );	}
+				catch( ... ){	shared_traits::deallocate( alloc, block, 1 ); throw;	}
+				return block;
+			}
+
+			static void release( shared * block ) noexcept
+			{
+				if( block == nullptr or block->refs.fetch_sub( 1, std::memory_order_acq_rel ) != 1 ){	return;	}
+
+				shared_allocator alloc( block->elements.get_allocator() );
+				shared_traits::destroy( alloc, block );
+				shared_traits::deallocate( alloc, block, 1 );
+			}
+
+			/// Buffer to share with a copy of this vector: this one, or a copy of it once it was exposed.
+			static shared * share( shared * block )
+			{
+				if( block == nullptr ){	return nullptr;	}
+				if( block->exposed ){	return make_shared( vector_type( block->elements ) );	}
+
+				block->refs.fetch_add( 1, std::memory_order_relaxed );
+				return block;
+			}
+
+			const vector_type & view( void ) const{	return m_shared != nullptr ? m_shared->elements : nothing();	}
+
+			/**
+			 * @brief The elements, made private to this vector first: a shared buffer is copied (detached)
+			 * and released. The elements are unchanged if the copy throws.
+			 *
+			 * @return vector_type&
+			 */
+			vector_type & edit( void )
+			{
+				if( m_shared == nullptr ){	m_shared = make_shared( vector_type() );	}
+				else if( m_shared->refs.load( std::memory_order_acquire ) != 1 )
+				{
+					shared * copy = make_shared( vector_type( m_shared->elements ) );
+					release( m_shared );
+					m_shared = copy;
+				}
+				return m_shared->elements;
+			}
+
+			/// edit() for the members returning mutable references or iterators.
+			vector_type & expose( void )
+			{
+				vector_type & elements = edit();
+				m_shared->exposed = true;
+				return elements;
+			}
+
+			size_type index_of( const_iterator position ) const{	return position - view().cbegin();	}
+
+		public:
+
+//############################# [I] SPECIAL MEMBERS
+
+			 /**
+			  * @brief Constructs an empty container, nothing is allocated until the first element is added.
+			  *
+			  */
+			 cow_vector( ): m_shared(nullptr){	/* Empty */	}
+
+			 /**
+			  * @brief Takes the elements of model, which becomes the shared buffer.
+			  *
+			  * @param model
+			  */
+			 explicit cow_vector( vector_type model ): m_shared(make_shared( std::move( model ) )){	/* Empty */	}
+
+			 template < typename InputItr, typename = detail::require_iterator< InputItr > >
+			 cow_vector( InputItr first, InputItr last ): cow_vector( vector_type( first, last ) ){	/* Empty */	}
+
+			 cow_vector( std::initializer_list< T > ilist ): cow_vector( vector_type( ilist ) ){	/* Empty */	}
+
+			 /**
+			  * @brief Shares the buffer of model: O(1), nothing is allocated or copied.
+			  *
+			  * @param model
+			  */
+			 cow_vector( const cow_vector & model ): m_shared(share( model.m_shared )){	/* Empty */	}
+
+			 cow_vector( cow_vector && model ) noexcept: m_shared(model.m_shared){	model.m_shared = nullptr;	}
+
+			 cow_vector & operator= ( cow_vector model ) noexcept
+			 {
+			 	swap( model );
+			 	return *this;
+			 }
+
+			 ~cow_vector( ){	release( m_shared );	}
+
+			 void swap( cow_vector & other ) noexcept{	std::swap( m_shared, other.m_shared );	}
+
+			 /// Number of cow_vectors sharing the buffer, 0 for an empty vector that never allocated one.
+			 size_type use_count( void ) const{	return m_shared != nullptr ? m_shared->refs.load( std::memory_order_relaxed ) : 0;	}
+
+			 /// The elements, read only; copy them to get a sc::vector of its own.
+			 const vector_type & get( void ) const{	return view();	}
+
+//############################# [II] IteratorS
+
+			 Iterator begin( void ){	return expose().begin();	}
+			 Iterator end( void ){	return expose().end();	}
+			 const_iterator begin( void ) const{	return view().cbegin();	}
+			 const_iterator end( void ) const{	return view().cend();	}
+			 const_iterator cbegin( void ) const{	return view().cbegin();	}
+			 const_iterator cend( void ) const{	return view().cend();	}
+
+//############################# [III] Capacity
+
+			 size_type size( void ) const{	return view().size();	}
+			 bool empty( void ) const{	return view().empty();	}
+			 size_type capacity( void ) const{	return view().capacity();	}
+
+			 void reserve( size_type n_size ){	if( n_size > capacity() ){	edit().reserve( n_size );	}	}
+			 void shrink_to_fit( void ){	if( capacity() != size() ){	edit().shrink_to_fit();	}	}
+
+//############################# [IV] Modifiers
+
+			 /**
+			  * @brief Removes every element. A shared buffer is left to the other copies instead of being
+			  * copied and then cleared.
+			  *
+			  */
+			 void clear( void )
+			 {
+			 	if( m_shared != nullptr and m_shared->refs.load( std::memory_order_acquire ) != 1 ){	release( m_shared ); m_shared = nullptr;	}
+			 	else if( m_shared != nullptr ){	m_shared->elements.clear();	}
+			 }
+
+			 template < typename... Args >
+			 void emplace_back( Args&&... args ){	edit().emplace_back( std::forward< Args >( args )... );	}
+
+			 void push_back( const_reference value ){	edit().push_back( value );	}
+			 void push_back( value_type && value ){	edit().push_back( std::move( value ) );	}
+
+			 void pop_back( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("Can't pop out of an empty vector \n");}
+			 	edit().pop_back();
+			 }
+
+			 /**
+			  * @brief Assigns value to the element at index n, without exposing the buffer like operator[].
+			  *
+			  * @param n
+			  * @param value
+			  */
+			 void set( size_type n, const_reference value )
+			 {
+			 	if( n >= size() ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	edit()[n] = value;
+			 }
+
+			 void set( size_type n, value_type && value )
+			 {
+			 	if( n >= size() ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	edit()[n] = std::move( value );
+			 }
+
+			 Iterator insert( const_iterator position, const_reference value )
+			 {
+			 	const size_type index = index_of( position );
+			 	vector_type & elements = expose();
+			 	return elements.insert( elements.begin() + index, value );
+			 }
+
+			 Iterator insert( const_iterator position, value_type && value )
+			 {
+			 	const size_type index = index_of( position );
+			 	vector_type & elements = expose();
+			 	return elements.insert( elements.begin() + index, std::move( value ) );
+			 }
+
+			 template < typename InputItr, typename = detail::require_iterator< InputItr > >
+			 Iterator insert( const_iterator position, InputItr first, InputItr last )
+			 {
+			 	const size_type index = index_of( position );
+			 	vector_type & elements = expose();
+			 	return elements.insert( elements.begin() + index, first, last );
+			 }
+
+			 Iterator erase( const_iterator first, const_iterator last )
+			 {
+			 	const size_type index = index_of( first );
+			 	const size_type count = last - first;
+			 	vector_type & elements = expose();
+			 	return elements.erase( elements.begin() + index, elements.begin() + index + count );
+			 }
+
+			 Iterator erase( const_iterator position )
+			 {
+			 	const size_type index = index_of( position );
+			 	vector_type & elements = expose();
+			 	return elements.erase( elements.begin() + index );
+			 }
+
+//#############################  [V] Element access
+
+			 const_reference operator[]( size_type n ) const{	return view()[n];	}
+			 reference operator[]( size_type n ){	return expose()[n];	}
+
+			 const_reference at( size_type n ) const{	return view().at( n );	}
+
+			 reference at( size_type n )
+			 {
+			 	if( n >= size() ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return expose()[n];
+			 }
+
+			 const_reference front( void ) const{	return view().front();	}
+			 const_reference back( void ) const{	return view().back();	}
+
+			 reference front( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :(\n");}
+			 	return expose()[0];
+			 }
+
+			 reference back( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :( \n");}
+			 	return expose()[ size() - 1 ];
+			 }
+
+			 const T * data( void ) const{	return view().data();	}
+			 T * data( void ){	return expose().data();	}
+
+//############################# [VI] Operators
+
+			 friend bool operator== ( const cow_vector & lhs, const cow_vector & rhs )
+			 {
+			 	return lhs.m_shared == rhs.m_shared or lhs.view() == rhs.view();
+			 }
+
+			 friend bool operator!= ( const cow_vector & lhs, const cow_vector & rhs ){	return not ( lhs == rhs );	}
+	};
+};
+
+#endif
@@ -0,0 +1,439 @@
+/**
+ * @file    flat_map.h
+ * @brief   Sorted associative container on two sc::vector columns: sc::flat_map< K, V > keeps its keys
+ *          sorted in one array and the values, in the same order, in another, so the binary search of a
+ *          lookup only streams keys through the cache. Same search and bulk insertion as sc::flat_set.
+ * @author  Bruna Hellen de Castro Dantas Barbosa
+ */
+
+#ifndef FLAT_MAP_H
+#define FLAT_MAP_H
+
+#include "flat_set.h" // sc::sorted_unique, sc::detail::branchless_lower_bound
+
+#include <utility> // std::pair, std::move_if_noexcept
+
+
+namespace sc
+{
+
+	/**
+	 * Random access iterator over the entries of a flat_map. Keys and values live in separate columns, so
+	 * dereferencing returns a pair of references by value, and the iterator is an input iterator as far
+	 * as the STL is concerned.
+	 */
+	template < typename Container, typename Reference >
+	class flat_map_iterator
+	{
+		public:
+
+			typedef std::ptrdiff_t difference_type;
+			typedef typename Container::value_type value_type;
+			typedef Reference reference;
+			typedef std::input_iterator_tag iterator_category;
+
+			/// Gives it->first and it->second to the pair returned by value.
+			struct pointer
+			{
+				reference entry;
+				const reference * operator-> ( void ) const{	return &entry;	}
+			};
+
+			flat_map_iterator( Container * container = nullptr, difference_type index = 0 ): m_container(container), m_index(index){	/* Empty */	}
+
+			/// Iterator to const_iterator.
+			template < typename C, typename R, typename = typename std::enable_if< std::is_convertible< C*, Container* >::value >::type >
+			flat_map_iterator( const flat_map_iterator< C, R > & other ): m_container(other.m_container), m_index(other.m_index){	/* Empty */	}
+
+			difference_type index( void ) const{	return m_index;	}
+
+			reference operator* ( void ) const{	return m_container->entry( m_index );	}
+			pointer operator-> ( void ) const{	return pointer{ m_container->entry( m_index ) };	}
+			reference operator[] ( difference_type n ) const{	return m_container->entry( m_index + n );	}
+
+			flat_map_iterator & operator++ ( void ){	++m_index; return *this;	}
+			flat_map_iterator operator++ ( int ){	flat_map_iterator old( *this ); ++m_index; return old;	}
+			flat_map_iterator & operator-- ( void ){	--m_index; return *this;	}
+			flat_map_iterator operator-- ( int ){	flat_map_iterator old( *this ); --m_index; return old;	}
+			flat_map_iterator & operator+= ( difference_type n ){	m_index += n; return *this;	}
+			flat_map_iterator & operator-= ( difference_type n ){	m_index -= n; return *this;	}
+
+			friend flat_map_iterator operator+ ( flat_map_iterator it, difference_type n ){	return it += n;	}
+			friend flat_map_iterator operator+ ( difference_type n, flat_map_iterator it ){	return it += n;	}
+			friend flat_map_iterator operator- ( flat_map_iterator it, difference_type n ){	return it -= n;	}
+			friend difference_type operator- ( const flat_map_iterator & a, const flat_map_iterator & b ){	return a.m_index - b.m_index;	}
+
+			friend bool operator== ( const flat_map_iterator & a, const flat_map_iterator & b ){	return a.m_index == b.m_index;	}
+			friend bool operator!= ( const flat_map_iterator & a, const flat_map_iterator & b ){	return a.m_index != b.m_index;	}
+			friend bool operator< ( const flat_map_iterator & a, const flat_map_iterator & b ){	return a.m_index < b.m_index;	}
+			friend bool operator> ( const flat_map_iterator & a, const flat_map_iterator & b ){	return a.m_index > b.m_index;	}
+			friend bool operator<= ( const flat_map_iterator & a, const flat_map_iterator & b ){	return a.m_index <= b.m_index;	}
+			friend bool operator>= ( const flat_map_iterator & a, const flat_map_iterator & b ){	return a.m_index >= b.m_index;	}
+
+		private:
+			template < typename C, typename R > friend class flat_map_iterator;
+
+			Container * m_container;
+			difference_type m_index;
+	};
+
+	/**
+	 * @brief Map of unique keys to values, stored as a sorted key column and a value column.
+	 *
+	 * @tparam Key Key type.
+	 * @tparam T Value type.
+	 * @tparam Compare Strict weak order of the keys.
+	 *
+	 * Same costs and build mode as sc::flat_set: until sort_unique, after append_unsorted, only size,
+	 * append_unsorted, sort_unique and clear may be called. Inserting or erasing invalidates every iterator
+	 * and every reference to a value.
+	 */
+	template < typename Key, typename T, typename Compare = std::less< Key >,
+			typename KeyAllocator = std::allocator< Key >, typename MappedAllocator = std::allocator< T > >
+	class flat_map
+	{
+
+		public:
+
+			typedef sc::vector< Key, KeyAllocator > key_container_type;
+			typedef sc::vector< T, MappedAllocator > mapped_container_type;
+			typedef Key key_type;
+			typedef T mapped_type;
+			typedef std::pair< Key, T > value_type;
+			typedef Compare key_compare;
+			typedef size_t size_type;
+			typedef std::pair< const Key &, T & > reference;
+			typedef std::pair< const Key &, const T & > const_reference;
+			typedef flat_map_iterator< flat_map, reference > Iterator;
+			typedef flat_map_iterator< const flat_map, const_reference > const_iterator;
+
+		private:
+
+			template < typename C, typename R > friend class flat_map_iterator;
+
+			key_container_type m_keys; //<! The sorted unique keys, then the ones added by append_unsorted.
+			mapped_container_type m_values; //<! m_values[i] is the value of m_keys[i].
+			size_type m_sorted; //<! Number of entries at the front of the columns that are sorted and unique.
+			key_compare m_comp; //<! Order of the keys.
+
+			reference entry( size_type index ){	return reference( m_keys[ index ], m_values[ index ] );	}
+			const_reference entry( size_type index ) const{	return const_reference( m_keys[ index ], m_values[ index ] );	}
+
+			bool is_sorted( void ) const{	return m_sorted == m_keys.size();	}
+
+			size_type lower_index( const key_type & key ) const
+			{
+				assert( is_sorted() );
+				return detail::branchless_lower_bound( m_keys.data(), m_keys.size(), key, m_comp ) - m_keys.data();
+			}
+
+			size_type upper_index( const key_type & key ) const
+			{
+				assert( is_sorted() );
+				return detail::branchless_upper_bound( m_keys.data(), m_keys.size(), key, m_comp ) - m_keys.data();
+			}
+
+			/// Index of key, size() if it isn't in the map.
+			size_type index_of( const key_type & key ) const
+			{
+				const size_type index = lower_index( key );
+				return index != m_keys.size() and not m_comp( key, m_keys[ index ] ) ? index : m_keys.size();
+			}
+
+			/**
+			 * @brief Inserts an entry at index, in both columns. If the value can't be inserted, the key is
+			 * taken out again.
+			 *
+			 */
+			template < typename K, typename... Args >
+			void insert_at( size_type index, K && key, Args&&... args )
+			{
+				m_keys.insert( m_keys.begin() + index, std::forward< K >( key ) );
+				try{	m_values.emplace( m_values.begin() + index, std::forward< Args >( args )... );	}
+				catch( ... ){	m_keys.erase( m_keys.begin() + index ); throw;	}
+				++m_sorted;
+			}
+
+			template < typename K, typename... Args >
+			std::pair< Iterator, bool > try_insert( K && key, Args&&... args )
+			{
+				const size_type index = lower_index( key );
+				if( index != m_keys.size() and not m_comp( key, m_keys[ index ] ) ){	return std::make_pair( Iterator( this, index ), false );	}
+
+				insert_at( index, std::forward< K >( key ), std::forward< Args >( args )... );
+				return std::make_pair( Iterator( this, index ), true );
+			}
+
+			void check_columns( void ) const
+			{
+				if( m_keys.size() != m_values.size() ){	throw std::invalid_argument("A flat_map needs as many values as keys.\n");	}
+			}
+
+		public:
+
+//############################# [I] SPECIAL MEMBERS
+
+			 /**
+			  * @brief Constructs an empty map.
+			  *
+			  * @param comp
+			  */
+			 explicit flat_map( const key_compare & comp = key_compare() ): m_sorted(0), m_comp(comp){	/* Empty */	}
+
+			 /**
+			  * @brief Takes the columns keys and values, in any order and with duplicate keys: the entries are
+			  * sorted and the first of each run of equal keys is kept. std::invalid_argument if they don't
+			  * have the same size.
+			  *
+			  * @param keys
+			  * @param values
+			  * @param comp
+			  */
+			 flat_map( key_container_type keys, mapped_container_type values, const key_compare & comp = key_compare() ):
+			 	m_keys(std::move(keys)), m_values(std::move(values)), m_sorted(0), m_comp(comp)
+			 {
+			 	check_columns();
+			 	sort_unique();
+			 }
+
+			 /**
+			  * @brief Takes the columns keys and values, whose keys must already be sorted and unique.
+			  *
+			  * @param keys
+			  * @param values
+			  * @param comp
+			  */
+			 flat_map( sorted_unique_t, key_container_type keys, mapped_container_type values, const key_compare & comp = key_compare() ):
+			 	m_keys(std::move(keys)), m_values(std::move(values)), m_sorted(m_keys.size()), m_comp(comp)
+			 {
+			 	check_columns();
+			 	assert( std::adjacent_find( m_keys.cbegin(), m_keys.cend(), [this]( const Key & a, const Key & b ){	return not m_comp( a, b );	} ) == m_keys.cend() );
+			 }
+
+			 /**
+			  * @brief Constructs the map from a range of pairs, keeping the first of equal keys.
+			  *
+			  */
+			 template < typename InputItr, typename = detail::require_iterator< InputItr > >
+			 flat_map( InputItr first, InputItr last, const key_compare & comp = key_compare() ): flat_map( comp )
+			 {
+			 	insert_range( first, last );
+			 }
+
+			 flat_map( std::initializer_list< value_type > ilist, const key_compare & comp = key_compare() ): flat_map( ilist.begin(), ilist.end(), comp ){	/* Empty */	}
+
+			 void swap( flat_map & other ) noexcept
+			 {
+			 	using std::swap;
+			 	m_keys.swap( other.m_keys );
+			 	m_values.swap( other.m_values );
+			 	swap( m_sorted, other.m_sorted );
+			 	swap( m_comp, other.m_comp );
+			 }
+
+			 key_compare key_comp( void ) const{	return m_comp;	}
+
+			 /// The sorted keys, as one contiguous array.
+			 const key_container_type & keys( void ) const{	return m_keys;	}
+
+			 /// The values, in the order of keys().
+			 const mapped_container_type & values( void ) const{	return m_values;	}
+
+//############################# [II] IteratorS
+
+			 Iterator begin( void ){	return Iterator( this, 0 );	}
+			 Iterator end( void ){	return Iterator( this, m_keys.size() );	}
+			 const_iterator begin( void ) const{	return cbegin();	}
+			 const_iterator end( void ) const{	return cend();	}
+			 const_iterator cbegin( void ) const{	return const_iterator( this, 0 );	}
+			 const_iterator cend( void ) const{	return const_iterator( this, m_keys.size() );	}
+
+//############################# [III] Capacity
+
+			 size_type size( void ) const{	return m_keys.size();	}
+			 bool empty( void ) const{	return m_keys.empty();	}
+
+			 void reserve( size_type n_size )
+			 {
+			 	m_keys.reserve( n_size );
+			 	m_values.reserve( n_size );
+			 }
+
+			 void shrink_to_fit( void )
+			 {
+			 	m_keys.shrink_to_fit();
+			 	m_values.shrink_to_fit();
+			 }
+
+//############################# [IV] Modifiers
+
+			 void clear( void )
+			 {
+			 	m_keys.clear();
+			 	m_values.clear();
+			 	m_sorted = 0;
+			 }
+
+			 /**
+			  * @brief Inserts entry unless its key is already there, shifting the greater entries up.
+			  *
+			  * @param entry
+			  * @return The position of the key and whether the entry was inserted.
+			  */
+			 std::pair< Iterator, bool > insert( const value_type & entry ){	return try_insert( entry.first, entry.second );	}
+			 std::pair< Iterator, bool > insert( value_type && entry ){	return try_insert( std::move( entry.first ), std::move( entry.second ) );	}
+
+			 /**
+			  * @brief Inserts key with a value constructed from args, unless key is already there; args are
+			  * left untouched then.
+			  *
+			  */
+			 template < typename... Args >
+			 std::pair< Iterator, bool > try_emplace( const key_type & key, Args&&... args ){	return try_insert( key, std::forward< Args >( args )... );	}
+
+			 template < typename... Args >
+			 std::pair< Iterator, bool > try_emplace( key_type && key, Args&&... args ){	return try_insert( std::move( key ), std::forward< Args >( args )... );	}
+
+			 /**
+			  * @brief Inserts the pairs of [first, last) whose key isn't in the map yet: they are appended,
+			  * sorted among themselves and merged with the map in one pass, instead of shifting the tail of
+			  * both columns once per entry.
+			  *
+			  * @param first
+			  * @param last
+			  */
+			 template < typename InputItr, typename = detail::require_iterator< InputItr > >
+			 void insert_range( InputItr first, InputItr last )
+			 {
+			 	assert( is_sorted() );
+			 	for( ; first != last; ++first ){	append_unsorted( first->first, first->second );	}
+			 	sort_unique();
+			 }
+
+			 void insert_range( std::initializer_list< value_type > ilist ){	insert_range( ilist.begin(), ilist.end() );	}
+
+			 /**
+			  * @brief Appends an entry without looking for its place; the map can't be searched until
+			  * sort_unique.
+			  *
+			  * @param key
+			  * @param value
+			  */
+			 template < typename K, typename V >
+			 void append_unsorted( K && key, V && value )
+			 {
+			 	m_keys.push_back( std::forward< K >( key ) );
+			 	try{	m_values.push_back( std::forward< V >( value ) );	}
+			 	catch( ... ){	m_keys.pop_back(); throw;	}
+			 }
+
+			 /**
+			  * @brief Sorts the entries added by append_unsorted (or insert_range) and merges them with the
+			  * sorted ones into new columns, in one pass that also drops the duplicates, keeping the entry
+			  * that was in the map or else the first appended. If it throws, every entry is still there but
+			  * the map has to be sorted again.
+			  *
+			  */
+			 void sort_unique( void )
+			 {
+			 	const size_type sorted = m_sorted, n = m_keys.size();
+			 	if( sorted == n ){	return;	}
+			 	m_sorted = 0;
+
+			 	// The appended entries are sorted through their indices, so neither column moves until the merge.
+			 	sc::vector< size_type > order( n - sorted );
+			 	for( size_type i = sorted; i < n; ++i ){	order.push_back( i );	}
+			 	const key_container_type & old_keys = m_keys;
+			 	const key_compare & comp = m_comp;
+			 	std::stable_sort( order.begin(), order.end(), [&old_keys, &comp]( size_type a, size_type b ){	return comp( old_keys[a], old_keys[b] );	} );
+
+			 	key_container_type keys( n, m_keys.get_allocator() );
+			 	mapped_container_type values( n, m_values.get_allocator() );
+			 	size_type i = 0, j = 0;
+			 	while( i < sorted or j < order.size() )
+			 	{
+			 		// On equal keys the entry already in the map goes first, and the later ones are dropped.
+			 		const size_type row = j == order.size() or ( i < sorted and not m_comp( m_keys[ order[j] ], m_keys[i] ) ) ? i++ : order[ j++ ];
+			 		if( not keys.empty() and not m_comp( keys.back(), m_keys[ row ] ) ){	continue;	}
+
+			 		keys.push_back( std::move_if_noexcept( m_keys[ row ] ) );
+			 		values.push_back( std::move_if_noexcept( m_values[ row ] ) );
+			 	}
+
+			 	m_keys.swap( keys );
+			 	m_values.swap( values );
+			 	m_sorted = m_keys.size();
+			 }
+
+			 /**
+			  * @brief Removes the entry of key, if there is one.
+			  *
+			  * @param key
+			  * @return Number of entries removed, 0 or 1.
+			  */
+			 size_type erase( const key_type & key )
+			 {
+			 	const size_type index = index_of( key );
+			 	if( index == m_keys.size() ){	return 0;	}
+
+			 	erase( cbegin() + index );
+			 	return 1;
+			 }
+
+			 Iterator erase( const_iterator position )
+			 {
+			 	const size_type index = position.index();
+			 	m_keys.erase( m_keys.begin() + index );
+			 	m_values.erase( m_values.begin() + index );
+			 	--m_sorted;
+			 	return Iterator( this, index );
+			 }
+
+//############################# [V] Lookup
+
+			 Iterator find( const key_type & key ){	return Iterator( this, index_of( key ) );	}
+			 const_iterator find( const key_type & key ) const{	return const_iterator( this, index_of( key ) );	}
+			 bool contains( const key_type & key ) const{	return index_of( key ) != m_keys.size();	}
+			 size_type count( const key_type & key ) const{	return contains( key ) ? 1 : 0;	}
+			 Iterator lower_bound( const key_type & key ){	return Iterator( this, lower_index( key ) );	}
+			 const_iterator lower_bound( const key_type & key ) const{	return const_iterator( this, lower_index( key ) );	}
+			 Iterator upper_bound( const key_type & key ){	return Iterator( this, upper_index( key ) );	}
+			 const_iterator upper_bound( const key_type & key ) const{	return const_iterator( this, upper_index( key ) );	}
+
+			 /**
+			  * @brief The value of key, std::out_of_range if it isn't in the map.
+			  *
+			  * @param key
+			  * @return T&
+			  */
+			 T & at( const key_type & key )
+			 {
+			 	const size_type index = index_of( key );
+			 	if( index == m_keys.size() ){	throw std::out_of_range("This key is not in the map.\n");	}
+			 	return m_values[ index ];
+			 }
+
+			 const T & at( const key_type & key ) const
+			 {
+			 	const size_type index = index_of( key );
+			 	if( index == m_keys.size() ){	throw std::out_of_range("This key is not in the map.\n");	}
+			 	return m_values[ index ];
+			 }
+
+			 /**
+			  * @brief The value of key, inserting a value initialized one first if key isn't in the map.
+			  *
+			  * @param key
+			  * @return T&
+			  */
+			 T & operator[]( const key_type & key ){	return m_values[ try_insert( key ).first.index() ];	}
+			 T & operator[]( key_type && key ){	return m_values[ try_insert( std::move( key ) ).first.index() ];	}
+
+//############################# [VI] Operators
+
+			 friend bool operator== ( const flat_map & lhs, const flat_map & rhs ){	return lhs.m_keys == rhs.m_keys and lhs.m_values == rhs.m_values;	}
+			 friend bool operator!= ( const flat_map & lhs, const flat_map & rhs ){	return not ( lhs == rhs );	}
+	};
+};
+
+#endif
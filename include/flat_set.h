@@ -0,0 +1,304 @@
+/**
+ * @file    flat_set.h
+ * @brief   Sorted associative container on a sc::vector: sc::flat_set< K > keeps its keys sorted in one
+ *          contiguous array and looks them up with a branchless binary search, so a lookup touches
+ *          log2(n) cache lines of a single block instead of chasing log2(n) tree nodes around the heap.
+ *          Batches are inserted with one sort and one merge instead of one shift of the tail per key.
+ * @author  Bruna Hellen de Castro Dantas Barbosa
+ */
+
+#ifndef FLAT_SET_H
+#define FLAT_SET_H
+
+#include "vector.h"
+
+#include <functional> // std::less
+
+
+namespace sc
+{
+
+	/// Tag of the constructors that take keys already sorted and unique, which are then trusted.
+	struct sorted_unique_t{	};
+	constexpr sorted_unique_t sorted_unique{};
+
+	namespace detail
+	{
+		/**
+		 * @brief std::lower_bound over [first, first + n) without a data dependent branch: each step halves
+		 * the range with a conditional move, so the loop runs exactly log2(n) times and never mispredicts.
+		 *
+		 * @return Pointer to the first element not less than key, first + n if there is none.
+		 */
+		template < typename T, typename Compare >
+		const T * branchless_lower_bound( const T * first, std::size_t n, const T & key, const Compare & comp )
+		{
+			if( n == 0 ){	return first;	}
+			while( n > 1 )
+			{
+				const std::size_t half = n / 2;
+				first = comp( first[ half ], key ) ? first + half : first;
+				n -= half;
+			}
+			return first + comp( *first, key );
+		}
+
+		/// std::upper_bound counterpart of branchless_lower_bound.
+		template < typename T, typename Compare >
+		const T * branchless_upper_bound( const T * first, std::size_t n, const T & key, const Compare & comp )
+		{
+			if( n == 0 ){	return first;	}
+			while( n > 1 )
+			{
+				const std::size_t half = n / 2;
+				first = comp( key, first[ half ] ) ? first : first + half;
+				n -= half;
+			}
+			return first + not comp( key, *first );
+		}
+	}
+
+	/**
+	 * @brief Set of unique keys stored sorted in a sc::vector.
+	 *
+	 * @tparam Key Key type.
+	 * @tparam Compare Strict weak order of the keys.
+	 * @tparam Allocator Allocator of the key array.
+	 *
+	 * Lookups are O(log n) and single inserts and erases O(n), like a sorted array; insert_range adds m keys
+	 * in O(m log m + n). To build a set from scratch, append_unsorted the keys and call sort_unique once:
+	 * until then only size, append_unsorted, sort_unique and clear may be called.
+	 * Inserting or erasing invalidates every iterator.
+	 */
+	template < typename Key, typename Compare = std::less< Key >, typename Allocator = std::allocator< Key > >
+	class flat_set
+	{
+
+		public:
+
+			typedef sc::vector< Key, Allocator > container_type;
+			typedef Key key_type;
+			typedef Key value_type;
+			typedef Compare key_compare;
+			typedef Allocator allocator_type;
+			typedef size_t size_type;
+			typedef typename container_type::const_iterator const_iterator;
+			typedef const_iterator Iterator; //<! Keys can't be modified in place, they would lose their order.
+			typedef const Key& reference;
+			typedef const Key& const_reference;
+
+		private:
+
+			container_type m_keys; //<! The sorted unique keys, then the ones added by append_unsorted.
+			size_type m_sorted; //<! Number of keys at the front of m_keys that are sorted and unique.
+			key_compare m_comp; //<! Order of the keys.
+
+			bool is_sorted( void ) const{	return m_sorted == m_keys.size();	}
+
+			size_type lower_index( const key_type & key ) const
+			{
+				assert( is_sorted() );
+				return detail::branchless_lower_bound( m_keys.data(), m_keys.size(), key, m_comp ) - m_keys.data();
+			}
+
+			size_type upper_index( const key_type & key ) const
+			{
+				assert( is_sorted() );
+				return detail::branchless_upper_bound( m_keys.data(), m_keys.size(), key, m_comp ) - m_keys.data();
+			}
+
+			/// Index of key, size() if it isn't in the set.
+			size_type index_of( const key_type & key ) const
+			{
+				const size_type index = lower_index( key );
+				return index != m_keys.size() and not m_comp( key, m_keys[ index ] ) ? index : m_keys.size();
+			}
+
+			template < typename K >
+			std::pair< const_iterator, bool > insert_key( K && key )
+			{
+				const size_type index = lower_index( key );
+				if( index != m_keys.size() and not m_comp( key, m_keys[ index ] ) ){	return std::make_pair( cbegin() + index, false );	}
+
+				m_keys.insert( m_keys.begin() + index, std::forward< K >( key ) );
+				++m_sorted;
+				return std::make_pair( cbegin() + index, true );
+			}
+
+		public:
+
+//############################# [I] SPECIAL MEMBERS
+
+			 /**
+			  * @brief Constructs an empty set.
+			  *
+			  * @param comp
+			  * @param alloc
+			  */
+			 explicit flat_set( const key_compare & comp = key_compare(), const allocator_type & alloc = allocator_type() ):
+			 	m_keys(alloc), m_sorted(0), m_comp(comp){	/* Empty */	}
+
+			 /**
+			  * @brief Takes the keys of keys, in any order and with duplicates: they are sorted and the first of
+			  * each run of equal keys is kept.
+			  *
+			  * @param keys
+			  * @param comp
+			  */
+			 explicit flat_set( container_type keys, const key_compare & comp = key_compare() ):
+			 	m_keys(std::move(keys)), m_sorted(0), m_comp(comp)
+			 {
+			 	sort_unique();
+			 }
+
+			 /**
+			  * @brief Takes keys, which must already be sorted and unique; nothing is sorted.
+			  *
+			  * @param keys
+			  * @param comp
+			  */
+			 flat_set( sorted_unique_t, container_type keys, const key_compare & comp = key_compare() ):
+			 	m_keys(std::move(keys)), m_sorted(m_keys.size()), m_comp(comp)
+			 {
+			 	assert( std::adjacent_find( m_keys.cbegin(), m_keys.cend(), [this]( const Key & a, const Key & b ){	return not m_comp( a, b );	} ) == m_keys.cend() );
+			 }
+
+			 template < typename InputItr, typename = detail::require_iterator< InputItr > >
+			 flat_set( InputItr first, InputItr last, const key_compare & comp = key_compare(), const allocator_type & alloc = allocator_type() ):
+			 	flat_set( container_type( first, last, alloc ), comp ){	/* Empty */	}
+
+			 flat_set( std::initializer_list< Key > ilist, const key_compare & comp = key_compare(), const allocator_type & alloc = allocator_type() ):
+			 	flat_set( container_type( ilist, alloc ), comp ){	/* Empty */	}
+
+			 void swap( flat_set & other ) noexcept
+			 {
+			 	using std::swap;
+			 	m_keys.swap( other.m_keys );
+			 	swap( m_sorted, other.m_sorted );
+			 	swap( m_comp, other.m_comp );
+			 }
+
+			 key_compare key_comp( void ) const{	return m_comp;	}
+
+			 /// The sorted keys, as one contiguous array.
+			 const container_type & keys( void ) const{	return m_keys;	}
+
+//############################# [II] IteratorS
+
+			 const_iterator begin( void ) const{	return m_keys.cbegin();	}
+			 const_iterator end( void ) const{	return m_keys.cend();	}
+			 const_iterator cbegin( void ) const{	return m_keys.cbegin();	}
+			 const_iterator cend( void ) const{	return m_keys.cend();	}
+
+//############################# [III] Capacity
+
+			 size_type size( void ) const{	return m_keys.size();	}
+			 bool empty( void ) const{	return m_keys.empty();	}
+			 size_type capacity( void ) const{	return m_keys.capacity();	}
+			 void reserve( size_type n_size ){	m_keys.reserve( n_size );	}
+			 void shrink_to_fit( void ){	m_keys.shrink_to_fit();	}
+
+//############################# [IV] Modifiers
+
+			 void clear( void )
+			 {
+			 	m_keys.clear();
+			 	m_sorted = 0;
+			 }
+
+			 /**
+			  * @brief Inserts key unless an equal one is already there, shifting the greater keys up.
+			  *
+			  * @param key
+			  * @return The position of the key and whether it was inserted.
+			  */
+			 std::pair< const_iterator, bool > insert( const key_type & key ){	return insert_key( key );	}
+			 std::pair< const_iterator, bool > insert( key_type && key ){	return insert_key( std::move( key ) );	}
+
+			 /**
+			  * @brief Inserts the keys of [first, last) that aren't in the set yet: they are appended, sorted
+			  * among themselves and merged with the set in one pass, instead of shifting the tail once per key.
+			  *
+			  * @param first
+			  * @param last
+			  */
+			 template < typename InputItr, typename = detail::require_iterator< InputItr > >
+			 void insert_range( InputItr first, InputItr last )
+			 {
+			 	assert( is_sorted() );
+			 	m_keys.insert( m_keys.end(), first, last );
+			 	sort_unique();
+			 }
+
+			 void insert_range( std::initializer_list< Key > ilist ){	insert_range( ilist.begin(), ilist.end() );	}
+
+			 /**
+			  * @brief Appends key without looking for its place; the set can't be searched until sort_unique.
+			  *
+			  * @param key
+			  */
+			 void append_unsorted( const key_type & key ){	m_keys.push_back( key );	}
+			 void append_unsorted( key_type && key ){	m_keys.push_back( std::move( key ) );	}
+
+			 /**
+			  * @brief Sorts the keys added by append_unsorted (or insert_range), merges them with the sorted
+			  * ones and drops the duplicates, keeping the key that was in the set or else the first appended.
+			  * If it throws, every key is still there but the set has to be sorted again.
+			  *
+			  */
+			 void sort_unique( void )
+			 {
+			 	const size_type sorted = m_sorted;
+			 	if( sorted == m_keys.size() ){	return;	}
+			 	m_sorted = 0;
+
+			 	const key_compare & comp = m_comp;
+			 	const typename container_type::Iterator middle = m_keys.begin() + sorted;
+			 	std::stable_sort( middle, m_keys.end(), comp );
+			 	std::inplace_merge( m_keys.begin(), middle, m_keys.end(), comp );
+
+			 	// Sorted, two keys are equal when the first isn't less than the second.
+			 	m_keys.erase( std::unique( m_keys.begin(), m_keys.end(), [&comp]( const Key & a, const Key & b ){	return not comp( a, b );	} ), m_keys.end() );
+			 	m_sorted = m_keys.size();
+			 }
+
+			 /**
+			  * @brief Removes key, if it is in the set.
+			  *
+			  * @param key
+			  * @return Number of keys removed, 0 or 1.
+			  */
+			 size_type erase( const key_type & key )
+			 {
+			 	const size_type index = index_of( key );
+			 	if( index == m_keys.size() ){	return 0;	}
+
+			 	m_keys.erase( m_keys.begin() + index );
+			 	--m_sorted;
+			 	return 1;
+			 }
+
+			 const_iterator erase( const_iterator position )
+			 {
+			 	const size_type index = position - cbegin();
+			 	m_keys.erase( m_keys.begin() + index );
+			 	--m_sorted;
+			 	return cbegin() + index;
+			 }
+
+//############################# [V] Lookup
+
+			 const_iterator find( const key_type & key ) const{	return cbegin() + index_of( key );	}
+			 bool contains( const key_type & key ) const{	return index_of( key ) != m_keys.size();	}
+			 size_type count( const key_type & key ) const{	return contains( key ) ? 1 : 0;	}
+			 const_iterator lower_bound( const key_type & key ) const{	return cbegin() + lower_index( key );	}
+			 const_iterator upper_bound( const key_type & key ) const{	return cbegin() + upper_index( key );	}
+
+//############################# [VI] Operators
+
+			 friend bool operator== ( const flat_set & lhs, const flat_set & rhs ){	return lhs.m_keys == rhs.m_keys;	}
+			 friend bool operator!= ( const flat_set & lhs, const flat_set & rhs ){	return not ( lhs == rhs );	}
+	};
+};
+
+#endif
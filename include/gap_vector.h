@@ -0,0 +1,594 @@
+/**
+ * @file    gap_vector.h
+ * @brief   Sequencial container that keeps a gap of unused slots at the last edit point (a gap
+ *          buffer), so inserts and erases clustered around a moving cursor are amortized O(1).
+ *          Elements are reached by index across the gap; compact() makes them contiguous.
+ * @author  Bruna Hellen de Castro Dantas Barbosa
+ */
+
+#ifndef GAP_VECTOR_H
+#define GAP_VECTOR_H
+
+#include "vector.h"
+
+
+namespace sc
+{
+
+	/*
+	 * Random access iterator over a gap_vector: it keeps the logical index of the element and skips
+	 * the gap on each access.
+	 */
+	template < typename T >
+		class gap_iterator
+		{
+			public:
+
+				typedef std::ptrdiff_t difference_type;
+				typedef T& reference;
+				typedef typename std::remove_const< T >::type value_type;
+				typedef T* pointer;
+				typedef std::random_access_iterator_tag iterator_category;
+
+			private:
+				T * m_storage; //<! Storage of the gap buffer.
+				std::size_t m_gap_begin; //<! Logical index where the gap starts.
+				std::size_t m_gap_size; //<! Number of slots in the gap.
+				std::size_t m_index; //<! Logical index of the element pointed.
+
+				template < typename U > friend class gap_iterator;
+
+			public:
+
+				gap_iterator( T * storage = nullptr, std::size_t gap_begin = 0, std::size_t gap_size = 0, std::size_t index = 0 ):
+					m_storage(storage), m_gap_begin(gap_begin), m_gap_size(gap_size), m_index(index){ /* empty */ }
+
+				/**
+				 * @brief Converts an iterator into a const_iterator.
+				 *
+				 * @param other
+				 */
+				template < typename U, typename = typename std::enable_if< std::is_convertible< U *, T * >::value >::type >
+				gap_iterator( const gap_iterator< U > & other ):
+					m_storage(other.m_storage), m_gap_begin(other.m_gap_begin), m_gap_size(other.m_gap_size), m_index(other.m_index){ /* empty */ }
+
+				/*	Operators	*/
+
+				reference operator* ( ) const{	return m_storage[ m_index < m_gap_begin ? m_index : m_index + m_gap_size ];	}
+
+				pointer operator ->( void ) const{	return &**this;	}
+
+				reference operator[] ( difference_type n ) const{	return *( *this + n );	}
+
+				gap_iterator & operator++( ){	++m_index;	return *this;	}
+				gap_iterator operator++( int ){	gap_iterator temp = *this;	++m_index;	return temp;	}
+				gap_iterator & operator--( ){	--m_index;	return *this;	}
+				gap_iterator operator--( int ){	gap_iterator temp = *this;	--m_index;	return temp;	}
+
+				gap_iterator & operator+=( difference_type n ){	m_index += n;	return *this;	}
+				gap_iterator & operator-=( difference_type n ){	m_index -= n;	return *this;	}
+
+				friend gap_iterator operator +( gap_iterator it, difference_type n ){	return it += n;	}
+				friend gap_iterator operator +( difference_type n, gap_iterator it ){	return it += n;	}
+				friend gap_iterator operator -( gap_iterator it, difference_type n ){	return it -= n;	}
+
+				difference_type operator-( const gap_iterator & rhs ) const{	return difference_type( m_index ) - difference_type( rhs.m_index );	}
+
+				bool operator== ( const gap_iterator & rhs ) const{	return m_index == rhs.m_index;	}
+				bool operator!= ( const gap_iterator & rhs ) const{	return m_index != rhs.m_index;	}
+				bool operator< ( const gap_iterator & rhs ) const{	return m_index < rhs.m_index;	}
+				bool operator> ( const gap_iterator & rhs ) const{	return m_index > rhs.m_index;	}
+				bool operator<= ( const gap_iterator & rhs ) const{	return m_index <= rhs.m_index;	}
+				bool operator>= ( const gap_iterator & rhs ) const{	return m_index >= rhs.m_index;	}
+		};
+
+	template < typename T, typename Allocator = std::allocator< T >, typename Growth = doubling_growth >
+	class gap_vector
+	{
+
+		public:
+
+			typedef Allocator allocator_type;
+			typedef std::allocator_traits< allocator_type > alloc_traits;
+			typedef Growth growth_policy;
+			typedef size_t size_type;
+			typedef T value_type;
+			typedef gap_iterator< T > Iterator;
+			typedef gap_iterator< const T > const_iterator;
+			typedef T& reference;
+			typedef const T& const_reference;
+			typedef T* pointer;
+
+			static_assert( std::is_same< typename alloc_traits::pointer, pointer >::value,
+					"sc::gap_vector needs an allocator that hands out raw pointers" );
+
+		private:
+			allocator_type m_alloc; //<! Allocator of the storage, also used to construct the elements.
+			size_type m_gap_begin; //<! First slot of the gap, also the logical index of the cursor.
+			size_type m_gap_end; //<! Slot past the last one of the gap.
+			size_type m_capacity; //<! List's storage capacity.
+			pointer m_storage; //<! Storage of m_capacity slots.
+
+			// The elements live in [0, m_gap_begin) and [m_gap_end, m_capacity); the gap is raw storage.
+
+			pointer allocate( size_type n ){	return alloc_traits::allocate( m_alloc, n );	}
+
+			void deallocate( pointer ptr, size_type n )
+			{
+				if( ptr != nullptr ){	alloc_traits::deallocate( m_alloc, ptr, n );	}
+			}
+
+			template < typename... Args >
+			void construct_at( pointer ptr, Args&&... args )
+			{
+				alloc_traits::construct( m_alloc, ptr, std::forward< Args >( args )... );
+			}
+
+			size_type gap_size( void ) const{	return m_gap_end - m_gap_begin;	}
+
+			/**
+			 * @brief Returns the slot of the element at logical index i.
+			 *
+			 * @param i
+			 * @return pointer
+			 */
+			pointer slot( size_type i ) const{	return m_storage + ( i < m_gap_begin ? i : i + gap_size() );	}
+
+			void destroy_all( void )
+			{
+				detail::destroy( m_alloc, m_storage, m_storage + m_gap_begin );
+				detail::destroy( m_alloc, m_storage + m_gap_end, m_storage + m_capacity );
+			}
+
+			/**
+			 * @brief Moves the elements around the gap to the storage pointed by dest, with room for n elements,
+			 * which becomes the storage of the vector. The gap keeps its position and takes the extra room.
+			 *
+			 * @param dest
+			 * @param n
+			 */
+			void move_storage( pointer dest, size_type n )
+			{
+				const size_type tail = m_capacity - m_gap_end;
+				try
+				{
+					detail::relocate( m_alloc, m_storage, m_storage + m_gap_begin, dest );
+					try{	detail::relocate( m_alloc, m_storage + m_gap_end, m_storage + m_capacity, dest + n - tail );	}
+					catch( ... ){	detail::destroy( m_alloc, dest, dest + m_gap_begin ); throw;	}
+				}
+				catch( ... ){	deallocate( dest, n ); throw;	}
+
+				destroy_all();
+				deallocate( m_storage, m_capacity );
+				m_storage = dest;
+				m_gap_end = n - tail;
+				m_capacity = n;
+			}
+
+			/**
+			 * @brief Makes room for at least `required` elements, with the capacity chosen by the growth policy.
+			 *
+			 * @param required
+			 */
+			void grow( size_type required )
+			{
+				if( required > m_capacity ){	reserve( growth_policy::grow( m_capacity, required, sizeof( value_type ) ) );	}
+			}
+
+			/**
+			 * @brief Moves the gap so it starts at logical index `index`, shifting the elements between the
+			 * old and the new position across it. O(distance), trivially copyable elements are memmoved.
+			 *
+			 * @param index
+			 */
+			void move_gap( size_type index ){	move_gap( index, detail::memcpyable< T >() );	}
+
+			void move_gap( size_type index, std::true_type )
+			{
+				if( index < m_gap_begin )
+				{
+					const size_type count = m_gap_begin - index;
+					std::memmove( static_cast< void * >( m_storage + m_gap_end - count ), m_storage + index, count * sizeof( value_type ) );
+				}
+				else if( index > m_gap_begin )
+				{
+					const size_type count = index - m_gap_begin;
+					std::memmove( static_cast< void * >( m_storage + m_gap_begin ), m_storage + m_gap_end, count * sizeof( value_type ) );
+				}
+				m_gap_end = index + gap_size();
+				m_gap_begin = index;
+			}
+
+			void move_gap( size_type index, std::false_type )
+			{
+				// Each element goes to a slot of the old gap (constructed) or of an element already moved (assigned);
+				// the moved-from elements left in the new gap are destroyed at the end.
+				const size_type gap = gap_size();
+
+				if( index < m_gap_begin )
+				{
+					for( size_type i = m_gap_begin; i != index; --i )
+					{
+						if( i - 1 + gap >= m_gap_begin ){	construct_at( m_storage + i - 1 + gap, std::move( m_storage[i-1] ) );	}
+						else{	m_storage[i-1+gap] = std::move( m_storage[i-1] );	}
+					}
+					detail::destroy( m_alloc, m_storage + index, m_storage + std::min( index + gap, m_gap_begin ) );
+				}
+				else if( index > m_gap_begin )
+				{
+					for( size_type i = m_gap_begin; i != index; ++i )
+					{
+						if( i < m_gap_end ){	construct_at( m_storage + i, std::move( m_storage[i+gap] ) );	}
+						else{	m_storage[i] = std::move( m_storage[i+gap] );	}
+					}
+					detail::destroy( m_alloc, m_storage + std::max( m_gap_end, index ), m_storage + index + gap );
+				}
+				m_gap_end = index + gap;
+				m_gap_begin = index;
+			}
+
+			/**
+			 * @brief Releases the storage, leaving the vector empty with no capacity.
+			 *
+			 */
+			void reset( void )
+			{
+				destroy_all();
+				deallocate( m_storage, m_capacity );
+				m_gap_begin = m_gap_end = m_capacity = 0;
+				m_storage = nullptr;
+			}
+
+			/**
+			 * @brief Takes over the storage of model, which is left empty.
+			 *
+			 * @param model
+			 */
+			void steal( gap_vector & model )
+			{
+				m_gap_begin = model.m_gap_begin;
+				m_gap_end = model.m_gap_end;
+				m_capacity = model.m_capacity;
+				m_storage = model.m_storage;
+
+				model.m_gap_begin = model.m_gap_end = model.m_capacity = 0;
+				model.m_storage = nullptr;
+			}
+
+			template < typename InputItr >
+			void append( InputItr first, InputItr last ){	for( ; first != last; ++first ){	emplace_back( *first );	}	}
+
+		public:
+
+//############################# [I] SPECIAL MEMBERS
+
+			 gap_vector( ): m_alloc(), m_gap_begin(0), m_gap_end(0), m_capacity(0), m_storage(nullptr){	/* Empty */	}
+
+			 explicit gap_vector( const allocator_type & alloc ): m_alloc(alloc), m_gap_begin(0), m_gap_end(0), m_capacity(0), m_storage(nullptr){	/* Empty */	}
+
+			 /**
+			  * @brief Constructs a container with capacity for at least n elements.
+			  *
+			  * @param n
+			  * @param alloc
+			  */
+			 gap_vector( size_type n, const allocator_type & alloc = allocator_type() ): gap_vector(alloc){	reserve( n );	}
+
+			 template < typename InputItr, typename = detail::require_iterator< InputItr > >
+			 gap_vector( InputItr first, InputItr last, const allocator_type & alloc = allocator_type() ): gap_vector(alloc)
+			 {
+			 	append( first, last );
+			 }
+
+			 gap_vector( std::initializer_list< T > ilist, const allocator_type & alloc = allocator_type() ): gap_vector(alloc)
+			 {
+			 	reserve( ilist.size() );
+			 	append( ilist.begin(), ilist.end() );
+			 }
+
+			 /**
+			  * @brief Constructs a container with a copy of each of the elements in model, in the same order,
+			  * with the gap at the end.
+			  *
+			  * @param model
+			  */
+			 gap_vector( const gap_vector & model ): gap_vector(alloc_traits::select_on_container_copy_construction(model.m_alloc))
+			 {
+			 	reserve( model.size() );
+			 	append( model.cbegin(), model.cend() );
+			 }
+
+			 gap_vector( gap_vector && model ) noexcept: gap_vector(std::move(model.m_alloc)){	steal( model );	}
+
+			 ~gap_vector( ){	reset();	}
+
+			 gap_vector & operator= ( const gap_vector & model )
+			 {
+			 	if( this == &model ){	return *this;	}
+
+			 	if( alloc_traits::propagate_on_container_copy_assignment::value and m_alloc != model.m_alloc )
+			 	{
+			 		// The storage must be released by the allocator that made it.
+			 		reset();
+			 		detail::propagate_copy( m_alloc, model.m_alloc, typename alloc_traits::propagate_on_container_copy_assignment() );
+			 	}
+
+			 	clear();
+			 	reserve( model.size() );
+			 	append( model.cbegin(), model.cend() );
+
+			 	return *this;
+			 }
+
+			 gap_vector & operator= ( gap_vector && model )
+			 	noexcept( alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value )
+			 {
+			 	if( this == &model ){	return *this;	}
+
+			 	if( alloc_traits::propagate_on_container_move_assignment::value or m_alloc == model.m_alloc )
+			 	{
+			 		reset();
+			 		detail::propagate_move( m_alloc, model.m_alloc, typename alloc_traits::propagate_on_container_move_assignment() );
+			 		steal( model );
+			 	}
+			 	else
+			 	{
+			 		// Storage from another allocator can't be taken over, the elements are moved one by one.
+			 		clear();
+			 		reserve( model.size() );
+			 		append( std::make_move_iterator( model.begin() ), std::make_move_iterator( model.end() ) );
+			 		model.clear();
+			 	}
+
+			 	return *this;
+			 }
+
+			 allocator_type get_allocator( void ) const{	return m_alloc;	}
+
+//############################# [II] IteratorS
+
+			 Iterator begin( void ){	return Iterator( m_storage, m_gap_begin, gap_size(), 0 );	}
+			 Iterator end( void ){	return Iterator( m_storage, m_gap_begin, gap_size(), size() );	}
+			 const_iterator begin( void ) const{	return cbegin();	}
+			 const_iterator end( void ) const{	return cend();	}
+			 const_iterator cbegin( void ) const{	return const_iterator( m_storage, m_gap_begin, gap_size(), 0 );	}
+			 const_iterator cend( void ) const{	return const_iterator( m_storage, m_gap_begin, gap_size(), size() );	}
+
+//############################# [III] Capacity
+
+			 size_type size( void ) const{	return m_capacity - gap_size();	}
+			 size_type capacity( void ) const{	return m_capacity;	}
+			 bool empty( void ) const{	return size() == 0;	}
+
+			 /**
+			  * @brief Returns the logical index where the gap is, that is, where the last edit happened.
+			  *
+			  * @return size_type
+			  */
+			 size_type gap_position( void ) const{	return m_gap_begin;	}
+
+			 void reserve( size_type n_size )
+			 {
+			 	if( n_size <= m_capacity ){	return;	}
+			 	move_storage( allocate( n_size ), n_size );
+			 }
+
+			 void shrink_to_fit( void )
+			 {
+			 	if( gap_size() == 0 ){	return;	}
+			 	if( empty() ){	reset(); return;	}
+			 	move_storage( allocate( size() ), size() );
+			 }
+
+//############################# [IV] Modifiers
+
+			 /**
+			  * @brief Destroys every element, keeping the storage.
+			  *
+			  */
+			 void clear( void )
+			 {
+			 	destroy_all();
+			 	m_gap_begin = 0;
+			 	m_gap_end = m_capacity;
+			 }
+
+			 /**
+			  * @brief Inserts a new element before position, constructed from args. O(1) when position is the
+			  * gap position, otherwise the gap is moved there first, in O(distance).
+			  *
+			  * @param position
+			  * @param args
+			  * @return Iterator to the new element
+			  */
+			 template < typename... Args >
+			 Iterator emplace( const_iterator position, Args&&... args )
+			 {
+			 	const size_type index = position - cbegin();
+
+			 	if( index == m_gap_begin and gap_size() != 0 )
+			 	{
+			 		// Nothing moves, args can't be left dangling.
+			 		construct_at( m_storage + m_gap_begin, std::forward< Args >( args )... );
+			 	}
+			 	else
+			 	{
+			 		value_type temporary( std::forward< Args >( args )... );
+			 		grow( size() + 1 );
+			 		move_gap( index );
+			 		construct_at( m_storage + m_gap_begin, std::move( temporary ) );
+			 	}
+			 	m_gap_begin++;
+
+			 	return begin() + index;
+			 }
+
+			 Iterator insert( const_iterator position, const_reference ref ){	return emplace( position, ref );	}
+			 Iterator insert( const_iterator position, value_type && ref ){	return emplace( position, std::move( ref ) );	}
+
+			 /**
+			  * @brief Inserts copies of the elements in [first, last) before position, one after the other at the gap.
+			  *
+			  * @param position
+			  * @param first
+			  * @param last
+			  * @return Iterator to the first element inserted
+			  */
+			 template < typename InputItr, typename = detail::require_iterator< InputItr > >
+			 Iterator insert( const_iterator position, InputItr first, InputItr last )
+			 {
+			 	const size_type index = position - cbegin();
+			 	for( size_type i = index; first != last; ++first, ++i ){	emplace( cbegin() + i, *first );	}
+
+			 	return begin() + index;
+			 }
+
+			 Iterator insert( const_iterator position, std::initializer_list< value_type > ilist ){	return insert( position, ilist.begin(), ilist.end() );	}
+
+			 template < typename... Args >
+			 reference emplace_back( Args&&... args ){	return *emplace( cend(), std::forward< Args >( args )... );	}
+
+			 void push_back( const_reference ref ){	emplace( cend(), ref );	}
+			 void push_back( value_type && ref ){	emplace( cend(), std::move( ref ) );	}
+			 void push_front( const_reference ref ){	emplace( cbegin(), ref );	}
+			 void push_front( value_type && ref ){	emplace( cbegin(), std::move( ref ) );	}
+
+			 /**
+			  * @brief Removes the elements in [first, last), by moving the gap next to them and widening it.
+			  *
+			  * @param first
+			  * @param last
+			  * @return Iterator following the last element removed
+			  */
+			 Iterator erase( const_iterator first, const_iterator last )
+			 {
+			 	const size_type index = first - cbegin();
+			 	const size_type count = last - first;
+
+			 	if( m_gap_begin > index )
+			 	{
+			 		// The gap is after them: they end up right before it.
+			 		move_gap( index + count );
+			 		detail::destroy( m_alloc, m_storage + index, m_storage + index + count );
+			 		m_gap_begin = index;
+			 	}
+			 	else
+			 	{
+			 		// The gap is before them: they end up right after it.
+			 		move_gap( index );
+			 		detail::destroy( m_alloc, m_storage + m_gap_end, m_storage + m_gap_end + count );
+			 		m_gap_end += count;
+			 	}
+
+			 	return begin() + index;
+			 }
+
+			 Iterator erase( const_iterator position ){	return erase( position, position + 1 );	}
+
+			 void pop_back( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("Can't pop out of an empty vector \n");}
+			 	erase( cend() - 1 );
+			 }
+
+			 void pop_front( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("Can't pop out of an empty vector \n");}
+			 	erase( cbegin() );
+			 }
+
+			 /**
+			  * @brief Moves the gap to the end, so the elements are contiguous from the start of the storage.
+			  * O(number of elements after the gap).
+			  *
+			  * @return pointer to the first element
+			  */
+			 pointer compact( void )
+			 {
+			 	move_gap( size() );
+			 	return m_storage;
+			 }
+
+			 /**
+			  * @brief Returns true if the gap is at the end, so compact() is free.
+			  *
+			  * @return bool
+			  */
+			 bool is_compact( void ) const{	return m_gap_end == m_capacity;	}
+
+			 void swap( gap_vector & other ) noexcept
+			 {
+			 	detail::propagate_swap( m_alloc, other.m_alloc, typename alloc_traits::propagate_on_container_swap() );
+			 	std::swap( m_gap_begin, other.m_gap_begin );
+			 	std::swap( m_gap_end, other.m_gap_end );
+			 	std::swap( m_capacity, other.m_capacity );
+			 	std::swap( m_storage, other.m_storage );
+			 }
+
+			 friend void swap( gap_vector & first_, gap_vector & second_ ) noexcept{	first_.swap( second_ );	}
+
+//#############################  [V] Element access
+
+			 const_reference back( void ) const
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :( \n");}
+			 	return *slot( size() - 1 );
+			 }
+
+			 reference back( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :( \n");}
+			 	return *slot( size() - 1 );
+			 }
+
+			 const_reference front( void ) const
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :(\n");}
+			 	return *slot( 0 );
+			 }
+
+			 reference front( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :(\n");}
+			 	return *slot( 0 );
+			 }
+
+			 const_reference operator[]( size_type posi ) const{	return *slot( posi );	}
+
+			 reference operator[]( size_type n )
+			 {
+			 	if( n >= size() ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return *slot( n );
+			 }
+
+			 const_reference at( size_type n ) const
+			 {
+			 	if( n >= size() ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return *slot( n );
+			 }
+
+			 reference at( size_type n )
+			 {
+			 	if( n >= size() ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return *slot( n );
+			 }
+
+			 /**
+			  * @brief Returns a pointer to the elements, compacting them first (see compact()).
+			  *
+			  * @return pointer
+			  */
+			 pointer data( void ){	return compact();	}
+
+//############################# [VI] Operators
+
+			 bool operator== ( const gap_vector & test_v ) const
+			 {
+			 	return size() == test_v.size() and std::equal( cbegin(), cend(), test_v.cbegin() );
+			 }
+
+			 bool operator!= ( const gap_vector & test_v ) const{	return not ( *this == test_v );	}
+	};
+};
+
+#endif
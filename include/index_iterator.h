@@ -0,0 +1,89 @@
+/**
+ * @file    index_iterator.h
+ * @brief   Helpers of the containers that aren't contiguous (concurrent_vector, segmented_vector): a
+ *          random access iterator over an index and the integer log2 their slot arithmetic uses.
+ * @author  Bruna Hellen de Castro Dantas Barbosa
+ */
+
+#ifndef INDEX_ITERATOR_H
+#define INDEX_ITERATOR_H
+
+#include <cstddef> // std::size_t, std::ptrdiff_t
+#include <iterator> // std::random_access_iterator_tag
+#include <limits> // std::numeric_limits
+#include <type_traits> // std::remove_const, std::enable_if
+
+
+namespace sc
+{
+
+	namespace detail
+	{
+		/// Index of the highest bit set in x, which must not be 0.
+		inline std::size_t floor_log2( std::size_t x )
+		{
+#if defined( __GNUC__ )
+			return std::numeric_limits< unsigned long long >::digits - 1 - __builtin_clzll( x );
+#else
+			std::size_t log = 0;
+			while( x >>= 1 ){	++log;	}
+			return log;
+#endif
+		}
+
+		/**
+		 * Random access iterator of the containers that aren't contiguous: it keeps the container and an
+		 * index, and asks the container for the element each time it is dereferenced.
+		 */
+		template < typename Container, typename T >
+		class index_iterator
+		{
+			public:
+
+				typedef std::ptrdiff_t difference_type;
+				typedef typename std::remove_const< T >::type value_type;
+				typedef T* pointer;
+				typedef T& reference;
+				typedef std::random_access_iterator_tag iterator_category;
+
+				index_iterator( Container * container = nullptr, difference_type index = 0 ): m_container(container), m_index(index){	/* Empty */	}
+
+				/// Iterator to const_iterator.
+				template < typename C, typename U, typename = typename std::enable_if< std::is_convertible< U*, T* >::value >::type >
+				index_iterator( const index_iterator< C, U > & other ): m_container(other.m_container), m_index(other.m_index){	/* Empty */	}
+
+				difference_type index( void ) const{	return m_index;	}
+
+				reference operator* ( void ) const{	return *m_container->slot( m_index );	}
+				pointer operator-> ( void ) const{	return m_container->slot( m_index );	}
+				reference operator[] ( difference_type n ) const{	return *m_container->slot( m_index + n );	}
+
+				index_iterator & operator++ ( void ){	++m_index; return *this;	}
+				index_iterator operator++ ( int ){	index_iterator old( *this ); ++m_index; return old;	}
+				index_iterator & operator-- ( void ){	--m_index; return *this;	}
+				index_iterator operator-- ( int ){	index_iterator old( *this ); --m_index; return old;	}
+				index_iterator & operator+= ( difference_type n ){	m_index += n; return *this;	}
+				index_iterator & operator-= ( difference_type n ){	m_index -= n; return *this;	}
+
+				friend index_iterator operator+ ( index_iterator it, difference_type n ){	return it += n;	}
+				friend index_iterator operator+ ( difference_type n, index_iterator it ){	return it += n;	}
+				friend index_iterator operator- ( index_iterator it, difference_type n ){	return it -= n;	}
+				friend difference_type operator- ( const index_iterator & a, const index_iterator & b ){	return a.m_index - b.m_index;	}
+
+				friend bool operator== ( const index_iterator & a, const index_iterator & b ){	return a.m_index == b.m_index;	}
+				friend bool operator!= ( const index_iterator & a, const index_iterator & b ){	return a.m_index != b.m_index;	}
+				friend bool operator< ( const index_iterator & a, const index_iterator & b ){	return a.m_index < b.m_index;	}
+				friend bool operator> ( const index_iterator & a, const index_iterator & b ){	return a.m_index > b.m_index;	}
+				friend bool operator<= ( const index_iterator & a, const index_iterator & b ){	return a.m_index <= b.m_index;	}
+				friend bool operator>= ( const index_iterator & a, const index_iterator & b ){	return a.m_index >= b.m_index;	}
+
+			private:
+				template < typename C, typename U > friend class index_iterator;
+
+				Container * m_container;
+				difference_type m_index;
+		};
+	}
+};
+
+#endif
@@ -0,0 +1,452 @@
+/**
+ * @file    mmap_vector.h
+ * @brief   Sequencial container of trivially copyable elements whose storage is a memory mapped
+ *          file, with the element access and iterator interface of sc::vector. Reopening the file
+ *          maps it again instead of loading it, so startup is O(1) whatever the size of the data.
+ *          POSIX only; growth uses mremap where available (Linux).
+ * @author  Bruna Hellen de Castro Dantas Barbosa
+ */
+
+#ifndef MMAP_VECTOR_H
+#define MMAP_VECTOR_H
+
+#include "vector.h"
+
+#include <cerrno> // errno
+#include <cstdint> // std::uint64_t
+#include <string> // std::string
+#include <system_error> // std::system_error
+
+#include <fcntl.h> // open
+#include <sys/mman.h> // mmap, mremap, msync, munmap
+#include <sys/stat.h> // fstat
+#include <unistd.h> // ftruncate, close
+
+
+namespace sc
+{
+
+	namespace detail
+	{
+		/*
+		 * The file starts with this header, padded to `mmap_header_bytes`; the elements follow it.
+		 * size is updated in place on every change, so the file is always consistent with the vector.
+		 */
+		struct mmap_header
+		{
+			char magic[8]; //<! "scmmapv" plus a terminator.
+			std::uint64_t size; //<! Number of elements stored.
+			std::uint64_t element_size; //<! sizeof of the element type, checked on open.
+		};
+
+		static const std::size_t mmap_header_bytes = 64;
+
+		inline void throw_errno( const char * what ){	throw std::system_error( errno, std::generic_category(), what );	}
+	}
+
+	template < typename T, typename Growth = doubling_growth >
+	class mmap_vector
+	{
+
+		public:
+
+			typedef Growth growth_policy;
+			typedef size_t size_type;
+			typedef T value_type;
+			typedef MyIterator< T > Iterator;
+			typedef MyIterator< const T > const_iterator;
+			typedef T& reference;
+			typedef const T& const_reference;
+			typedef T* pointer;
+
+			/// How the file is opened.
+			enum open_mode
+			{
+				read_write, //<! Created if missing; every change goes to the file.
+				read_only //<! Must exist and is never modified: the size can't change and element writes stay private to the process.
+			};
+
+			static_assert( std::is_trivially_copyable< T >::value, "sc::mmap_vector stores the bytes of its elements in a file, they must be trivially copyable" );
+			static_assert( alignof( T ) <= detail::mmap_header_bytes, "sc::mmap_vector can't align elements past the file header" );
+
+		private:
+			int m_fd; //<! Descriptor of the file, -1 once moved from.
+			open_mode m_mode; //<! How the file was opened.
+			size_type m_capacity; //<! Number of elements the file has room for.
+			char * m_map; //<! Mapping of the whole file, header included.
+
+			detail::mmap_header * header( void ) const{	return reinterpret_cast< detail::mmap_header * >( m_map );	}
+			pointer storage( void ) const{	return reinterpret_cast< pointer >( m_map + detail::mmap_header_bytes );	}
+			size_type end_index( void ) const{	return static_cast< size_type >( header()->size );	}
+			void set_size( size_type n ){	header()->size = n;	}
+
+			static size_type bytes_for( size_type n ){	return detail::mmap_header_bytes + n * sizeof( value_type );	}
+
+			void check_writable( void ) const
+			{
+				if( m_mode == read_only ){	throw std::logic_error("The mmap_vector was opened read-only.\n");	}
+			}
+
+			/**
+			 * @brief Maps the first `bytes` of the file.
+			 *
+			 * @param bytes
+			 */
+			void map( size_type bytes )
+			{
+				const int protection = PROT_READ | PROT_WRITE;
+				const int flags = m_mode == read_only ? MAP_PRIVATE : MAP_SHARED;
+
+				void * address = ::mmap( nullptr, bytes, protection, flags, m_fd, 0 );
+				if( address == MAP_FAILED ){	detail::throw_errno( "mmap" );	}
+				m_map = static_cast< char * >( address );
+			}
+
+			/**
+			 * @brief Resizes the file to room for n elements and remaps it, moving the mapping if needed.
+			 *
+			 * @param n
+			 */
+			void remap( size_type n )
+			{
+				if( ::ftruncate( m_fd, bytes_for( n ) ) != 0 ){	detail::throw_errno( "ftruncate" );	}
+
+#ifdef MREMAP_MAYMOVE
+				void * address = ::mremap( m_map, bytes_for( m_capacity ), bytes_for( n ), MREMAP_MAYMOVE );
+				if( address == MAP_FAILED ){	detail::throw_errno( "mremap" );	}
+				m_map = static_cast< char * >( address );
+#else
+				::munmap( m_map, bytes_for( m_capacity ) );
+				map( bytes_for( n ) );
+#endif
+				m_capacity = n;
+			}
+
+			/**
+			 * @brief Makes room for at least `required` elements, with the capacity chosen by the growth policy.
+			 *
+			 * @param required
+			 */
+			void grow( size_type required )
+			{
+				if( required > m_capacity ){	reserve( growth_policy::grow( m_capacity, required, sizeof( value_type ) ) );	}
+			}
+
+			/// Shifts [index, size()) n slots up, into capacity the file already has.
+			void open_gap( size_type index, size_type n )
+			{
+				pointer at = storage() + index;
+				std::memmove( static_cast< void * >( at + n ), at, ( size() - index ) * sizeof( value_type ) );
+			}
+
+			void release( void )
+			{
+				if( m_map != nullptr ){	::munmap( m_map, bytes_for( m_capacity ) );	}
+				if( m_fd != -1 ){	::close( m_fd );	}
+				m_map = nullptr;
+				m_fd = -1;
+			}
+
+		public:
+
+//############################# [I] SPECIAL MEMBERS
+
+			 /**
+			  * @brief Opens the vector stored at path. In read_write mode a missing or empty file becomes an
+			  * empty vector; an existing one must have been written by an mmap_vector of the same element size.
+			  * Only the file header is read, the elements are paged in as they are used.
+			  *
+			  * @param path
+			  * @param mode
+			  */
+			 explicit mmap_vector( const std::string & path, open_mode mode = read_write ):
+			 	m_fd(-1), m_mode(mode), m_capacity(0), m_map(nullptr)
+			 {
+			 	m_fd = ::open( path.c_str(), mode == read_only ? O_RDONLY : O_RDWR | O_CREAT, 0644 );
+			 	if( m_fd == -1 ){	detail::throw_errno( "open" );	}
+
+			 	try
+			 	{
+			 		struct stat info;
+			 		if( ::fstat( m_fd, &info ) != 0 ){	detail::throw_errno( "fstat" );	}
+			 		const size_type bytes = static_cast< size_type >( info.st_size );
+
+			 		if( bytes == 0 and mode == read_write )
+			 		{
+			 			if( ::ftruncate( m_fd, bytes_for( 0 ) ) != 0 ){	detail::throw_errno( "ftruncate" );	}
+			 			map( bytes_for( 0 ) );
+			 			const detail::mmap_header fresh = { { 's', 'c', 'm', 'm', 'a', 'p', 'v', '\0' }, 0, sizeof( value_type ) };
+			 			*header() = fresh;
+			 			return;
+			 		}
+
+			 		if( bytes < bytes_for( 0 ) ){	throw std::runtime_error("The file is not an mmap_vector.\n");	}
+			 		map( bytes );
+			 		m_capacity = ( bytes - bytes_for( 0 ) ) / sizeof( value_type );
+
+			 		if( std::memcmp( header()->magic, "scmmapv", 8 ) != 0 ){	throw std::runtime_error("The file is not an mmap_vector.\n");	}
+			 		if( header()->element_size != sizeof( value_type ) ){	throw std::runtime_error("The file stores elements of another size.\n");	}
+			 		if( header()->size > m_capacity ){	throw std::runtime_error("The file is truncated.\n");	}
+			 	}
+			 	catch( ... ){	release(); throw;	}
+			 }
+
+			 mmap_vector( const mmap_vector & ) = delete;
+			 mmap_vector & operator= ( const mmap_vector & ) = delete;
+
+			 mmap_vector( mmap_vector && model ) noexcept:
+			 	m_fd(model.m_fd), m_mode(model.m_mode), m_capacity(model.m_capacity), m_map(model.m_map)
+			 {
+			 	model.m_fd = -1;
+			 	model.m_map = nullptr;
+			 	model.m_capacity = 0;
+			 }
+
+			 mmap_vector & operator= ( mmap_vector && model ) noexcept
+			 {
+			 	if( this == &model ){	return *this;	}
+
+			 	release();
+			 	m_fd = model.m_fd;
+			 	m_mode = model.m_mode;
+			 	m_capacity = model.m_capacity;
+			 	m_map = model.m_map;
+
+			 	model.m_fd = -1;
+			 	model.m_map = nullptr;
+			 	model.m_capacity = 0;
+
+			 	return *this;
+			 }
+
+			 /**
+			  * @brief Unmaps and closes the file. The data reaches the disk whenever the kernel writes the pages
+			  * back; call sync() first to wait for it.
+			  *
+			  */
+			 ~mmap_vector( ){	release();	}
+
+//############################# [II] IteratorS
+
+			 Iterator begin( void ){	return Iterator( storage() );	}
+			 Iterator end( void ){	return Iterator( storage() + size() );	}
+			 const_iterator begin( void ) const{	return cbegin();	}
+			 const_iterator end( void ) const{	return cend();	}
+			 const_iterator cbegin( void ) const{	return const_iterator( storage() );	}
+			 const_iterator cend( void ) const{	return const_iterator( storage() + size() );	}
+
+//############################# [III] Capacity
+
+			 size_type size( void ) const{	return m_map == nullptr ? 0 : end_index();	}
+			 size_type capacity( void ) const{	return m_capacity;	}
+			 bool empty( void ) const{	return size() == 0;	}
+			 bool is_read_only( void ) const{	return m_mode == read_only;	}
+
+			 /**
+			  * @brief Grows the file to room for n_size elements (ftruncate) and remaps it (mremap).
+			  *
+			  * @param n_size
+			  */
+			 void reserve( size_type n_size )
+			 {
+			 	if( n_size <= m_capacity ){	return;	}
+			 	check_writable();
+			 	remap( n_size );
+			 }
+
+			 /**
+			  * @brief Shrinks the file to the elements in use.
+			  *
+			  */
+			 void shrink_to_fit( void )
+			 {
+			 	if( size() == m_capacity ){	return;	}
+			 	check_writable();
+			 	remap( size() );
+			 }
+
+			 /**
+			  * @brief Writes the changed pages to the file and waits for it (msync).
+			  *
+			  */
+			 void sync( void )
+			 {
+			 	if( m_mode == read_only ){	return;	}
+			 	if( ::msync( m_map, bytes_for( m_capacity ), MS_SYNC ) != 0 ){	detail::throw_errno( "msync" );	}
+			 }
+
+//############################# [IV] Modifiers
+
+			 void clear( void )
+			 {
+			 	check_writable();
+			 	set_size( 0 );
+			 }
+
+			 template < typename... Args >
+			 reference emplace_back( Args&&... args )
+			 {
+			 	check_writable();
+			 	if( size() == m_capacity )
+			 	{
+			 		// Built before growing: args may point into the mapping, which mremap can move.
+			 		value_type value( std::forward< Args >( args )... );
+			 		grow( size() + 1 );
+			 		::new ( static_cast< void * >( storage() + size() ) ) value_type( std::move( value ) );
+			 	}
+			 	else{	::new ( static_cast< void * >( storage() + size() ) ) value_type( std::forward< Args >( args )... );	}
+
+			 	pointer dest = storage() + size();
+			 	set_size( size() + 1 );
+
+			 	return *dest;
+			 }
+
+			 void push_back( const_reference ref ){	emplace_back( ref );	}
+
+			 void pop_back( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("Can't pop out of an empty vector \n");}
+			 	check_writable();
+			 	set_size( size() - 1 );
+			 }
+
+			 /**
+			  * @brief Inserts copies of the elements in [first, last) before position.
+			  *
+			  * @param position
+			  * @param first
+			  * @param last
+			  * @return Iterator to the first element inserted
+			  */
+			 template < typename ForwardItr, typename = detail::require_iterator< ForwardItr > >
+			 Iterator insert( const_iterator position, ForwardItr first, ForwardItr last )
+			 {
+			 	check_writable();
+			 	const size_type index = position - cbegin();
+			 	const size_type n = std::distance( first, last );
+			 	if( n == 0 ){	return Iterator( storage() + index );	}
+
+			 	if( size() + n > m_capacity )
+			 	{
+			 		// Copied aside first: the range may point into the mapping, which growing can move.
+			 		sc::vector< value_type > values( first, last );
+			 		grow( size() + n );
+			 		open_gap( index, n );
+			 		std::memcpy( static_cast< void * >( storage() + index ), values.data(), n * sizeof( value_type ) );
+			 	}
+			 	else
+			 	{
+			 		// The mapping stays put; elements of the range that were in the shifted tail are read
+			 		// from their new place.
+			 		const pointer at = storage() + index, old_end = storage() + size();
+			 		open_gap( index, n );
+			 		for( pointer dest = at; first != last; ++first, ++dest )
+			 		{
+			 			const value_type * source = std::addressof( *first );
+			 			if( source >= at and source < old_end ){	source += n;	}
+			 			std::memmove( static_cast< void * >( dest ), source, sizeof( value_type ) );
+			 		}
+			 	}
+			 	set_size( size() + n );
+
+			 	return Iterator( storage() + index );
+			 }
+
+			 Iterator insert( const_iterator position, const_reference ref )
+			 {
+			 	check_writable();
+			 	const size_type index = position - cbegin();
+			 	const value_type value( ref ); // ref may be an element, moved by the gap or by mremap.
+
+			 	grow( size() + 1 );
+			 	open_gap( index, 1 );
+			 	std::memcpy( static_cast< void * >( storage() + index ), &value, sizeof( value_type ) );
+			 	set_size( size() + 1 );
+
+			 	return Iterator( storage() + index );
+			 }
+
+			 Iterator insert( const_iterator position, std::initializer_list< value_type > ilist ){	return insert( position, ilist.begin(), ilist.end() );	}
+
+			 Iterator erase( const_iterator first, const_iterator last )
+			 {
+			 	check_writable();
+			 	const size_type index = first - cbegin();
+			 	const size_type count = last - first;
+
+			 	pointer at = storage() + index;
+			 	std::memmove( static_cast< void * >( at ), at + count, ( size() - index - count ) * sizeof( value_type ) );
+			 	set_size( size() - count );
+
+			 	return Iterator( at );
+			 }
+
+			 Iterator erase( const_iterator position ){	return erase( position, position + 1 );	}
+
+//#############################  [V] Element access
+
+			 const_reference back( void ) const
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :( \n");}
+			 	return storage()[size()-1];
+			 }
+
+			 reference back( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :( \n");}
+			 	return storage()[size()-1];
+			 }
+
+			 const_reference front( void ) const
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :(\n");}
+			 	return storage()[0];
+			 }
+
+			 reference front( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :(\n");}
+			 	return storage()[0];
+			 }
+
+			 const_reference operator[]( size_type posi ) const{	return storage()[posi];	}
+
+			 reference operator[]( size_type n )
+			 {
+			 	if( n >= size() ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return storage()[n];
+			 }
+
+			 const_reference at( size_type n ) const
+			 {
+			 	if( n >= size() ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return storage()[n];
+			 }
+
+			 reference at( size_type n )
+			 {
+			 	if( n >= size() ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return storage()[n];
+			 }
+
+			 pointer data( void ){	return storage();	}
+			 const T * data( void ) const{	return storage();	}
+
+			 Iterator find( const_reference value ){	return Iterator( storage() + simd::find( data(), size(), value ) );	}
+			 const_iterator find( const_reference value ) const{	return const_iterator( storage() + simd::find( data(), size(), value ) );	}
+			 size_type count( const_reference value ) const{	return simd::count( data(), size(), value );	}
+			 bool contains( const_reference value ) const{	return simd::find( data(), size(), value ) != size();	}
+
+//############################# [VI] Operators
+
+			 bool operator== ( const mmap_vector & test_v ) const
+			 {
+			 	return size() == test_v.size() and simd::mismatch( data(), test_v.data(), size() ) == size();
+			 }
+
+			 bool operator!= ( const mmap_vector & test_v ) const{	return not ( *this == test_v );	}
+	};
+};
+
+#endif
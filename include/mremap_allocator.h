@@ -0,0 +1,156 @@
+/**
+ * @file    mremap_allocator.h
+ * @brief   Allocator whose blocks can grow in place: small blocks come from malloc and grow with realloc,
+ *          blocks of MapThreshold bytes or more are anonymous mappings that grow with mremap, so the
+ *          kernel moves page table entries instead of copying the elements. sc::vector uses it through
+ *          the reallocate() extension point for trivially copyable elements. POSIX only.
+ * @author  Bruna Hellen de Castro Dantas Barbosa
+ */
+
+#ifndef MREMAP_ALLOCATOR_H
+#define MREMAP_ALLOCATOR_H
+
+#include <cstdlib> // std::malloc, std::realloc, std::free
+#include <cstring> // std::memcpy
+#include <limits> // std::numeric_limits
+#include <new> // std::bad_alloc
+
+#include <sys/mman.h> // mmap, mremap, munmap, madvise
+
+
+namespace sc
+{
+
+	/**
+	 * @brief Allocator with in-place growth.
+	 *
+	 * @tparam T Element type.
+	 * @tparam MapThreshold Blocks of at least this many bytes are anonymous mappings instead of heap blocks.
+	 * @tparam HugePageThreshold Mappings of at least this many bytes are advised to use transparent huge
+	 * pages (MADV_HUGEPAGE), which cuts the TLB misses of long scans. The default never does it. Best
+	 * for storage reserved up front: remapping a huge page mapping on every growth splits and collapses
+	 * its pages again, which makes long runs of push_back much slower.
+	 */
+	template < typename T, std::size_t MapThreshold = ( 1 << 20 ), std::size_t HugePageThreshold = std::size_t( -1 ) >
+	class mremap_allocator
+	{
+		public:
+
+			typedef T value_type;
+			typedef T * pointer;
+			typedef std::size_t size_type;
+
+			template < typename U >
+			struct rebind{	typedef mremap_allocator< U, MapThreshold, HugePageThreshold > other;	};
+
+			mremap_allocator( ) noexcept{	/* Empty */	}
+
+			template < typename U >
+			mremap_allocator( const mremap_allocator< U, MapThreshold, HugePageThreshold > & ) noexcept{	/* Empty */	}
+
+		private:
+
+			static bool mapped( size_type bytes ){	return bytes >= MapThreshold;	}
+
+			static size_type bytes_for( size_type n )
+			{
+				if( n > std::numeric_limits< size_type >::max() / sizeof( value_type ) ){	throw std::bad_alloc();	}
+				return n * sizeof( value_type );
+			}
+
+			static void advise( void * address, size_type bytes )
+			{
+#ifdef MADV_HUGEPAGE
+				if( bytes >= HugePageThreshold ){	::madvise( address, bytes, MADV_HUGEPAGE );	}
+#else
+				(void) address; (void) bytes;
+#endif
+			}
+
+			static void * map( size_type bytes )
+			{
+				void * address = ::mmap( nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+				if( address == MAP_FAILED ){	throw std::bad_alloc();	}
+				advise( address, bytes );
+				return address;
+			}
+
+			static void * remap( void * address, size_type old_bytes, size_type new_bytes )
+			{
+#ifdef MREMAP_MAYMOVE
+				void * moved = ::mremap( address, old_bytes, new_bytes, MREMAP_MAYMOVE );
+				if( moved == MAP_FAILED ){	throw std::bad_alloc();	}
+				if( new_bytes > old_bytes ){	advise( moved, new_bytes );	}
+				return moved;
+#else
+				void * moved = map( new_bytes );
+				std::memcpy( moved, address, old_bytes < new_bytes ? old_bytes : new_bytes );
+				::munmap( address, old_bytes );
+				return moved;
+#endif
+			}
+
+		public:
+
+			pointer allocate( size_type n )
+			{
+				const size_type bytes = bytes_for( n );
+				if( bytes == 0 ){	return nullptr;	}
+				if( mapped( bytes ) ){	return static_cast< pointer >( map( bytes ) );	}
+
+				void * address = std::malloc( bytes );
+				if( address == nullptr ){	throw std::bad_alloc();	}
+				return static_cast< pointer >( address );
+			}
+
+			void deallocate( pointer ptr, size_type n ) noexcept
+			{
+				if( ptr == nullptr ){	return;	}
+				if( mapped( n * sizeof( value_type ) ) ){	::munmap( ptr, n * sizeof( value_type ) );	}
+				else{	std::free( ptr );	}
+			}
+
+			/**
+			 * @brief Resizes the block of old_n elements at ptr to new_n elements, in place when possible.
+			 * The first min(old_n, new_n) elements are kept byte by byte, so the elements must be trivially
+			 * copyable. On failure std::bad_alloc is thrown and the old block is left untouched.
+			 *
+			 * @param ptr
+			 * @param old_n
+			 * @param new_n
+			 * @return Pointer to the resized block, which may have moved.
+			 */
+			pointer reallocate( pointer ptr, size_type old_n, size_type new_n )
+			{
+				const size_type old_bytes = bytes_for( old_n );
+				const size_type new_bytes = bytes_for( new_n );
+
+				if( ptr == nullptr or old_bytes == 0 ){	deallocate( ptr, old_n ); return allocate( new_n );	}
+				if( new_bytes == 0 ){	deallocate( ptr, old_n ); return nullptr;	}
+
+				if( mapped( old_bytes ) and mapped( new_bytes ) ){	return static_cast< pointer >( remap( ptr, old_bytes, new_bytes ) );	}
+
+				if( not mapped( old_bytes ) and not mapped( new_bytes ) )
+				{
+					void * address = std::realloc( ptr, new_bytes );
+					if( address == nullptr ){	throw std::bad_alloc();	}
+					return static_cast< pointer >( address );
+				}
+
+				// Crossing the threshold changes the kind of block, the elements are copied once.
+				pointer moved = allocate( new_n );
+				std::memcpy( static_cast< void * >( moved ), ptr, old_bytes < new_bytes ? old_bytes : new_bytes );
+				deallocate( ptr, old_n );
+				return moved;
+			}
+
+			bool operator== ( const mremap_allocator & ) const noexcept{	return true;	}
+			bool operator!= ( const mremap_allocator & ) const noexcept{	return false;	}
+	};
+
+	/// mremap_allocator that asks for transparent huge pages on mappings of 2 MiB (one huge page) or more.
+	template < typename T >
+	using huge_page_allocator = mremap_allocator< T, ( 1 << 20 ), ( 2 << 20 ) >;
+};
+
+#endif
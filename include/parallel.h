@@ -0,0 +1,319 @@
+/**
+ * @file    parallel.h
+ * @brief   Execution policy sc::par and the thread pool behind it. The policy splits an operation over
+ *          n elements in chunks of about chunk_bytes, runs them on the pool and falls back to the calling
+ *          thread below threshold_bytes. sc::vector takes it in its fill and copy constructors, assign and
+ *          shrink_to_fit; fill, copy, for_each, transform and reduce below take it over random access ranges.
+ * @author  Bruna Hellen de Castro Dantas Barbosa
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "vector.h"
+
+#include <atomic> // std::atomic
+#include <condition_variable> // std::condition_variable
+#include <deque> // std::deque
+#include <exception> // std::exception_ptr
+#include <functional> // std::function
+#include <mutex> // std::mutex, std::unique_lock
+#include <thread> // std::thread
+#include <vector> // std::vector
+
+
+namespace sc
+{
+
+	/**
+	 * Fixed set of worker threads that run the chunks of parallel operations. The thread that starts an
+	 * operation works on it too, and an operation started from inside a worker runs sequentially, so
+	 * nested parallel calls can't deadlock the pool.
+	 */
+	class thread_pool
+	{
+
+		public:
+
+			/**
+			 * @brief Starts `threads` workers; 0 makes every operation run on the calling thread.
+			 *
+			 * @param threads
+			 */
+			explicit thread_pool( std::size_t threads ): m_stop(false)
+			{
+				for( std::size_t i = 0; i < threads; ++i ){	m_workers.emplace_back( &thread_pool::work, this );	}
+			}
+
+			thread_pool( const thread_pool & ) = delete;
+			thread_pool & operator= ( const thread_pool & ) = delete;
+
+			~thread_pool( )
+			{
+				{
+					std::lock_guard< std::mutex > guard( m_lock );
+					m_stop = true;
+				}
+				m_wake.notify_all();
+				for( auto & worker : m_workers ){	worker.join();	}
+			}
+
+			/// Pool shared by the default policies: one worker per hardware thread, the caller being one of them.
+			static thread_pool & instance( void )
+			{
+				static thread_pool pool( std::max( 1u, std::thread::hardware_concurrency() ) - 1 );
+				return pool;
+			}
+
+			std::size_t size( void ) const{	return m_workers.size();	}
+
+			/**
+			 * @brief Calls f( begin, end ) on the chunks [0, grain), [grain, 2 * grain), ... of [0, n), spread
+			 * over the workers and the calling thread, and returns once all of them ran. If calls throw, the
+			 * chunks not started yet are skipped and the first exception is rethrown here.
+			 *
+			 * @param n
+			 * @param grain
+			 * @param f
+			 */
+			template < typename Function >
+			void parallel_for( std::size_t n, std::size_t grain, Function f )
+			{
+				const std::size_t chunks = ( n + grain - 1 ) / grain;
+				if( chunks <= 1 or m_workers.empty() or inside_worker() ){	sequential_for( n, grain, f ); return;	}
+
+				std::atomic< std::size_t > next( 0 );
+				std::exception_ptr error;
+				std::mutex finished_lock;
+				std::condition_variable finished;
+				std::size_t pending = 0;
+
+				auto drain = [&]( )
+				{
+					for( std::size_t chunk; ( chunk = next.fetch_add( 1 ) ) < chunks; )
+					{
+						try{	f( chunk * grain, std::min( n, ( chunk + 1 ) * grain ) );	}
+						catch( ... )
+						{
+							std::lock_guard< std::mutex > guard( finished_lock );
+							if( not error ){	error = std::current_exception();	}
+							next.store( chunks );
+						}
+					}
+				};
+
+				auto helper = [&]( )
+				{
+					drain();
+					std::lock_guard< std::mutex > guard( finished_lock );
+					if( --pending == 0 ){	finished.notify_one();	}
+				};
+
+				// Queueing may fail to allocate; the caller then drains the chunks with fewer helpers.
+				const std::size_t helpers = std::min( chunks - 1, m_workers.size() );
+				for( std::size_t i = 0; i < helpers; ++i )
+				{
+					try
+					{
+						std::lock_guard< std::mutex > guard( m_lock );
+						m_tasks.push_back( helper );
+					}
+					catch( ... ){	break;	}
+
+					std::lock_guard< std::mutex > guard( finished_lock );
+					++pending;
+				}
+				m_wake.notify_all();
+
+				drain();
+
+				std::unique_lock< std::mutex > guard( finished_lock );
+				finished.wait( guard, [&pending]( ){	return pending == 0;	} );
+				if( error ){	std::rethrow_exception( error );	}
+			}
+
+			/**
+			 * @brief Calls f( begin, end ) on the chunks of [0, n) in order, on the calling thread.
+			 *
+			 * @param n
+			 * @param grain
+			 * @param f
+			 */
+			template < typename Function >
+			static void sequential_for( std::size_t n, std::size_t grain, Function & f )
+			{
+				for( std::size_t begin = 0; begin < n; begin += grain ){	f( begin, std::min( n, begin + grain ) );	}
+			}
+
+		private:
+			std::vector< std::thread > m_workers; //<! Threads running work().
+			std::deque< std::function< void() > > m_tasks; //<! Tasks waiting for a worker.
+			std::mutex m_lock; //<! Guards m_tasks and m_stop.
+			std::condition_variable m_wake; //<! Signals a new task or the shutdown.
+			bool m_stop; //<! Set by the destructor, the workers exit once the queue is empty.
+
+			static bool & inside_worker( void )
+			{
+				static thread_local bool inside = false;
+				return inside;
+			}
+
+			void work( void )
+			{
+				inside_worker() = true;
+
+				for( ;; )
+				{
+					std::function< void() > task;
+					{
+						std::unique_lock< std::mutex > guard( m_lock );
+						m_wake.wait( guard, [this]( ){	return m_stop or not m_tasks.empty();	} );
+						if( m_tasks.empty() ){	return;	}
+
+						task = std::move( m_tasks.front() );
+						m_tasks.pop_front();
+					}
+					task();
+				}
+			}
+	};
+
+	/**
+	 * Execution policy of the parallel overloads. The defaults give each thread 256 KiB chunks, which stay
+	 * in a per-core L2 cache, and keep operations under 2 MiB on the calling thread, where waking the pool
+	 * would cost more than it saves.
+	 */
+	struct parallel_policy
+	{
+		typedef void is_execution_policy;
+
+		std::size_t chunk_bytes; //<! Bytes of elements handed to a thread at a time.
+		std::size_t threshold_bytes; //<! Operations on fewer bytes run on the calling thread.
+		thread_pool * pool; //<! Pool running the chunks, nullptr for thread_pool::instance().
+
+		/// Number of elements in a chunk.
+		std::size_t grain( std::size_t element_size ) const{	return std::max( std::size_t( 1 ), chunk_bytes / element_size );	}
+
+		/**
+		 * @brief Calls f( begin, end ) on the chunks of [0, n), n elements of element_size bytes, in parallel
+		 * when they are at least threshold_bytes.
+		 *
+		 * @param n
+		 * @param element_size
+		 * @param f
+		 */
+		template < typename Function >
+		void run( std::size_t n, std::size_t element_size, Function f ) const
+		{
+			if( n * element_size < threshold_bytes ){	thread_pool::sequential_for( n, grain( element_size ), f );	}
+			else if( pool != nullptr ){	pool->parallel_for( n, grain( element_size ), f );	}
+			else{	thread_pool::instance().parallel_for( n, grain( element_size ), f );	}
+		}
+	};
+
+	const parallel_policy par = { std::size_t( 256 ) << 10, std::size_t( 2 ) << 20, nullptr };
+
+	/**
+	 * @brief Assigns value to every element of [first, last).
+	 *
+	 * @param policy
+	 * @param first
+	 * @param last
+	 * @param value
+	 */
+	template < typename RandomItr, typename T >
+	void fill( const parallel_policy & policy, RandomItr first, RandomItr last, const T & value )
+	{
+		typedef typename std::iterator_traits< RandomItr >::value_type value_type;
+		policy.run( last - first, sizeof( value_type ), [first, &value]( std::size_t begin, std::size_t end ){	std::fill( first + begin, first + end, value );	} );
+	}
+
+	/**
+	 * @brief Copies [first, last) to the range starting at d_first.
+	 *
+	 * @param policy
+	 * @param first
+	 * @param last
+	 * @param d_first
+	 * @return End of the copied range.
+	 */
+	template < typename RandomItr, typename OutputItr >
+	OutputItr copy( const parallel_policy & policy, RandomItr first, RandomItr last, OutputItr d_first )
+	{
+		typedef typename std::iterator_traits< RandomItr >::value_type value_type;
+		policy.run( last - first, sizeof( value_type ), [first, d_first]( std::size_t begin, std::size_t end ){	std::copy( first + begin, first + end, d_first + begin );	} );
+		return d_first + ( last - first );
+	}
+
+	/**
+	 * @brief Calls f on every element of [first, last), in no particular order.
+	 *
+	 * @param policy
+	 * @param first
+	 * @param last
+	 * @param f
+	 */
+	template < typename RandomItr, typename Function >
+	void for_each( const parallel_policy & policy, RandomItr first, RandomItr last, Function f )
+	{
+		typedef typename std::iterator_traits< RandomItr >::value_type value_type;
+		policy.run( last - first, sizeof( value_type ), [first, &f]( std::size_t begin, std::size_t end ){	std::for_each( first + begin, first + end, f );	} );
+	}
+
+	/**
+	 * @brief Writes op( x ) for every x of [first, last) to the range starting at d_first.
+	 *
+	 * @param policy
+	 * @param first
+	 * @param last
+	 * @param d_first
+	 * @param op
+	 * @return End of the written range.
+	 */
+	template < typename RandomItr, typename OutputItr, typename UnaryOp >
+	OutputItr transform( const parallel_policy & policy, RandomItr first, RandomItr last, OutputItr d_first, UnaryOp op )
+	{
+		typedef typename std::iterator_traits< RandomItr >::value_type value_type;
+		policy.run( last - first, sizeof( value_type ), [first, d_first, &op]( std::size_t begin, std::size_t end ){	std::transform( first + begin, first + end, d_first + begin, op );	} );
+		return d_first + ( last - first );
+	}
+
+	/**
+	 * @brief Folds [first, last) into init with op, which must be associative and commutative: each chunk
+	 * is folded on its own and the partial results are folded into init in order.
+	 *
+	 * @param policy
+	 * @param first
+	 * @param last
+	 * @param init
+	 * @param op
+	 * @return T
+	 */
+	template < typename RandomItr, typename T, typename BinaryOp >
+	T reduce( const parallel_policy & policy, RandomItr first, RandomItr last, T init, BinaryOp op )
+	{
+		typedef typename std::iterator_traits< RandomItr >::value_type value_type;
+
+		const std::size_t n = last - first;
+		if( n == 0 ){	return init;	}
+
+		const std::size_t grain = policy.grain( sizeof( value_type ) );
+		std::vector< T > partials( ( n + grain - 1 ) / grain, init );
+
+		policy.run( n, sizeof( value_type ), [first, grain, &partials, &op]( std::size_t begin, std::size_t end )
+		{
+			T partial = first[begin];
+			for( std::size_t i = begin + 1; i < end; ++i ){	partial = op( partial, first[i] );	}
+			partials[ begin / grain ] = partial;
+		} );
+
+		for( const T & partial : partials ){	init = op( init, partial );	}
+		return init;
+	}
+
+	/// sc::reduce with std::plus.
+	template < typename RandomItr, typename T >
+	T reduce( const parallel_policy & policy, RandomItr first, RandomItr last, T init ){	return sc::reduce( policy, first, last, init, std::plus< T >() );	}
+};
+
+#endif
@@ -0,0 +1,747 @@
+/**
+ * @file    persistent_vector.h
+ * @brief   Immutable sequencial container with structural sharing: sc::persistent_vector< T > is a 32-way
+ *          radix tree of leaves plus a separate tail leaf, so push_back, set and pop_back return a new
+ *          version in O(log32 n) that shares every untouched node with the old one. sc::transient_vector
+ *          is its mutable builder for batches of edits.
+ * @author  Bruna Hellen de Castro Dantas Barbosa
+ */
+
+#ifndef PERSISTENT_VECTOR_H
+#define PERSISTENT_VECTOR_H
+
+#include "vector.h"
+
+#include <atomic> // std::atomic
+
+
+namespace sc
+{
+
+	namespace detail
+	{
+		/**
+		 * Storage shared by persistent_vector and transient_vector. A branch at level L (a multiple of bits)
+		 * picks its child with bits ( index >> L ) & mask, its children are at level L - bits, and level 0
+		 * holds the leaves of width elements. The elements [tail_offset(), size) live in the tail leaf
+		 * instead of the tree, so most push_backs and pop_backs don't walk it.
+		 *
+		 * Nodes are reference counted. An edit copies the nodes of its path that are shared (count above 1)
+		 * and writes in place those only this tree reaches, so a tree copied from another one pays O(log n)
+		 * copies per edit while a tree built on its own edits in place.
+		 */
+		template < typename T >
+		class radix_tree
+		{
+			public:
+
+				typedef std::size_t size_type;
+				typedef T value_type;
+
+				static const size_type bits = 5;
+				static const size_type width = size_type( 1 ) << bits;
+				static const size_type mask = width - 1;
+
+			private:
+
+				struct node
+				{
+					std::atomic< size_type > refs; //<! Trees and branches pointing to this node.
+
+					node( ): refs(1){	/* Empty */	}
+				};
+
+				struct leaf : node
+				{
+					size_type count; //<! Constructed elements, in slots [0, count).
+					alignas( T ) unsigned char slots[ width * sizeof( T ) ]; //<! Raw storage of the elements.
+
+					leaf( ): count(0){	/* Empty */	}
+
+					T * data( void ){	return reinterpret_cast< T * >( slots );	}
+					const T * data( void ) const{	return reinterpret_cast< const T * >( slots );	}
+				};
+
+				struct branch : node
+				{
+					node * children[ width ]; //<! Subtrees, nullptr past the last element.
+
+					branch( ): children(){	/* Empty */	}
+				};
+
+				size_type m_size; //<! Number of elements.
+				size_type m_shift; //<! Level of the root.
+				node * m_root; //<! Branch holding [0, tail_offset()), nullptr while that range is empty.
+				node * m_tail; //<! Leaf holding [tail_offset(), m_size), nullptr while the tree is empty.
+
+				static leaf * as_leaf( node * n ){	return static_cast< leaf * >( n );	}
+				static branch * as_branch( node * n ){	return static_cast< branch * >( n );	}
+
+				static void retain( node * n ){	if( n != nullptr ){	n->refs.fetch_add( 1, std::memory_order_relaxed );	}	}
+
+				/// Drops a reference to the node at level, freeing it and its subtree with the last one.
+				static void release( node * n, size_type level ) noexcept
+				{
+					if( n == nullptr or n->refs.fetch_sub( 1, std::memory_order_acq_rel ) != 1 ){	return;	}
+
+					if( level == 0 )
+					{
+						leaf * l = as_leaf( n );
+						for( size_type i = 0; i < l->count; ++i ){	l->data()[i].~T();	}
+						delete l;
+						return;
+					}
+
+					branch * b = as_branch( n );
+					for( node * child : b->children ){	release( child, level - bits );	}
+					delete b;
+				}
+
+				/// Whether this tree holds the only reference to n, so n may be written in place.
+				static bool unique( const node * n ){	return n->refs.load( std::memory_order_acquire ) == 1;	}
+
+				/**
+				 * @brief New leaf with copies of the first count elements of source.
+				 *
+				 * @param source
+				 * @param count
+				 * @return leaf*
+				 */
+				static leaf * clone_leaf( node * source, size_type count )
+				{
+					leaf * copy = new leaf;
+					try
+					{
+						for( ; copy->count < count; ++copy->count ){	::new( static_cast< void * >( copy->data() + copy->count ) ) T( as_leaf( source )->data()[ copy->count ] );	}
+					}
+					catch( ... ){	release( copy, 0 ); throw;	}
+					return copy;
+				}
+
+				/**
+				 * @brief Makes the leaf in slot writable, replacing it by a copy if it is shared.
+				 *
+				 * @param slot
+				 * @return leaf*
+				 */
+				static leaf * editable_leaf( node *& slot )
+				{
+					if( not unique( slot ) )
+					{
+						leaf * copy = clone_leaf( slot, as_leaf( slot )->count );
+						release( slot, 0 );
+						slot = copy;
+					}
+					return as_leaf( slot );
+				}
+
+				/**
+				 * @brief Makes the branch at level in slot writable, replacing it by a copy if it is shared.
+				 *
+				 * @param slot
+				 * @param level
+				 * @return branch*
+				 */
+				static branch * editable_branch( node *& slot, size_type level )
+				{
+					if( not unique( slot ) )
+					{
+						branch * copy = new branch;
+						for( size_type i = 0; i < width; ++i )
+						{
+							copy->children[i] = as_branch( slot )->children[i];
+							retain( copy->children[i] );
+						}
+						release( slot, level );
+						slot = copy;
+					}
+					return as_branch( slot );
+				}
+
+				/**
+				 * @brief Chain of branches from level down to level bits, whose first leaf is l.
+				 *
+				 * @param level
+				 * @param l
+				 * @return node*
+				 */
+				static node * new_path( size_type level, node * l )
+				{
+					branch * top = new branch;
+					branch * bottom = top;
+					try
+					{
+						for( size_type below = level; below > bits; below -= bits )
+						{
+							branch * child = new branch;
+							bottom->children[0] = child;
+							bottom = child;
+						}
+					}
+					catch( ... ){	release( top, level ); throw;	}
+
+					bottom->children[0] = l;
+					return top;
+				}
+
+				/// Leaf holding index, which must be less than m_size.
+				node * leaf_node( size_type index ) const
+				{
+					if( index >= tail_offset() ){	return m_tail;	}
+
+					node * n = m_root;
+					for( size_type level = m_shift; level > 0; level -= bits ){	n = as_branch( n )->children[ ( index >> level ) & mask ];	}
+					return n;
+				}
+
+				/**
+				 * @brief Moves the full tail into the subtree at level in slot, where it becomes the last leaf.
+				 *
+				 * @param slot
+				 * @param level
+				 */
+				void push_tail( node *& slot, size_type level )
+				{
+					branch * b = editable_branch( slot, level );
+					node *& child = b->children[ ( ( m_size - 1 ) >> level ) & mask ];
+
+					if( level == bits ){	child = m_tail;	}
+					else if( child != nullptr ){	push_tail( child, level - bits );	}
+					else{	child = new_path( level - bits, m_tail );	}
+				}
+
+				/**
+				 * @brief Removes the last leaf of the subtree at level in slot, dropping the subtree if it was
+				 * its only leaf.
+				 *
+				 * @param slot
+				 * @param level
+				 */
+				void pop_tail( node *& slot, size_type level )
+				{
+					const size_type last_leaf = ( m_size - 2 ) >> bits;
+					if( ( last_leaf & ( ( size_type( 1 ) << level ) - 1 ) ) == 0 )
+					{
+						release( slot, level );
+						slot = nullptr;
+						return;
+					}
+
+					branch * b = editable_branch( slot, level );
+					pop_tail( b->children[ ( ( m_size - 2 ) >> level ) & mask ], level - bits );
+				}
+
+				/// Visits the leaves of the subtree at level in order.
+				template < typename Function >
+				static void for_each_leaf( const node * n, size_type level, Function & f )
+				{
+					if( level == 0 )
+					{
+						const T * first = static_cast< const leaf * >( n )->data();
+						f( first, first + width );
+						return;
+					}
+					for( const node * child : static_cast< const branch * >( n )->children )
+					{
+						if( child == nullptr ){	return;	}
+						for_each_leaf( child, level - bits, f );
+					}
+				}
+
+			public:
+
+				radix_tree( ): m_size(0), m_shift(bits), m_root(nullptr), m_tail(nullptr){	/* Empty */	}
+
+				radix_tree( const radix_tree & model ): m_size(model.m_size), m_shift(model.m_shift), m_root(model.m_root), m_tail(model.m_tail)
+				{
+					retain( m_root );
+					retain( m_tail );
+				}
+
+				radix_tree( radix_tree && model ) noexcept: m_size(model.m_size), m_shift(model.m_shift), m_root(model.m_root), m_tail(model.m_tail)
+				{
+					model.m_size = 0;
+					model.m_shift = bits;
+					model.m_root = nullptr;
+					model.m_tail = nullptr;
+				}
+
+				radix_tree & operator= ( radix_tree model ) noexcept
+				{
+					swap( model );
+					return *this;
+				}
+
+				~radix_tree( )
+				{
+					release( m_root, m_shift );
+					release( m_tail, 0 );
+				}
+
+				void swap( radix_tree & other ) noexcept
+				{
+					std::swap( m_size, other.m_size );
+					std::swap( m_shift, other.m_shift );
+					std::swap( m_root, other.m_root );
+					std::swap( m_tail, other.m_tail );
+				}
+
+				size_type size( void ) const{	return m_size;	}
+
+				/// Index of the first element of the tail.
+				size_type tail_offset( void ) const{	return m_size < width ? 0 : ( ( m_size - 1 ) >> bits ) << bits;	}
+
+				/**
+				 * @brief First element of the leaf holding index, which must be less than size().
+				 *
+				 * @param index
+				 * @return const T*
+				 */
+				const T * block( size_type index ) const{	return as_leaf( leaf_node( index ) )->data();	}
+
+				const T & operator[] ( size_type index ) const{	return block( index )[ index & mask ];	}
+
+				/**
+				 * @brief Appends an element constructed from args. If it throws, the elements are unchanged.
+				 *
+				 * @param args
+				 */
+				template < typename... Args >
+				void emplace_back( Args&&... args )
+				{
+					if( m_tail != nullptr and m_size - tail_offset() < width )
+					{
+						leaf * tail = editable_leaf( m_tail );
+						::new( static_cast< void * >( tail->data() + tail->count ) ) T( std::forward< Args >( args )... );
+						++tail->count;
+						++m_size;
+						return;
+					}
+
+					leaf * fresh = new leaf;
+					try{	::new( static_cast< void * >( fresh->data() ) ) T( std::forward< Args >( args )... );	}
+					catch( ... ){	delete fresh; throw;	}
+					fresh->count = 1;
+
+					if( m_tail != nullptr )
+					{
+						try
+						{
+							if( m_root == nullptr ){	m_root = new_path( m_shift, m_tail );	}
+							else if( ( m_size >> bits ) > ( size_type( 1 ) << m_shift ) )
+							{
+								// The tree is full: a new root takes it as its first child.
+								branch * top = new branch;
+								try{	top->children[1] = new_path( m_shift, m_tail );	}
+								catch( ... ){	delete top; throw;	}
+								top->children[0] = m_root;
+								m_root = top;
+								m_shift += bits;
+							}
+							else{	push_tail( m_root, m_shift );	}
+						}
+						catch( ... ){	release( fresh, 0 ); throw;	}
+					}
+
+					// The tree took over the reference to the old tail.
+					m_tail = fresh;
+					++m_size;
+				}
+
+				/**
+				 * @brief Assigns value to the element at index, which must be less than size().
+				 *
+				 * @param index
+				 * @param value
+				 */
+				template < typename U >
+				void set( size_type index, U && value )
+				{
+					if( index >= tail_offset() ){	editable_leaf( m_tail )->data()[ index & mask ] = std::forward< U >( value );	return;	}
+
+					node ** slot = &m_root;
+					for( size_type level = m_shift; level > 0; level -= bits ){	slot = &editable_branch( *slot, level )->children[ ( index >> level ) & mask ];	}
+					editable_leaf( *slot )->data()[ index & mask ] = std::forward< U >( value );
+				}
+
+				/**
+				 * @brief Removes the last element, the tree must not be empty.
+				 *
+				 */
+				void pop_back( void )
+				{
+					if( m_size == 1 )
+					{
+						release( m_tail, 0 );
+						m_tail = nullptr;
+						m_size = 0;
+						return;
+					}
+
+					const size_type in_tail = m_size - tail_offset();
+					if( in_tail > 1 )
+					{
+						if( unique( m_tail ) ){	as_leaf( m_tail )->data()[ in_tail - 1 ].~T();	}
+						else
+						{
+							node * copy = clone_leaf( m_tail, in_tail - 1 );
+							release( m_tail, 0 );
+							m_tail = copy;
+						}
+						as_leaf( m_tail )->count = in_tail - 1;
+						--m_size;
+						return;
+					}
+
+					// The tail empties: the last leaf of the tree becomes the tail.
+					node * last = leaf_node( m_size - 2 );
+					retain( last );
+					try{	pop_tail( m_root, m_shift );	}
+					catch( ... ){	release( last, 0 ); throw;	}
+
+					release( m_tail, 0 );
+					m_tail = last;
+					--m_size;
+
+					if( m_root == nullptr ){	m_shift = bits;	}
+					else if( m_shift > bits and as_branch( m_root )->children[1] == nullptr )
+					{
+						node * child = as_branch( m_root )->children[0];
+						retain( child );
+						release( m_root, m_shift );
+						m_root = child;
+						m_shift -= bits;
+					}
+				}
+
+				/**
+				 * @brief Calls f( first, last ) on the runs of contiguous elements, in order.
+				 *
+				 * @param f
+				 */
+				template < typename Function >
+				void for_each_run( Function f ) const
+				{
+					if( m_root != nullptr ){	for_each_leaf( m_root, m_shift, f );	}
+					if( m_tail != nullptr )
+					{
+						const T * first = as_leaf( m_tail )->data();
+						f( first, first + ( m_size - tail_offset() ) );
+					}
+				}
+		};
+
+		/**
+		 * Random access iterator over a radix_tree. It keeps the leaf of its element, so stepping through
+		 * the elements walks the tree once per leaf.
+		 */
+		template < typename T >
+		class radix_iterator
+		{
+			public:
+
+				typedef std::ptrdiff_t difference_type;
+				typedef T value_type;
+				typedef const T* pointer;
+				typedef const T& reference;
+				typedef std::random_access_iterator_tag iterator_category;
+
+				radix_iterator( const radix_tree< T > * tree = nullptr, difference_type index = 0 ): m_tree(tree), m_index(index), m_block(locate()){	/* Empty */	}
+
+				difference_type index( void ) const{	return m_index;	}
+
+				reference operator* ( void ) const{	return m_block[ m_index & radix_tree< T >::mask ];	}
+				pointer operator-> ( void ) const{	return m_block + ( m_index & radix_tree< T >::mask );	}
+				reference operator[] ( difference_type n ) const{	return ( *m_tree )[ m_index + n ];	}
+
+				radix_iterator & operator++ ( void )
+				{
+					if( ( ++m_index & radix_tree< T >::mask ) == 0 or m_block == nullptr ){	m_block = locate();	}
+					return *this;
+				}
+
+				/// end() holds no leaf, so stepping back from it looks one up.
+				radix_iterator & operator-- ( void )
+				{
+					if( ( m_index-- & radix_tree< T >::mask ) == 0 or m_block == nullptr ){	m_block = locate();	}
+					return *this;
+				}
+
+				radix_iterator operator++ ( int ){	radix_iterator old( *this ); ++*this; return old;	}
+				radix_iterator operator-- ( int ){	radix_iterator old( *this ); --*this; return old;	}
+				radix_iterator & operator+= ( difference_type n ){	m_index += n; m_block = locate(); return *this;	}
+				radix_iterator & operator-= ( difference_type n ){	m_index -= n; m_block = locate(); return *this;	}
+
+				friend radix_iterator operator+ ( radix_iterator it, difference_type n ){	return it += n;	}
+				friend radix_iterator operator+ ( difference_type n, radix_iterator it ){	return it += n;	}
+				friend radix_iterator operator- ( radix_iterator it, difference_type n ){	return it -= n;	}
+				friend difference_type operator- ( const radix_iterator & a, const radix_iterator & b ){	return a.m_index - b.m_index;	}
+
+				friend bool operator== ( const radix_iterator & a, const radix_iterator & b ){	return a.m_index == b.m_index;	}
+				friend bool operator!= ( const radix_iterator & a, const radix_iterator & b ){	return a.m_index != b.m_index;	}
+				friend bool operator< ( const radix_iterator & a, const radix_iterator & b ){	return a.m_index < b.m_index;	}
+				friend bool operator> ( const radix_iterator & a, const radix_iterator & b ){	return a.m_index > b.m_index;	}
+				friend bool operator<= ( const radix_iterator & a, const radix_iterator & b ){	return a.m_index <= b.m_index;	}
+				friend bool operator>= ( const radix_iterator & a, const radix_iterator & b ){	return a.m_index >= b.m_index;	}
+
+			private:
+				const radix_tree< T > * m_tree;
+				difference_type m_index;
+				const T * m_block; //<! First element of the leaf holding m_index, nullptr past the end.
+
+				const T * locate( void ) const
+				{
+					return m_tree != nullptr and m_index >= 0 and std::size_t( m_index ) < m_tree->size() ? m_tree->block( m_index ) : nullptr;
+				}
+		};
+	}
+
+	template < typename T >
+	class transient_vector;
+
+	/**
+	 * Immutable vector: the modifiers return a new version and leave this one untouched, sharing all but
+	 * O(log32 n) nodes with it. Copies are O(1). Versions may be read, copied and edited from any number of
+	 * threads at once without locks, as the shared nodes are never written and their reference counts are
+	 * atomic. For many edits in a row, edit a transient() and turn it back with persistent().
+	 */
+	template < typename T >
+	class persistent_vector
+	{
+
+		public:
+
+			typedef size_t size_type;
+			typedef T value_type;
+			typedef detail::radix_iterator< T > const_iterator;
+			typedef const_iterator Iterator; //<! The elements are never writable through a persistent_vector.
+			typedef const T& const_reference;
+			typedef const_reference reference;
+
+		private:
+			friend class transient_vector< T >;
+
+			detail::radix_tree< T > m_tree; //<! Nodes of this version, shared with the others.
+
+			explicit persistent_vector( const detail::radix_tree< T > & tree ): m_tree(tree){	/* Empty */	}
+			explicit persistent_vector( detail::radix_tree< T > && tree ): m_tree(std::move(tree)){	/* Empty */	}
+
+		public:
+
+//############################# [I] SPECIAL MEMBERS
+
+			 persistent_vector( ){	/* Empty */	}
+
+			 template < typename InputItr, typename = detail::require_iterator< InputItr > >
+			 persistent_vector( InputItr first, InputItr last )
+			 {
+			 	for( ; first != last; ++first ){	m_tree.emplace_back( *first );	}
+			 }
+
+			 persistent_vector( std::initializer_list< T > ilist ): persistent_vector( ilist.begin(), ilist.end() ){	/* Empty */	}
+
+			 explicit persistent_vector( const sc::vector< T > & model ): persistent_vector( model.begin(), model.end() ){	/* Empty */	}
+
+//############################# [II] IteratorS
+
+			 const_iterator begin( void ) const{	return cbegin();	}
+			 const_iterator end( void ) const{	return cend();	}
+			 const_iterator cbegin( void ) const{	return const_iterator( &m_tree, 0 );	}
+			 const_iterator cend( void ) const{	return const_iterator( &m_tree, size() );	}
+
+//############################# [III] Capacity
+
+			 size_type size( void ) const{	return m_tree.size();	}
+			 bool empty( void ) const{	return size() == 0;	}
+
+//############################# [IV] Modifiers
+
+			 /**
+			  * @brief The version with value appended.
+			  *
+			  * @param value
+			  * @return persistent_vector
+			  */
+			 persistent_vector push_back( const_reference value ) const
+			 {
+			 	detail::radix_tree< T > tree( m_tree );
+			 	tree.emplace_back( value );
+			 	return persistent_vector( std::move( tree ) );
+			 }
+
+			 persistent_vector push_back( value_type && value ) const
+			 {
+			 	detail::radix_tree< T > tree( m_tree );
+			 	tree.emplace_back( std::move( value ) );
+			 	return persistent_vector( std::move( tree ) );
+			 }
+
+			 /**
+			  * @brief The version with value at index n.
+			  *
+			  * @param n
+			  * @param value
+			  * @return persistent_vector
+			  */
+			 persistent_vector set( size_type n, const_reference value ) const
+			 {
+			 	if( n >= size() ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	detail::radix_tree< T > tree( m_tree );
+			 	tree.set( n, value );
+			 	return persistent_vector( std::move( tree ) );
+			 }
+
+			 /**
+			  * @brief The version without the last element.
+			  *
+			  * @return persistent_vector
+			  */
+			 persistent_vector pop_back( void ) const
+			 {
+			 	if( empty() ){	throw std::out_of_range("Can't pop out of an empty vector \n");	}
+			 	detail::radix_tree< T > tree( m_tree );
+			 	tree.pop_back();
+			 	return persistent_vector( std::move( tree ) );
+			 }
+
+			 /**
+			  * @brief A builder starting from this version. Its edits copy a node only the first time they
+			  * touch one shared with a version, then write it in place.
+			  *
+			  * @return transient_vector< T >
+			  */
+			 transient_vector< T > transient( void ) const{	return transient_vector< T >( *this );	}
+
+//#############################  [V] Element access
+
+			 const_reference operator[]( size_type n ) const{	return m_tree[n];	}
+
+			 const_reference at( size_type n ) const
+			 {
+			 	if( n >= size() ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return m_tree[n];
+			 }
+
+			 const_reference front( void ) const
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :(\n");}
+			 	return m_tree[0];
+			 }
+
+			 const_reference back( void ) const
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :( \n");}
+			 	return m_tree[ size() - 1 ];
+			 }
+
+			 /**
+			  * @brief Copies the elements into a contiguous sc::vector, one leaf at a time.
+			  *
+			  * @return sc::vector< value_type >
+			  */
+			 sc::vector< value_type > to_vector( void ) const
+			 {
+			 	sc::vector< value_type > flat( size() );
+			 	m_tree.for_each_run( [&flat]( const T * first, const T * last ){	flat.insert( flat.end(), first, last );	} );
+			 	return flat;
+			 }
+
+//############################# [VI] Operators
+
+			 friend bool operator== ( const persistent_vector & lhs, const persistent_vector & rhs )
+			 {
+			 	return lhs.size() == rhs.size() and std::equal( lhs.begin(), lhs.end(), rhs.begin() );
+			 }
+
+			 friend bool operator!= ( const persistent_vector & lhs, const persistent_vector & rhs ){	return not ( lhs == rhs );	}
+	};
+
+	/**
+	 * Mutable builder of persistent_vector. push_back, set and pop_back change it in place; the first edit
+	 * of a node shared with a persistent version copies that node, later ones write the copy. persistent()
+	 * publishes the current state in O(1), after which the builder can go on editing. Not thread safe.
+	 */
+	template < typename T >
+	class transient_vector
+	{
+
+		public:
+
+			typedef size_t size_type;
+			typedef T value_type;
+			typedef detail::radix_iterator< T > const_iterator;
+			typedef const T& const_reference;
+
+		private:
+			detail::radix_tree< T > m_tree; //<! Nodes of the builder, some shared with persistent versions.
+
+		public:
+
+//############################# [I] SPECIAL MEMBERS
+
+			 transient_vector( ){	/* Empty */	}
+
+			 explicit transient_vector( const persistent_vector< T > & model ): m_tree(model.m_tree){	/* Empty */	}
+
+			 /**
+			  * @brief A version with the current elements, sharing every node with the builder.
+			  *
+			  * @return persistent_vector< T >
+			  */
+			 persistent_vector< T > persistent( void ) const{	return persistent_vector< T >( m_tree );	}
+
+//############################# [II] IteratorS
+
+			 const_iterator begin( void ) const{	return const_iterator( &m_tree, 0 );	}
+			 const_iterator end( void ) const{	return const_iterator( &m_tree, size() );	}
+
+//############################# [III] Capacity
+
+			 size_type size( void ) const{	return m_tree.size();	}
+			 bool empty( void ) const{	return size() == 0;	}
+
+//############################# [IV] Modifiers
+
+			 template < typename... Args >
+			 void emplace_back( Args&&... args ){	m_tree.emplace_back( std::forward< Args >( args )... );	}
+
+			 void push_back( const_reference value ){	m_tree.emplace_back( value );	}
+			 void push_back( value_type && value ){	m_tree.emplace_back( std::move( value ) );	}
+
+			 /**
+			  * @brief Assigns value to the element at index n.
+			  *
+			  * @param n
+			  * @param value
+			  */
+			 void set( size_type n, const_reference value )
+			 {
+			 	if( n >= size() ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	m_tree.set( n, value );
+			 }
+
+			 void set( size_type n, value_type && value )
+			 {
+			 	if( n >= size() ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	m_tree.set( n, std::move( value ) );
+			 }
+
+			 void pop_back( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("Can't pop out of an empty vector \n");	}
+			 	m_tree.pop_back();
+			 }
+
+//#############################  [V] Element access
+
+			 const_reference operator[]( size_type n ) const{	return m_tree[n];	}
+
+			 const_reference at( size_type n ) const
+			 {
+			 	if( n >= size() ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return m_tree[n];
+			 }
+	};
+};
+
+#endif
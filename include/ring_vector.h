@@ -0,0 +1,541 @@
+/**
+ * @file    ring_vector.h
+ * @brief   Sequencial container that keeps its elements in circular storage, starting at a head
+ *          index, so both push_front/pop_front and push_back/pop_back are amortized O(1).
+ *          Elements are reached by index; data() makes them contiguous on demand.
+ * @author  Bruna Hellen de Castro Dantas Barbosa
+ */
+
+#ifndef RING_VECTOR_H
+#define RING_VECTOR_H
+
+#include "vector.h"
+
+
+namespace sc
+{
+
+	/*
+	 * Random access iterator over a ring_vector: it keeps the logical index of the element and maps it
+	 * to the storage slot on each access.
+	 */
+	template < typename T >
+		class ring_iterator
+		{
+			public:
+
+				typedef std::ptrdiff_t difference_type;
+				typedef T& reference;
+				typedef typename std::remove_const< T >::type value_type;
+				typedef T* pointer;
+				typedef std::random_access_iterator_tag iterator_category;
+
+			private:
+				T * m_storage; //<! Storage of the ring.
+				std::size_t m_capacity; //<! Number of slots of the storage.
+				std::size_t m_head; //<! Slot of the first element.
+				std::size_t m_index; //<! Logical index of the element pointed.
+
+				template < typename U > friend class ring_iterator;
+
+			public:
+
+				ring_iterator( T * storage = nullptr, std::size_t capacity = 0, std::size_t head = 0, std::size_t index = 0 ):
+					m_storage(storage), m_capacity(capacity), m_head(head), m_index(index){ /* empty */ }
+
+				/**
+				 * @brief Converts an iterator into a const_iterator.
+				 *
+				 * @param other
+				 */
+				template < typename U, typename = typename std::enable_if< std::is_convertible< U *, T * >::value >::type >
+				ring_iterator( const ring_iterator< U > & other ):
+					m_storage(other.m_storage), m_capacity(other.m_capacity), m_head(other.m_head), m_index(other.m_index){ /* empty */ }
+
+				/*	Operators	*/
+
+				reference operator* ( ) const
+				{
+					std::size_t slot = m_head + m_index;
+					return m_storage[ slot >= m_capacity ? slot - m_capacity : slot ];
+				}
+
+				pointer operator ->( void ) const{	return &**this;	}
+
+				reference operator[] ( difference_type n ) const{	return *( *this + n );	}
+
+				ring_iterator & operator++( ){	++m_index;	return *this;	}
+				ring_iterator operator++( int ){	ring_iterator temp = *this;	++m_index;	return temp;	}
+				ring_iterator & operator--( ){	--m_index;	return *this;	}
+				ring_iterator operator--( int ){	ring_iterator temp = *this;	--m_index;	return temp;	}
+
+				ring_iterator & operator+=( difference_type n ){	m_index += n;	return *this;	}
+				ring_iterator & operator-=( difference_type n ){	m_index -= n;	return *this;	}
+
+				friend ring_iterator operator +( ring_iterator it, difference_type n ){	return it += n;	}
+				friend ring_iterator operator +( difference_type n, ring_iterator it ){	return it += n;	}
+				friend ring_iterator operator -( ring_iterator it, difference_type n ){	return it -= n;	}
+
+				difference_type operator-( const ring_iterator & rhs ) const{	return difference_type( m_index ) - difference_type( rhs.m_index );	}
+
+				bool operator== ( const ring_iterator & rhs ) const{	return m_index == rhs.m_index;	}
+				bool operator!= ( const ring_iterator & rhs ) const{	return m_index != rhs.m_index;	}
+				bool operator< ( const ring_iterator & rhs ) const{	return m_index < rhs.m_index;	}
+				bool operator> ( const ring_iterator & rhs ) const{	return m_index > rhs.m_index;	}
+				bool operator<= ( const ring_iterator & rhs ) const{	return m_index <= rhs.m_index;	}
+				bool operator>= ( const ring_iterator & rhs ) const{	return m_index >= rhs.m_index;	}
+		};
+
+	template < typename T, typename Allocator = std::allocator< T >, typename Growth = doubling_growth >
+	class ring_vector
+	{
+
+		public:
+
+			typedef Allocator allocator_type;
+			typedef std::allocator_traits< allocator_type > alloc_traits;
+			typedef Growth growth_policy;
+			typedef size_t size_type;
+			typedef T value_type;
+			typedef ring_iterator< T > Iterator;
+			typedef ring_iterator< const T > const_iterator;
+			typedef T& reference;
+			typedef const T& const_reference;
+			typedef T* pointer;
+
+			static_assert( std::is_same< typename alloc_traits::pointer, pointer >::value,
+					"sc::ring_vector needs an allocator that hands out raw pointers" );
+
+		private:
+			allocator_type m_alloc; //<! Allocator of the storage, also used to construct the elements.
+			size_type m_head; //<! Slot of the first element.
+			size_type m_end; //<! Current list size.
+			size_type m_capacity; //<! List's storage capacity.
+			pointer m_storage; //<! Circular storage of m_capacity slots.
+
+			// The elements live in [m_head, m_head + m_end) modulo m_capacity; the other slots are raw storage.
+
+			pointer allocate( size_type n ){	return alloc_traits::allocate( m_alloc, n );	}
+
+			void deallocate( pointer ptr, size_type n )
+			{
+				if( ptr != nullptr ){	alloc_traits::deallocate( m_alloc, ptr, n );	}
+			}
+
+			template < typename... Args >
+			void construct_at( pointer ptr, Args&&... args )
+			{
+				alloc_traits::construct( m_alloc, ptr, std::forward< Args >( args )... );
+			}
+
+			/**
+			 * @brief Returns the slot of the element at logical index i; i == size() addresses the raw slot
+			 * after the back.
+			 *
+			 * @param i
+			 * @return pointer
+			 */
+			pointer slot( size_type i ) const
+			{
+				size_type physical = m_head + i;
+				return m_storage + ( physical >= m_capacity ? physical - m_capacity : physical );
+			}
+
+			/**
+			 * @brief Number of elements stored from m_head up to the end of the storage, before wrapping.
+			 *
+			 * @return size_type
+			 */
+			size_type first_run( void ) const{	return std::min( m_end, m_capacity - m_head );	}
+
+			void destroy_all( void )
+			{
+				detail::destroy( m_alloc, m_storage + m_head, m_storage + m_head + first_run() );
+				detail::destroy( m_alloc, m_storage, m_storage + ( m_end - first_run() ) );
+			}
+
+			/**
+			 * @brief Moves every element, in order, to the start of the storage pointed by dest, with room
+			 * for n elements, which becomes the storage of the vector. The previous storage is released.
+			 *
+			 * @param dest
+			 * @param n
+			 */
+			void move_storage( pointer dest, size_type n )
+			{
+				const size_type run = first_run();
+				try
+				{
+					detail::relocate( m_alloc, m_storage + m_head, m_storage + m_head + run, dest );
+					try{	detail::relocate( m_alloc, m_storage, m_storage + ( m_end - run ), dest + run );	}
+					catch( ... ){	detail::destroy( m_alloc, dest, dest + run ); throw;	}
+				}
+				catch( ... ){	deallocate( dest, n ); throw;	}
+
+				destroy_all();
+				deallocate( m_storage, m_capacity );
+				m_storage = dest;
+				m_capacity = n;
+				m_head = 0;
+			}
+
+			/**
+			 * @brief Makes room for at least `required` elements, with the capacity chosen by the growth policy.
+			 *
+			 * @param required
+			 */
+			void grow( size_type required )
+			{
+				if( required > m_capacity ){	reserve( growth_policy::grow( m_capacity, required, sizeof( value_type ) ) );	}
+			}
+
+			/**
+			 * @brief Turns a wrapped ring into a contiguous one. Trivially copyable elements are rotated
+			 * in place, byte by byte; others are moved into a new storage of the same capacity.
+			 *
+			 */
+			void unwrap( std::true_type )
+			{
+				unsigned char * bytes = reinterpret_cast< unsigned char * >( m_storage );
+				std::rotate( bytes, bytes + m_head * sizeof( value_type ), bytes + m_capacity * sizeof( value_type ) );
+				m_head = 0;
+			}
+
+			void unwrap( std::false_type ){	move_storage( allocate( m_capacity ), m_capacity );	}
+
+			/**
+			 * @brief Releases the storage, leaving the vector empty with no capacity.
+			 *
+			 */
+			void reset( void )
+			{
+				destroy_all();
+				deallocate( m_storage, m_capacity );
+				m_head = m_end = m_capacity = 0;
+				m_storage = nullptr;
+			}
+
+			/**
+			 * @brief Takes over the storage of model, which is left empty.
+			 *
+			 * @param model
+			 */
+			void steal( ring_vector & model )
+			{
+				m_head = model.m_head;
+				m_end = model.m_end;
+				m_capacity = model.m_capacity;
+				m_storage = model.m_storage;
+
+				model.m_head = model.m_end = model.m_capacity = 0;
+				model.m_storage = nullptr;
+			}
+
+			template < typename InputItr >
+			void append( InputItr first, InputItr last ){	for( ; first != last; ++first ){	emplace_back( *first );	}	}
+
+		public:
+
+//############################# [I] SPECIAL MEMBERS
+
+			 ring_vector( ): m_alloc(), m_head(0), m_end(0), m_capacity(0), m_storage(nullptr){	/* Empty */	}
+
+			 explicit ring_vector( const allocator_type & alloc ): m_alloc(alloc), m_head(0), m_end(0), m_capacity(0), m_storage(nullptr){	/* Empty */	}
+
+			 /**
+			  * @brief Constructs a container with capacity for at least n elements.
+			  *
+			  * @param n
+			  * @param alloc
+			  */
+			 ring_vector( size_type n, const allocator_type & alloc = allocator_type() ): ring_vector(alloc){	reserve( n );	}
+
+			 template < typename InputItr, typename = detail::require_iterator< InputItr > >
+			 ring_vector( InputItr first, InputItr last, const allocator_type & alloc = allocator_type() ): ring_vector(alloc)
+			 {
+			 	append( first, last );
+			 }
+
+			 ring_vector( std::initializer_list< T > ilist, const allocator_type & alloc = allocator_type() ): ring_vector(alloc)
+			 {
+			 	reserve( ilist.size() );
+			 	append( ilist.begin(), ilist.end() );
+			 }
+
+			 /**
+			  * @brief Constructs a container with a copy of each of the elements in model, in the same order,
+			  * stored from the start of the new storage.
+			  *
+			  * @param model
+			  */
+			 ring_vector( const ring_vector & model ): ring_vector(alloc_traits::select_on_container_copy_construction(model.m_alloc))
+			 {
+			 	reserve( model.m_end );
+			 	append( model.cbegin(), model.cend() );
+			 }
+
+			 ring_vector( ring_vector && model ) noexcept: ring_vector(std::move(model.m_alloc)){	steal( model );	}
+
+			 ~ring_vector( ){	reset();	}
+
+			 ring_vector & operator= ( const ring_vector & model )
+			 {
+			 	if( this == &model ){	return *this;	}
+
+			 	if( alloc_traits::propagate_on_container_copy_assignment::value and m_alloc != model.m_alloc )
+			 	{
+			 		// The storage must be released by the allocator that made it.
+			 		reset();
+			 		detail::propagate_copy( m_alloc, model.m_alloc, typename alloc_traits::propagate_on_container_copy_assignment() );
+			 	}
+
+			 	clear();
+			 	reserve( model.m_end );
+			 	append( model.cbegin(), model.cend() );
+
+			 	return *this;
+			 }
+
+			 ring_vector & operator= ( ring_vector && model )
+			 	noexcept( alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value )
+			 {
+			 	if( this == &model ){	return *this;	}
+
+			 	if( alloc_traits::propagate_on_container_move_assignment::value or m_alloc == model.m_alloc )
+			 	{
+			 		reset();
+			 		detail::propagate_move( m_alloc, model.m_alloc, typename alloc_traits::propagate_on_container_move_assignment() );
+			 		steal( model );
+			 	}
+			 	else
+			 	{
+			 		// Storage from another allocator can't be taken over, the elements are moved one by one.
+			 		clear();
+			 		reserve( model.m_end );
+			 		append( std::make_move_iterator( model.begin() ), std::make_move_iterator( model.end() ) );
+			 		model.clear();
+			 	}
+
+			 	return *this;
+			 }
+
+			 allocator_type get_allocator( void ) const{	return m_alloc;	}
+
+//############################# [II] IteratorS
+
+			 Iterator begin( void ){	return Iterator( m_storage, m_capacity, m_head, 0 );	}
+			 Iterator end( void ){	return Iterator( m_storage, m_capacity, m_head, m_end );	}
+			 const_iterator begin( void ) const{	return cbegin();	}
+			 const_iterator end( void ) const{	return cend();	}
+			 const_iterator cbegin( void ) const{	return const_iterator( m_storage, m_capacity, m_head, 0 );	}
+			 const_iterator cend( void ) const{	return const_iterator( m_storage, m_capacity, m_head, m_end );	}
+
+//############################# [III] Capacity
+
+			 size_type size( void ) const{	return m_end;	}
+			 size_type capacity( void ) const{	return m_capacity;	}
+			 bool empty( void ) const{	return m_end == 0;	}
+
+			 /**
+			  * @brief Makes room for at least n_size elements. On reallocation the elements are stored from
+			  * the start of the new storage.
+			  *
+			  * @param n_size
+			  */
+			 void reserve( size_type n_size )
+			 {
+			 	if( n_size <= m_capacity ){	return;	}
+			 	move_storage( allocate( n_size ), n_size );
+			 }
+
+			 void shrink_to_fit( void )
+			 {
+			 	if( m_end == m_capacity ){	return;	}
+			 	if( m_end == 0 ){	reset(); return;	}
+			 	move_storage( allocate( m_end ), m_end );
+			 }
+
+//############################# [IV] Modifiers
+
+			 /**
+			  * @brief Destroys every element, keeping the storage.
+			  *
+			  */
+			 void clear( void )
+			 {
+			 	destroy_all();
+			 	m_head = m_end = 0;
+			 }
+
+			 /**
+			  * @brief Adds a new element at the end, constructed in place from args. Amortized O(1).
+			  *
+			  * @param args
+			  * @return reference to the new element
+			  */
+			 template < typename... Args >
+			 reference emplace_back( Args&&... args )
+			 {
+			 	if( m_end == m_capacity )
+			 	{
+			 		// Built before the elements move, since args may refer to one of them.
+			 		value_type temporary( std::forward< Args >( args )... );
+			 		grow( m_end + 1 );
+			 		construct_at( slot( m_end ), std::move( temporary ) );
+			 	}
+			 	else
+			 	{
+			 		construct_at( slot( m_end ), std::forward< Args >( args )... );
+			 	}
+			 	pointer dest = slot( m_end );
+			 	m_end++;
+
+			 	return *dest;
+			 }
+
+			 /**
+			  * @brief Adds a new element at the front, constructed in place from args. Amortized O(1): the
+			  * head moves one slot back, wrapping around the storage.
+			  *
+			  * @param args
+			  * @return reference to the new element
+			  */
+			 template < typename... Args >
+			 reference emplace_front( Args&&... args )
+			 {
+			 	if( m_end == m_capacity )
+			 	{
+			 		// Built before the elements move, since args may refer to one of them.
+			 		value_type temporary( std::forward< Args >( args )... );
+			 		grow( m_end + 1 );
+			 		construct_at( m_storage + m_capacity - 1, std::move( temporary ) );
+			 		m_head = m_capacity - 1;
+			 	}
+			 	else
+			 	{
+			 		const size_type head = ( m_head == 0 ? m_capacity : m_head ) - 1;
+			 		construct_at( m_storage + head, std::forward< Args >( args )... );
+			 		m_head = head;
+			 	}
+			 	m_end++;
+
+			 	return m_storage[m_head];
+			 }
+
+			 void push_back( const_reference ref ){	emplace_back( ref );	}
+			 void push_back( value_type && ref ){	emplace_back( std::move( ref ) );	}
+			 void push_front( const_reference ref ){	emplace_front( ref );	}
+			 void push_front( value_type && ref ){	emplace_front( std::move( ref ) );	}
+
+			 void pop_back( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("Can't pop out of an empty vector \n");}
+
+			 	m_end--;
+			 	alloc_traits::destroy( m_alloc, slot( m_end ) );
+			 }
+
+			 void pop_front( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("Can't pop out of an empty vector \n");}
+
+			 	alloc_traits::destroy( m_alloc, m_storage + m_head );
+			 	m_head = ( m_head + 1 == m_capacity ? 0 : m_head + 1 );
+			 	m_end--;
+			 }
+
+			 /**
+			  * @brief Returns true if the elements are contiguous in the storage, so linearize() is free.
+			  *
+			  * @return bool
+			  */
+			 bool is_linear( void ) const{	return m_head + m_end <= m_capacity;	}
+
+			 /**
+			  * @brief Makes the elements contiguous, in order, if they wrap around the storage.
+			  * O(n) when they do, free otherwise. Invalidates iterators.
+			  *
+			  * @return pointer to the first element
+			  */
+			 pointer linearize( void )
+			 {
+			 	if( not is_linear() ){	unwrap( detail::memcpyable< T >() );	}
+			 	return m_storage + m_head;
+			 }
+
+			 void swap( ring_vector & other ) noexcept
+			 {
+			 	detail::propagate_swap( m_alloc, other.m_alloc, typename alloc_traits::propagate_on_container_swap() );
+			 	std::swap( m_head, other.m_head );
+			 	std::swap( m_end, other.m_end );
+			 	std::swap( m_capacity, other.m_capacity );
+			 	std::swap( m_storage, other.m_storage );
+			 }
+
+			 friend void swap( ring_vector & first_, ring_vector & second_ ) noexcept{	first_.swap( second_ );	}
+
+//#############################  [V] Element access
+
+			 const_reference back( void ) const
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :( \n");}
+			 	return *slot( m_end - 1 );
+			 }
+
+			 reference back( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :( \n");}
+			 	return *slot( m_end - 1 );
+			 }
+
+			 const_reference front( void ) const
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :(\n");}
+			 	return m_storage[m_head];
+			 }
+
+			 reference front( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :(\n");}
+			 	return m_storage[m_head];
+			 }
+
+			 const_reference operator[]( size_type posi ) const{	return *slot( posi );	}
+
+			 reference operator[]( size_type n )
+			 {
+			 	if( n >= m_end ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return *slot( n );
+			 }
+
+			 const_reference at( size_type n ) const
+			 {
+			 	if( n >= m_end ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return *slot( n );
+			 }
+
+			 reference at( size_type n )
+			 {
+			 	if( n >= m_end ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return *slot( n );
+			 }
+
+			 /**
+			  * @brief Returns a pointer to the elements, linearizing them first (see linearize()).
+			  *
+			  * @return pointer
+			  */
+			 pointer data( void ){	return linearize();	}
+
+//############################# [VI] Operators
+
+			 bool operator== ( const ring_vector & test_v ) const
+			 {
+			 	return m_end == test_v.m_end and std::equal( cbegin(), cend(), test_v.cbegin() );
+			 }
+
+			 bool operator!= ( const ring_vector & test_v ) const{	return not ( *this == test_v );	}
+	};
+};
+
+#endif
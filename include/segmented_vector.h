@@ -0,0 +1,318 @@
+/**
+ * @file    segmented_vector.h
+ * @brief   Sequencial container made of fixed-size chunks plus a table of chunk pointers: growing adds a
+ *          chunk and never moves the elements already stored, so references stay valid across push_back
+ *          and a huge vector never needs its old and new buffers at once. Indexing is a shift and a mask.
+ * @author  Bruna Hellen de Castro Dantas Barbosa
+ */
+
+#ifndef SEGMENTED_VECTOR_H
+#define SEGMENTED_VECTOR_H
+
+#include "vector.h"
+#include "index_iterator.h" // sc::detail::index_iterator
+
+
+namespace sc
+{
+
+	namespace detail
+	{
+		/// Index of the highest bit set in x, at compile time; 0 for x = 0.
+		constexpr std::size_t static_log2( std::size_t x ){	return x <= 1 ? 0 : 1 + static_log2( x >> 1 );	}
+	}
+
+	/**
+	 * @brief Vector of chunks.
+	 *
+	 * @tparam T Element type.
+	 * @tparam ChunkBytes Size of a chunk: each one holds the largest power of two of elements that fits in it
+	 * (at least one). The default 64 KiB stays below the mmap threshold of common mallocs, so chunks are
+	 * recycled by the heap instead of being mapped and unmapped one by one.
+	 * @tparam Allocator Allocator of the chunks and of the chunk table.
+	 *
+	 * Iterators stay valid across push_back too, they keep an index. Chunks left empty by pop_back and clear
+	 * are kept for the next elements, like the capacity of a vector, until shrink_to_fit.
+	 */
+	template < typename T, std::size_t ChunkBytes = ( 64 << 10 ), typename Allocator = std::allocator< T > >
+	class segmented_vector
+	{
+
+		public:
+
+			typedef Allocator allocator_type;
+			typedef size_t size_type;
+			typedef T value_type;
+			typedef detail::index_iterator< segmented_vector, T > Iterator;
+			typedef detail::index_iterator< const segmented_vector, const T > const_iterator;
+			typedef T& reference;
+			typedef const T& const_reference;
+			typedef T* pointer;
+
+			static const size_type chunk_shift = detail::static_log2( ChunkBytes / sizeof( T ) ); //<! log2 of the elements per chunk.
+			static const size_type chunk_size = size_type( 1 ) << chunk_shift; //<! Elements per chunk.
+			static const size_type chunk_mask = chunk_size - 1;
+
+		private:
+			typedef std::allocator_traits< allocator_type > alloc_traits;
+			typedef sc::vector< pointer, typename alloc_traits::template rebind_alloc< pointer > > chunk_table;
+
+			template < typename C, typename U > friend class detail::index_iterator;
+
+			allocator_type m_alloc; //<! Allocator of the chunks, also used to construct the elements.
+			size_type m_end; //<! Number of elements.
+			chunk_table m_chunks; //<! Chunk k holds the elements [k * chunk_size, (k + 1) * chunk_size).
+
+			pointer slot( size_type index ) const{	return m_chunks[ index >> chunk_shift ] + ( index & chunk_mask );	}
+
+			/// Appends an empty chunk to the table.
+			void add_chunk( void )
+			{
+				pointer chunk = alloc_traits::allocate( m_alloc, chunk_size );
+				try{	m_chunks.push_back( chunk );	}
+				catch( ... ){	alloc_traits::deallocate( m_alloc, chunk, chunk_size ); throw;	}
+			}
+
+			/// Releases the chunks from index k on, which must hold no element.
+			void drop_chunks( size_type k )
+			{
+				for( size_type i = k; i < m_chunks.size(); ++i ){	alloc_traits::deallocate( m_alloc, m_chunks[i], chunk_size );	}
+				while( m_chunks.size() > k ){	m_chunks.pop_back();	}
+			}
+
+		public:
+
+//############################# [I] SPECIAL MEMBERS
+
+			 /**
+			  * @brief Constructs an empty container, no chunk is allocated until the first push_back.
+			  *
+			  * @param alloc
+			  */
+			 explicit segmented_vector( const allocator_type & alloc = allocator_type() ): m_alloc(alloc), m_end(0), m_chunks(alloc){	/* Empty */	}
+
+			 template < typename InputItr, typename = detail::require_iterator< InputItr > >
+			 segmented_vector( InputItr first, InputItr last, const allocator_type & alloc = allocator_type() ): segmented_vector( alloc )
+			 {
+			 	for( ; first != last; ++first ){	emplace_back( *first );	}
+			 }
+
+			 segmented_vector( std::initializer_list< T > ilist, const allocator_type & alloc = allocator_type() ): segmented_vector( ilist.begin(), ilist.end(), alloc ){	/* Empty */	}
+
+			 segmented_vector( const segmented_vector & model ):
+			 	segmented_vector( alloc_traits::select_on_container_copy_construction( model.m_alloc ) )
+			 {
+			 	reserve( model.m_end );
+			 	model.for_each_segment( [this]( const T * first, const T * last ){	for( ; first != last; ++first ){	emplace_back( *first );	}	} );
+			 }
+
+			 segmented_vector( segmented_vector && model ) noexcept: m_alloc(std::move(model.m_alloc)), m_end(model.m_end), m_chunks(std::move(model.m_chunks))
+			 {
+			 	model.m_end = 0;
+			 }
+
+			 /**
+			  * @brief Copy-and-swap assignment; the allocators are swapped along, so they must be equal or
+			  * propagate on swap.
+			  *
+			  * @param model
+			  * @return segmented_vector&
+			  */
+			 segmented_vector & operator= ( segmented_vector model ) noexcept
+			 {
+			 	swap( model );
+			 	return *this;
+			 }
+
+			 ~segmented_vector( )
+			 {
+			 	clear();
+			 	drop_chunks( 0 );
+			 }
+
+			 void swap( segmented_vector & other ) noexcept
+			 {
+			 	using std::swap;
+			 	swap( m_alloc, other.m_alloc );
+			 	swap( m_end, other.m_end );
+			 	m_chunks.swap( other.m_chunks );
+			 }
+
+//############################# [II] IteratorS
+
+			 Iterator begin( void ){	return Iterator( this, 0 );	}
+			 Iterator end( void ){	return Iterator( this, m_end );	}
+			 const_iterator begin( void ) const{	return cbegin();	}
+			 const_iterator end( void ) const{	return cend();	}
+			 const_iterator cbegin( void ) const{	return const_iterator( this, 0 );	}
+			 const_iterator cend( void ) const{	return const_iterator( this, m_end );	}
+
+			 /**
+			  * @brief Calls f( first, last ) on the contiguous run of elements of every chunk, in order, so the
+			  * inner loops can be vectorized.
+			  *
+			  * @param f
+			  */
+			 template < typename Function >
+			 void for_each_segment( Function f )
+			 {
+			 	for( size_type begin = 0, k = 0; begin < m_end; begin += chunk_size, ++k ){	f( m_chunks[k], m_chunks[k] + std::min( chunk_size, m_end - begin ) );	}
+			 }
+
+			 template < typename Function >
+			 void for_each_segment( Function f ) const
+			 {
+			 	for( size_type begin = 0, k = 0; begin < m_end; begin += chunk_size, ++k )
+			 	{
+			 		const T * first = m_chunks[k];
+			 		f( first, first + std::min( chunk_size, m_end - begin ) );
+			 	}
+			 }
+
+//############################# [III] Capacity
+
+			 size_type size( void ) const{	return m_end;	}
+			 bool empty( void ) const{	return m_end == 0;	}
+			 size_type capacity( void ) const{	return m_chunks.size() * chunk_size;	}
+
+			 /**
+			  * @brief Allocates the chunks of the first n_size elements, so pushing them allocates nothing.
+			  *
+			  * @param n_size
+			  */
+			 void reserve( size_type n_size )
+			 {
+			 	const size_type chunks = ( n_size + chunk_mask ) >> chunk_shift;
+			 	if( chunks <= m_chunks.size() ){	return;	}
+
+			 	m_chunks.reserve( chunks );
+			 	while( m_chunks.size() < chunks ){	add_chunk();	}
+			 }
+
+			 /**
+			  * @brief Releases the chunks holding no element.
+			  *
+			  */
+			 void shrink_to_fit( void )
+			 {
+			 	drop_chunks( ( m_end + chunk_mask ) >> chunk_shift );
+			 	m_chunks.shrink_to_fit();
+			 }
+
+			 allocator_type get_allocator( void ) const{	return m_alloc;	}
+
+//############################# [IV] Modifiers
+
+			 /**
+			  * @brief Appends an element constructed from args, adding a chunk when the last one is full. No
+			  * element is moved. If it throws, the elements are unchanged.
+			  *
+			  * @param args
+			  * @return Reference to the new element.
+			  */
+			 template < typename... Args >
+			 reference emplace_back( Args&&... args )
+			 {
+			 	if( m_end == capacity() ){	add_chunk();	}
+
+			 	pointer target = slot( m_end );
+			 	alloc_traits::construct( m_alloc, target, std::forward< Args >( args )... );
+			 	++m_end;
+			 	return *target;
+			 }
+
+			 void push_back( const_reference value ){	emplace_back( value );	}
+			 void push_back( value_type && value ){	emplace_back( std::move( value ) );	}
+
+			 void pop_back( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("Can't pop out of an empty vector \n");}
+			 	--m_end;
+			 	alloc_traits::destroy( m_alloc, slot( m_end ) );
+			 }
+
+			 /**
+			  * @brief Destroys the elements, keeping the chunks.
+			  *
+			  */
+			 void clear( void )
+			 {
+			 	allocator_type & alloc = m_alloc;
+			 	for_each_segment( [&alloc]( pointer first, pointer last ){	detail::destroy( alloc, first, last );	} );
+			 	m_end = 0;
+			 }
+
+//#############################  [V] Element access
+
+			 const_reference operator[]( size_type n ) const{	return *slot( n );	}
+			 reference operator[]( size_type n ){	return *slot( n );	}
+
+			 const_reference at( size_type n ) const
+			 {
+			 	if( n >= m_end ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return *slot( n );
+			 }
+
+			 reference at( size_type n )
+			 {
+			 	if( n >= m_end ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return *slot( n );
+			 }
+
+			 reference front( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :(\n");}
+			 	return *slot( 0 );
+			 }
+
+			 const_reference front( void ) const
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :(\n");}
+			 	return *slot( 0 );
+			 }
+
+			 reference back( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :( \n");}
+			 	return *slot( m_end - 1 );
+			 }
+
+			 const_reference back( void ) const
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :( \n");}
+			 	return *slot( m_end - 1 );
+			 }
+
+			 /**
+			  * @brief Copies the elements into a contiguous sc::vector, one chunk at a time.
+			  *
+			  * @return sc::vector< value_type >
+			  */
+			 sc::vector< value_type > flatten( void ) const
+			 {
+			 	sc::vector< value_type > flat( m_end );
+			 	for_each_segment( [&flat]( const T * first, const T * last ){	flat.insert( flat.end(), first, last );	} );
+			 	return flat;
+			 }
+
+//############################# [VI] Operators
+
+			 friend bool operator== ( const segmented_vector & lhs, const segmented_vector & rhs )
+			 {
+			 	return lhs.size() == rhs.size() and std::equal( lhs.begin(), lhs.end(), rhs.begin() );
+			 }
+
+			 friend bool operator!= ( const segmented_vector & lhs, const segmented_vector & rhs ){	return not ( lhs == rhs );	}
+	};
+
+	template < typename T, std::size_t ChunkBytes, typename Allocator >
+	const typename segmented_vector< T, ChunkBytes, Allocator >::size_type segmented_vector< T, ChunkBytes, Allocator >::chunk_shift;
+
+	template < typename T, std::size_t ChunkBytes, typename Allocator >
+	const typename segmented_vector< T, ChunkBytes, Allocator >::size_type segmented_vector< T, ChunkBytes, Allocator >::chunk_size;
+
+	template < typename T, std::size_t ChunkBytes, typename Allocator >
+	const typename segmented_vector< T, ChunkBytes, Allocator >::size_type segmented_vector< T, ChunkBytes, Allocator >::chunk_mask;
+};
+
+#endif
@@ -0,0 +1,396 @@
+/**
+ * @file    simd.h
+ * @brief   Vectorized comparison kernels (mismatch, find, count, lexicographic less) over arrays of
+ *          arithmetic types, used by sc::vector, and the bit count of sc::vector< bool >. On x86 they run
+ *          on AVX2 when the CPU has it and on SSE2 otherwise, picked at runtime; other element types and
+ *          targets use scalar loops. Define SC_NO_SIMD (cmake -D VECTOR_SIMD=OFF) to always use the scalar
+ *          loops.
+ * @author  Bruna Hellen de Castro Dantas Barbosa
+ */
+
+#ifndef SC_SIMD_H
+#define SC_SIMD_H
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <type_traits> // std::is_arithmetic, std::integral_constant
+
+#if !defined( SC_NO_SIMD ) && defined( __GNUC__ ) && defined( __SSE2__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#	include <immintrin.h> // SSE2 and AVX2 intrinsics
+#	define SC_SIMD_X86 1
+#endif
+
+
+namespace sc
+{
+
+	namespace simd
+	{
+		/*
+		 * Element types the kernels handle: integers (the comparisons are bitwise) and float/double (the
+		 * comparisons are IEEE ones, so NaN never matches and -0.0 matches 0.0, as with operator==).
+		 */
+		template < typename T >
+		struct enabled : std::integral_constant< bool, std::is_arithmetic< T >::value and not std::is_same< T, bool >::value and
+			( std::is_integral< T >::value ? ( sizeof( T ) <= 8 ) : ( sizeof( T ) == 4 or sizeof( T ) == 8 ) ) >{};
+
+		namespace scalar
+		{
+			template < typename T >
+			std::size_t mismatch( const T * a, const T * b, std::size_t n )
+			{
+				std::size_t i = 0;
+				for( ; i != n and a[i] == b[i]; ++i );
+				return i;
+			}
+
+			template < typename T >
+			std::size_t find( const T * a, std::size_t n, const T & value )
+			{
+				std::size_t i = 0;
+				for( ; i != n and not ( a[i] == value ); ++i );
+				return i;
+			}
+
+			template < typename T >
+			std::size_t count( const T * a, std::size_t n, const T & value )
+			{
+				std::size_t total = 0;
+				for( std::size_t i = 0; i != n; ++i ){	total += ( a[i] == value );	}
+				return total;
+			}
+		}
+
+#ifdef SC_SIMD_X86
+		// Lane kinds: integers by size (the bytes are compared), float and double.
+		template < typename T >
+		struct lane : std::integral_constant< int, std::is_floating_point< T >::value ? -int( sizeof( T ) ) : int( sizeof( T ) ) >{};
+
+		/*
+		 * The kernels compare one register of elements at a time and turn the result into a mask with one bit
+		 * per byte, set for the bytes of the lanes that compare equal. A block that doesn't answer the question
+		 * by itself (the first mismatch, the first match) is finished by the scalar loop.
+		 */
+		namespace sse2
+		{
+			static const unsigned all = 0xFFFF;
+
+			inline __m128i load( const void * ptr ){	return _mm_loadu_si128( static_cast< const __m128i * >( ptr ) );	}
+
+			inline unsigned eq_mask( const void * a, const void * b, std::integral_constant< int, 1 > )
+			{
+				return _mm_movemask_epi8( _mm_cmpeq_epi8( load( a ), load( b ) ) );
+			}
+			inline unsigned eq_mask( const void * a, const void * b, std::integral_constant< int, 2 > )
+			{
+				return _mm_movemask_epi8( _mm_cmpeq_epi16( load( a ), load( b ) ) );
+			}
+			inline unsigned eq_mask( const void * a, const void * b, std::integral_constant< int, 4 > )
+			{
+				return _mm_movemask_epi8( _mm_cmpeq_epi32( load( a ), load( b ) ) );
+			}
+			inline unsigned eq_mask( const void * a, const void * b, std::integral_constant< int, 8 > )
+			{
+				// SSE2 has no 64 bit compare: both 32 bit halves have to match.
+				__m128i eq = _mm_cmpeq_epi32( load( a ), load( b ) );
+				return _mm_movemask_epi8( _mm_and_si128( eq, _mm_shuffle_epi32( eq, _MM_SHUFFLE( 2, 3, 0, 1 ) ) ) );
+			}
+			inline unsigned eq_mask( const void * a, const void * b, std::integral_constant< int, -4 > )
+			{
+				__m128 eq = _mm_cmpeq_ps( _mm_loadu_ps( static_cast< const float * >( a ) ), _mm_loadu_ps( static_cast< const float * >( b ) ) );
+				return _mm_movemask_epi8( _mm_castps_si128( eq ) );
+			}
+			inline unsigned eq_mask( const void * a, const void * b, std::integral_constant< int, -8 > )
+			{
+				__m128d eq = _mm_cmpeq_pd( _mm_loadu_pd( static_cast< const double * >( a ) ), _mm_loadu_pd( static_cast< const double * >( b ) ) );
+				return _mm_movemask_epi8( _mm_castpd_si128( eq ) );
+			}
+
+			template < typename T >
+			std::size_t mismatch( const T * a, const T * b, std::size_t n )
+			{
+				const std::size_t step = 16 / sizeof( T );
+				std::size_t i = 0;
+
+				// Four registers per iteration, then one at a time.
+				for( ; i + 4 * step <= n; i += 4 * step )
+				{
+					if( ( eq_mask( a + i, b + i, lane< T >() ) & eq_mask( a + i + step, b + i + step, lane< T >() ) &
+					      eq_mask( a + i + 2 * step, b + i + 2 * step, lane< T >() ) & eq_mask( a + i + 3 * step, b + i + 3 * step, lane< T >() ) ) != all ){	break;	}
+				}
+				for( ; i + step <= n and eq_mask( a + i, b + i, lane< T >() ) == all; i += step );
+
+				return i + scalar::mismatch( a + i, b + i, n - i );
+			}
+
+			template < typename T >
+			std::size_t find( const T * a, std::size_t n, const T & value )
+			{
+				const std::size_t step = 16 / sizeof( T );
+				T splat[16 / sizeof( T )];
+				for( std::size_t k = 0; k != step; ++k ){	splat[k] = value;	}
+
+				std::size_t i = 0;
+				for( ; i + step <= n and eq_mask( a + i, splat, lane< T >() ) == 0; i += step );
+
+				return i + scalar::find( a + i, n - i, value );
+			}
+
+			template < typename T >
+			std::size_t count( const T * a, std::size_t n, const T & value )
+			{
+				const std::size_t step = 16 / sizeof( T );
+				T splat[16 / sizeof( T )];
+				for( std::size_t k = 0; k != step; ++k ){	splat[k] = value;	}
+
+				std::size_t bits = 0, i = 0;
+				for( ; i + step <= n; i += step ){	bits += __builtin_popcount( eq_mask( a + i, splat, lane< T >() ) );	}
+
+				return bits / sizeof( T ) + scalar::count( a + i, n - i, value );
+			}
+		}
+
+#	define SC_AVX2 __attribute__(( target( "avx2" ) ))
+
+		namespace avx2
+		{
+			static const unsigned all = 0xFFFFFFFF;
+
+			SC_AVX2 inline __m256i load( const void * ptr ){	return _mm256_loadu_si256( static_cast< const __m256i * >( ptr ) );	}
+
+			SC_AVX2 inline unsigned eq_mask( const void * a, const void * b, std::integral_constant< int, 1 > )
+			{
+				return _mm256_movemask_epi8( _mm256_cmpeq_epi8( load( a ), load( b ) ) );
+			}
+			SC_AVX2 inline unsigned eq_mask( const void * a, const void * b, std::integral_constant< int, 2 > )
+			{
+				return _mm256_movemask_epi8( _mm256_cmpeq_epi16( load( a ), load( b ) ) );
+			}
+			SC_AVX2 inline unsigned eq_mask( const void * a, const void * b, std::integral_constant< int, 4 > )
+			{
+				return _mm256_movemask_epi8( _mm256_cmpeq_epi32( load( a ), load( b ) ) );
+			}
+			SC_AVX2 inline unsigned eq_mask( const void * a, const void * b, std::integral_constant< int, 8 > )
+			{
+				return _mm256_movemask_epi8( _mm256_cmpeq_epi64( load( a ), load( b ) ) );
+			}
+			SC_AVX2 inline unsigned eq_mask( const void * a, const void * b, std::integral_constant< int, -4 > )
+			{
+				__m256 eq = _mm256_cmp_ps( _mm256_loadu_ps( static_cast< const float * >( a ) ), _mm256_loadu_ps( static_cast< const float * >( b ) ), _CMP_EQ_OQ );
+				return _mm256_movemask_epi8( _mm256_castps_si256( eq ) );
+			}
+			SC_AVX2 inline unsigned eq_mask( const void * a, const void * b, std::integral_constant< int, -8 > )
+			{
+				__m256d eq = _mm256_cmp_pd( _mm256_loadu_pd( static_cast< const double * >( a ) ), _mm256_loadu_pd( static_cast< const double * >( b ) ), _CMP_EQ_OQ );
+				return _mm256_movemask_epi8( _mm256_castpd_si256( eq ) );
+			}
+
+			template < typename T >
+			SC_AVX2 std::size_t mismatch( const T * a, const T * b, std::size_t n )
+			{
+				const std::size_t step = 32 / sizeof( T );
+				std::size_t i = 0;
+
+				// Four registers per iteration, then one at a time.
+				for( ; i + 4 * step <= n; i += 4 * step )
+				{
+					if( ( eq_mask( a + i, b + i, lane< T >() ) & eq_mask( a + i + step, b + i + step, lane< T >() ) &
+					      eq_mask( a + i + 2 * step, b + i + 2 * step, lane< T >() ) & eq_mask( a + i + 3 * step, b + i + 3 * step, lane< T >() ) ) != all ){	break;	}
+				}
+				for( ; i + step <= n and eq_mask( a + i, b + i, lane< T >() ) == all; i += step );
+
+				return i + scalar::mismatch( a + i, b + i, n - i );
+			}
+
+			template < typename T >
+			SC_AVX2 std::size_t find( const T * a, std::size_t n, const T & value )
+			{
+				const std::size_t step = 32 / sizeof( T );
+				T splat[32 / sizeof( T )];
+				for( std::size_t k = 0; k != step; ++k ){	splat[k] = value;	}
+
+				std::size_t i = 0;
+				for( ; i + step <= n and eq_mask( a + i, splat, lane< T >() ) == 0; i += step );
+
+				return i + scalar::find( a + i, n - i, value );
+			}
+
+			template < typename T >
+			SC_AVX2 std::size_t count( const T * a, std::size_t n, const T & value )
+			{
+				const std::size_t step = 32 / sizeof( T );
+				T splat[32 / sizeof( T )];
+				for( std::size_t k = 0; k != step; ++k ){	splat[k] = value;	}
+
+				std::size_t bits = 0, i = 0;
+				for( ; i + step <= n; i += step ){	bits += __builtin_popcount( eq_mask( a + i, splat, lane< T >() ) );	}
+
+				return bits / sizeof( T ) + scalar::count( a + i, n - i, value );
+			}
+		}
+
+#	undef SC_AVX2
+
+		/**
+		 * @brief Returns true if the CPU running the program has AVX2, checked once.
+		 *
+		 * @return bool
+		 */
+		inline bool has_avx2( void )
+		{
+			static const bool supported = ( __builtin_cpu_init(), __builtin_cpu_supports( "avx2" ) );
+			return supported;
+		}
+
+		template < typename T >
+		std::size_t mismatch( const T * a, const T * b, std::size_t n, std::true_type )
+		{
+			return has_avx2() ? avx2::mismatch( a, b, n ) : sse2::mismatch( a, b, n );
+		}
+
+		template < typename T >
+		std::size_t find( const T * a, std::size_t n, const T & value, std::true_type )
+		{
+			return has_avx2() ? avx2::find( a, n, value ) : sse2::find( a, n, value );
+		}
+
+		template < typename T >
+		std::size_t count( const T * a, std::size_t n, const T & value, std::true_type )
+		{
+			return has_avx2() ? avx2::count( a, n, value ) : sse2::count( a, n, value );
+		}
+#else
+		template < typename T >
+		std::size_t mismatch( const T * a, const T * b, std::size_t n, std::true_type ){	return scalar::mismatch( a, b, n );	}
+
+		template < typename T >
+		std::size_t find( const T * a, std::size_t n, const T & value, std::true_type ){	return scalar::find( a, n, value );	}
+
+		template < typename T >
+		std::size_t count( const T * a, std::size_t n, const T & value, std::true_type ){	return scalar::count( a, n, value );	}
+#endif
+
+		template < typename T >
+		std::size_t mismatch( const T * a, const T * b, std::size_t n, std::false_type ){	return scalar::mismatch( a, b, n );	}
+
+		template < typename T >
+		std::size_t find( const T * a, std::size_t n, const T & value, std::false_type ){	return scalar::find( a, n, value );	}
+
+		template < typename T >
+		std::size_t count( const T * a, std::size_t n, const T & value, std::false_type ){	return scalar::count( a, n, value );	}
+
+		/**
+		 * @brief Returns the index of the first i for which a[i] == b[i] is false, or n if there is none.
+		 *
+		 * @param a
+		 * @param b
+		 * @param n
+		 * @return std::size_t
+		 */
+		template < typename T >
+		std::size_t mismatch( const T * a, const T * b, std::size_t n ){	return simd::mismatch( a, b, n, enabled< T >() );	}
+
+		/**
+		 * @brief Returns the index of the first element equal to value, or n if there is none.
+		 *
+		 * @param a
+		 * @param n
+		 * @param value
+		 * @return std::size_t
+		 */
+		template < typename T >
+		std::size_t find( const T * a, std::size_t n, const T & value ){	return simd::find( a, n, value, enabled< T >() );	}
+
+		/**
+		 * @brief Returns how many elements are equal to value.
+		 *
+		 * @param a
+		 * @param n
+		 * @param value
+		 * @return std::size_t
+		 */
+		template < typename T >
+		std::size_t count( const T * a, std::size_t n, const T & value ){	return simd::count( a, n, value, enabled< T >() );	}
+
+		/**
+		 * @brief Lexicographic a < b, as std::lexicographical_compare, skipping the equal prefix with mismatch().
+		 *
+		 * @param a
+		 * @param n size of a
+		 * @param b
+		 * @param m size of b
+		 * @return bool
+		 */
+		template < typename T >
+		bool less( const T * a, std::size_t n, const T * b, std::size_t m )
+		{
+			const std::size_t common = n < m ? n : m;
+
+			for( std::size_t i = 0; ; ++i )
+			{
+				i += simd::mismatch( a + i, b + i, common - i );
+				if( i == common ){	return n < m;	}
+				if( a[i] < b[i] ){	return true;	}
+				if( b[i] < a[i] ){	return false;	}
+				// Unordered (NaN): neither is less, the comparison goes on.
+			}
+		}
+
+		/*
+		 * Bit counting over the words of sc::vector< bool >. POPCNT isn't part of the x86-64 baseline, so
+		 * like AVX2 it is picked at runtime; elsewhere the builtin (or a SWAR count) does the work.
+		 */
+		namespace scalar
+		{
+			inline std::size_t popcount( std::uint64_t word )
+			{
+#if defined( __GNUC__ )
+				return __builtin_popcountll( word );
+#else
+				word -= ( word >> 1 ) & 0x5555555555555555ULL;
+				word = ( word & 0x3333333333333333ULL ) + ( ( word >> 2 ) & 0x3333333333333333ULL );
+				word = ( word + ( word >> 4 ) ) & 0x0F0F0F0F0F0F0F0FULL;
+				return ( word * 0x0101010101010101ULL ) >> 56;
+#endif
+			}
+
+			inline std::size_t popcount( const std::uint64_t * words, std::size_t n )
+			{
+				std::size_t total = 0;
+				for( std::size_t i = 0; i != n; ++i ){	total += popcount( words[i] );	}
+				return total;
+			}
+		}
+
+#ifdef SC_SIMD_X86
+		namespace popcnt
+		{
+			__attribute__(( target( "popcnt" ) )) inline std::size_t popcount( const std::uint64_t * words, std::size_t n )
+			{
+				std::size_t total = 0;
+				for( std::size_t i = 0; i != n; ++i ){	total += __builtin_popcountll( words[i] );	}
+				return total;
+			}
+		}
+
+		inline bool has_popcnt( void )
+		{
+			static const bool supported = ( __builtin_cpu_init(), __builtin_cpu_supports( "popcnt" ) );
+			return supported;
+		}
+
+		/**
+		 * @brief Returns the number of bits set in the n words.
+		 *
+		 * @param words
+		 * @param n
+		 * @return std::size_t
+		 */
+		inline std::size_t popcount( const std::uint64_t * words, std::size_t n ){	return has_popcnt() ? popcnt::popcount( words, n ) : scalar::popcount( words, n );	}
+#else
+		inline std::size_t popcount( const std::uint64_t * words, std::size_t n ){	return scalar::popcount( words, n );	}
+#endif
+	}
+};
+
+#endif
@@ -0,0 +1,639 @@
+/**
+ * @file    small_vector.h
+ * @brief   Sequencial container with the interface of sc::vector that keeps up to N elements
+ *          inside the object itself, and only goes to the heap when it grows past N.
+ * @author  Bruna Hellen de Castro Dantas Barbosa
+ */
+
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include "vector.h"
+
+
+namespace sc
+{
+
+	template < typename T, std::size_t N, typename Allocator = std::allocator< T >, typename Growth = doubling_growth >
+	class small_vector
+	{
+
+		public:
+
+			typedef Allocator allocator_type;
+			typedef std::allocator_traits< allocator_type > alloc_traits;
+			typedef Growth growth_policy;
+			typedef size_t size_type;
+			typedef T value_type;
+			typedef MyIterator< T > Iterator;
+			typedef MyIterator< const T > const_iterator;
+			typedef T& reference;
+			typedef const T& const_reference;
+			typedef T* pointer;
+
+			static_assert( N > 0, "sc::small_vector needs room for at least one inline element" );
+			static_assert( std::is_same< typename alloc_traits::pointer, pointer >::value,
+					"sc::small_vector needs an allocator that hands out raw pointers" );
+
+		private:
+			allocator_type m_alloc; //<! Allocator of the heap storage, also used to construct the elements.
+			size_type m_end; //<! Current list size (or index past-last valid element).
+			size_type m_capacity; //<! List's storage capacity, N while the elements are inline.
+			pointer m_storage; //<! Either m_inline or a heap block of m_capacity elements.
+			typename std::aligned_storage< sizeof( T ), alignof( T ) >::type m_inline[N]; //<! Inline storage.
+
+			// Only the slots in [0, m_end) hold constructed objects.
+
+			/**
+			 * @brief Returns the address of the inline storage.
+			 *
+			 * @return pointer
+			 */
+			pointer inline_storage( void ){	return reinterpret_cast< pointer >( m_inline );	}
+
+			/**
+			 * @brief Allocates heap storage for n elements, none of them is constructed.
+			 *
+			 * @param n
+			 * @return pointer
+			 */
+			pointer allocate( size_type n ){	return alloc_traits::allocate( m_alloc, n );	}
+
+			/**
+			 * @brief Releases the storage of n elements pointed by ptr, unless it is the inline storage.
+			 *
+			 * @param ptr
+			 * @param n
+			 */
+			void deallocate( pointer ptr, size_type n )
+			{
+				if( ptr != inline_storage() ){	alloc_traits::deallocate( m_alloc, ptr, n );	}
+			}
+
+			template < typename... Args >
+			void construct_at( pointer ptr, Args&&... args )
+			{
+				alloc_traits::construct( m_alloc, ptr, std::forward< Args >( args )... );
+			}
+
+			void destroy( pointer first, pointer last ){	detail::destroy( m_alloc, first, last );	}
+
+			/**
+			 * @brief Moves every element to the storage pointed by dest, with room for n elements, which
+			 * becomes the storage of the vector. The previous storage is released.
+			 *
+			 * @param dest
+			 * @param n
+			 */
+			void move_storage( pointer dest, size_type n )
+			{
+				try{	detail::relocate( m_alloc, m_storage, m_storage + m_end, dest );	}
+				catch( ... ){	deallocate( dest, n ); throw;	}
+
+				destroy( m_storage, m_storage + m_end );
+				deallocate( m_storage, m_capacity );
+				m_storage = dest;
+				m_capacity = n;
+			}
+
+			/**
+			 * @brief Makes room for at least `required` elements, with the capacity chosen by the growth policy.
+			 *
+			 * @param required
+			 */
+			void grow( size_type required )
+			{
+				if( required > m_capacity ){	reserve( growth_policy::grow( m_capacity, required, sizeof( value_type ) ) );	}
+			}
+
+			/**
+			 * @brief Returns the index of the element pointed by position.
+			 *
+			 * @param position
+			 * @return size_type
+			 */
+			size_type index_of( const_iterator position ) const{	return position - cbegin();	}
+
+			/**
+			 * @brief Leaves the vector empty, back on its inline storage, releasing the heap block if any.
+			 *
+			 */
+			void reset( void )
+			{
+				destroy( m_storage, m_storage + m_end );
+				deallocate( m_storage, m_capacity );
+				m_end = 0;
+				m_capacity = N;
+				m_storage = inline_storage();
+			}
+
+			/**
+			 * @brief Takes over the elements of model: its heap block when it has one and the allocators allow
+			 * it, otherwise the elements are moved one by one. model is left empty.
+			 *
+			 * @param model
+			 * @param steal whether the heap block of model may be taken over
+			 */
+			void take( small_vector & model, bool steal )
+			{
+				if( model.is_inline() or not steal )
+				{
+					assign( std::make_move_iterator( model.m_storage ), std::make_move_iterator( model.m_storage + model.m_end ) );
+					model.clear();
+				}
+				else
+				{
+					reset();
+					m_end = model.m_end;
+					m_capacity = model.m_capacity;
+					m_storage = model.m_storage;
+
+					model.m_end = 0;
+					model.m_capacity = N;
+					model.m_storage = model.inline_storage();
+				}
+			}
+
+		public:
+
+//############################# [I] SPECIAL MEMBERS
+
+			 /**
+			  * @brief Constructs an empty container, on its inline storage.
+			  *
+			  */
+			 small_vector( ): m_alloc(), m_end(0), m_capacity(N), m_storage(inline_storage()){	/* Empty */	}
+
+			 /**
+			  * @brief Constructs an empty container, on its inline storage, that allocates through alloc.
+			  *
+			  * @param alloc
+			  */
+			 explicit small_vector( const allocator_type & alloc ): m_alloc(alloc), m_end(0), m_capacity(N), m_storage(inline_storage()){	/* Empty */	}
+
+			 /**
+			  * @brief Constructs a container with capacity for at least n elements.
+			  *
+			  * @param n
+			  * @param alloc
+			  */
+			 small_vector( size_type n, const allocator_type & alloc = allocator_type() ): small_vector(alloc){	reserve( n );	}
+
+			 /**
+			  * @brief Constructs a container with a copy of each of the elements in the range [first,last).
+			  *
+			  * @param first
+			  * @param last
+			  * @param alloc
+			  */
+			 template < typename InputItr, typename = detail::require_iterator< InputItr > >
+			 small_vector( InputItr first, InputItr last, const allocator_type & alloc = allocator_type() ): small_vector(alloc)
+			 {
+			 	append_range_impl( first, last );
+			 }
+
+			 /**
+			  * @brief Constructs a container with a copy of each of the elements in ilist.
+			  *
+			  * @param ilist
+			  * @param alloc
+			  */
+			 small_vector( std::initializer_list< T > ilist, const allocator_type & alloc = allocator_type() ): small_vector(alloc)
+			 {
+			 	append_range_impl( ilist.begin(), ilist.end() );
+			 }
+
+			 /**
+			  * @brief Constructs a container with a copy of each of the elements in model, in the same order.
+			  *
+			  * @param model
+			  */
+			 small_vector( const small_vector & model ): small_vector(alloc_traits::select_on_container_copy_construction(model.m_alloc))
+			 {
+			 	append_range_impl( model.m_storage, model.m_storage + model.m_end );
+			 }
+
+			 /**
+			  * @brief Constructs a container with the elements of model. A heap block is taken over, inline
+			  * elements are moved one by one. model is left empty.
+			  *
+			  * @param model
+			  */
+			 small_vector( small_vector && model ) noexcept( std::is_nothrow_move_constructible< T >::value ):
+			 	small_vector(model.m_alloc)
+			 {
+			 	take( model, true );
+			 }
+
+			 /**
+			  * @brief Destroys the object
+			  *
+			  */
+			 ~small_vector( )
+			 {
+			 	destroy( m_storage, m_storage + m_end );
+			 	deallocate( m_storage, m_capacity );
+			 }
+
+			 /**
+			  * @brief Replaces the contents with a copy of model.
+			  *
+			  * @param model
+			  * @return small_vector&
+			  */
+			 small_vector & operator= ( const small_vector & model )
+			 {
+			 	if( this == &model ){	return *this;	}
+
+			 	if( alloc_traits::propagate_on_container_copy_assignment::value and m_alloc != model.m_alloc )
+			 	{
+			 		// The heap block must be released by the allocator that made it.
+			 		reset();
+			 		detail::propagate_copy( m_alloc, model.m_alloc, typename alloc_traits::propagate_on_container_copy_assignment() );
+			 	}
+			 	assign( model.m_storage, model.m_storage + model.m_end );
+
+			 	return *this;
+			 }
+
+			 /**
+			  * @brief Replaces the contents with the ones of model (see the move constructor).
+			  *
+			  * @param model
+			  * @return small_vector&
+			  */
+			 small_vector & operator= ( small_vector && model )
+			 {
+			 	if( this == &model ){	return *this;	}
+
+			 	const bool propagate = alloc_traits::propagate_on_container_move_assignment::value;
+			 	if( propagate and not model.is_inline() )
+			 	{
+			 		reset();
+			 		detail::propagate_move( m_alloc, model.m_alloc, typename alloc_traits::propagate_on_container_move_assignment() );
+			 	}
+			 	take( model, propagate or m_alloc == model.m_alloc );
+
+			 	return *this;
+			 }
+
+			 /**
+			  * @brief Returns a copy of the allocator associated with the vector.
+			  *
+			  * @return allocator_type
+			  */
+			 allocator_type get_allocator( void ) const{	return m_alloc;	}
+
+//############################# [II] IteratorS
+
+			 Iterator begin( void ){	return Iterator(m_storage);	}
+			 Iterator end( void ){	return Iterator(m_storage + m_end);	}
+			 const_iterator cbegin( void ) const{	return const_iterator(m_storage);	}
+			 const_iterator cend( void ) const{	return const_iterator(m_storage + m_end);	}
+			 const_iterator begin( void ) const{	return cbegin();	}
+			 const_iterator end( void ) const{	return cend();	}
+
+//############################# [III] Capacity
+
+			 size_type size( void ) const{	return m_end;	}
+			 size_type capacity( void ) const{	return m_capacity;	}
+			 bool empty( void ) const{	return m_end == 0;	}
+
+			 /**
+			  * @brief Returns how many elements fit in the inline storage, N.
+			  *
+			  * @return size_type
+			  */
+			 static constexpr size_type inline_capacity( void ){	return N;	}
+
+			 /**
+			  * @brief Tells whether the elements are in the inline storage, that is, no heap block is in use.
+			  *
+			  * @return true
+			  * @return false
+			  */
+			 bool is_inline( void ) const{	return m_storage == reinterpret_cast< const T * >( m_inline );	}
+
+//############################# [IV] Modifiers
+
+			 /**
+			  * @brief Removes all elements from the vector, keeping its storage.
+			  *
+			  */
+			 void clear( void )
+			 {
+			 	destroy( m_storage, m_storage + m_end );
+			 	m_end = 0;
+			 }
+
+			 void push_front( const_reference ref ){	emplace( begin(), ref );	}
+			 void push_back( const_reference ref ){	emplace_back( ref );	}
+			 void push_back( value_type && ref ){	emplace_back( std::move( ref ) );	}
+
+			 /**
+			  * @brief Adds a new element at the end of the vector, constructed in place from args.
+			  *
+			  * @param args
+			  * @return reference to the new element
+			  */
+			 template < typename... Args >
+			 reference emplace_back( Args&&... args )
+			 {
+			 	if( m_end == m_capacity )
+			 	{
+			 		// Built before the elements move, since args may refer to one of them.
+			 		value_type temporary( std::forward< Args >( args )... );
+			 		grow( m_end + 1 );
+			 		construct_at( m_storage + m_end, std::move( temporary ) );
+			 	}
+			 	else
+			 	{
+			 		construct_at( m_storage + m_end, std::forward< Args >( args )... );
+			 	}
+			 	m_end++;
+
+			 	return m_storage[m_end-1];
+			 }
+
+			 /**
+			  * @brief Inserts a new element before position, constructed in place from args.
+			  * A position outside of the vector leaves it unchanged.
+			  *
+			  * @param position
+			  * @param args
+			  * @return Iterator to the new element
+			  */
+			 template < typename... Args >
+			 Iterator emplace( Iterator position, Args&&... args )
+			 {
+			 	const size_type index = index_of( position );
+			 	if( index > m_end ){	return end();	}
+
+			 	if( index == m_end ){	emplace_back( std::forward< Args >( args )... );	}
+			 	else
+			 	{
+			 		value_type temporary( std::forward< Args >( args )... );
+			 		grow( m_end + 1 );
+			 		detail::open_gap( m_alloc, m_storage + index, m_storage + m_end, 1 );
+			 		m_storage[index] = std::move( temporary );
+			 		m_end++;
+			 	}
+
+			 	return Iterator( m_storage + index );
+			 }
+
+			 /**
+			  * @brief Removes the last element in the vector.
+			  *
+			  */
+			 void pop_back( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("Can't pop out of an empty vector \n");}
+
+			 	--m_end;
+			 	destroy( m_storage + m_end, m_storage + m_end + 1 );
+			 }
+
+			 /**
+			  * @brief Removes the first element in the vector, moving the remaining ones.
+			  *
+			  */
+			 void pop_front( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("Can't pop out of an empty vector \n");}
+
+			 	detail::shift_left( m_alloc, m_storage + 1, m_storage + m_end, m_storage );
+			 	--m_end;
+			 }
+
+			 Iterator insert( Iterator position, const_reference ref ){	return emplace( position, ref );	}
+			 Iterator insert( Iterator position, value_type && ref ){	return emplace( position, std::move( ref ) );	}
+
+			 /**
+			  * @brief Inserts copies of the elements in [first, last) before position.
+			  * A position outside of the vector leaves it unchanged.
+			  *
+			  * @param position
+			  * @param first
+			  * @param last
+			  * @return Iterator to the first element inserted
+			  */
+			 template < typename InputItr, typename = detail::require_iterator< InputItr > >
+			 Iterator insert( Iterator position, InputItr first, InputItr last )
+			 {
+			 	const size_type index = index_of( position );
+			 	if( index > m_end ){	return end();	}
+
+			 	const size_type old_end = m_end;
+			 	append_range_impl( first, last );
+			 	std::rotate( m_storage + index, m_storage + old_end, m_storage + m_end );
+
+			 	return Iterator( m_storage + index );
+			 }
+
+			 Iterator insert( Iterator position, std::initializer_list< value_type > ilist ){	return insert( position, ilist.begin(), ilist.end() );	}
+
+			 /**
+			  * @brief Appends a copy of every element of range at the end of the vector.
+			  *
+			  * @param range
+			  */
+			 template < typename Range >
+			 void append_range( Range && range ){	append_range_impl( std::begin( range ), std::end( range ) );	}
+
+			 /**
+			  * @brief Requests that the vector capacity be at least enough to contain n_size elements.
+			  * Past N the elements move to a heap block.
+			  *
+			  * @param n_size
+			  */
+			 void reserve( size_type n_size )
+			 {
+			 	if( n_size <= m_capacity ){	return;	}
+
+			 	move_storage( allocate( n_size ), n_size );
+			 }
+
+			 /**
+			  * @brief Reduces the capacity to fit the size. When the elements fit in the inline storage they
+			  * are moved back into it and the heap block is released, so the capacity becomes N.
+			  *
+			  */
+			 void shrink_to_fit( void )
+			 {
+			 	if( is_inline() or m_end == m_capacity ){	return;	}
+
+			 	if( m_end <= N ){	move_storage( inline_storage(), N );	}
+			 	else{	move_storage( allocate( m_end ), m_end );	}
+			 }
+
+			 /**
+			  * @brief Replaces the contents with count copies of ref.
+			  *
+			  * @param count
+			  * @param ref
+			  */
+			 void assign( size_type count, const_reference ref )
+			 {
+			 	value_type value( ref ); // ref may be an element of the vector.
+			 	clear();
+			 	reserve( count );
+			 	detail::fill_construct( m_alloc, m_storage, count, value );
+			 	m_end = count;
+			 }
+
+			 void assign( std::initializer_list< T > ilist ){	assign( ilist.begin(), ilist.end() );	}
+
+			 /**
+			  * @brief Replaces the contents with copies of the elements in [first, last).
+			  *
+			  * @param first
+			  * @param last
+			  */
+			 template < typename InputItr, typename = detail::require_iterator< InputItr > >
+			 void assign( InputItr first, InputItr last )
+			 {
+			 	clear();
+			 	append_range_impl( first, last );
+			 }
+
+			 /**
+			  * @brief Removes the elements in [first, last).
+			  *
+			  * @param first
+			  * @param last
+			  * @return Iterator following the last element removed
+			  */
+			 Iterator erase( Iterator first, Iterator last )
+			 {
+			 	const size_type index = index_of( first );
+			 	const size_type count = index_of( last ) - index;
+
+			 	detail::shift_left( m_alloc, m_storage + index + count, m_storage + m_end, m_storage + index );
+			 	m_end -= count;
+
+			 	return Iterator( m_storage + index );
+			 }
+
+			 /**
+			  * @brief Removes the element at position.
+			  *
+			  * @param position
+			  * @return Iterator following the element removed
+			  */
+			 Iterator erase( Iterator position ){	return erase( position, Iterator( m_storage + index_of( position ) + 1 ) );	}
+
+			 /**
+			  * @brief Exchanges the contents with those of other.
+			  * Heap blocks are exchanged, inline elements are moved.
+			  *
+			  * @param other
+			  */
+			 void swap( small_vector & other )
+			 {
+			 	if( not is_inline() and not other.is_inline() )
+			 	{
+			 		detail::propagate_swap( m_alloc, other.m_alloc, typename alloc_traits::propagate_on_container_swap() );
+			 		std::swap( m_end, other.m_end );
+			 		std::swap( m_capacity, other.m_capacity );
+			 		std::swap( m_storage, other.m_storage );
+			 		return;
+			 	}
+
+			 	small_vector temporary( std::move( other ) );
+			 	other = std::move( *this );
+			 	*this = std::move( temporary );
+			 }
+
+			 friend void swap( small_vector & first_, small_vector & second_ ){	first_.swap( second_ );	}
+
+//#############################  [V] Element access
+
+			 const_reference back( void ) const
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :( \n");}
+			 	return m_storage[m_end-1];
+			 }
+
+			 reference back( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :( \n");}
+			 	return m_storage[m_end-1];
+			 }
+
+			 const_reference front( void ) const
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :(\n");}
+			 	return m_storage[0];
+			 }
+
+			 reference front( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :(\n");}
+			 	return m_storage[0];
+			 }
+
+			 const_reference operator[]( size_type posi ) const{	return m_storage[posi];	}
+
+			 reference operator[]( size_type n )
+			 {
+			 	if( n >= m_end ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return m_storage[n];
+			 }
+
+			 const_reference at( size_type n ) const
+			 {
+			 	if( n >= m_end ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return m_storage[n];
+			 }
+
+			 reference at( size_type n )
+			 {
+			 	if( n >= m_end ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return m_storage[n];
+			 }
+
+			 pointer data( void ){	return m_storage;	}
+			 const T * data( void ) const{	return m_storage;	}
+
+//############################# [VI] Operators
+
+			 bool operator== ( const small_vector & test_v ) const
+			 {
+			 	return m_end == test_v.m_end and std::equal( m_storage, m_storage + m_end, test_v.m_storage );
+			 }
+
+			 bool operator!= ( const small_vector & test_v ) const{	return not ( *this == test_v );	}
+
+		private:
+
+			 /**
+			  * @brief Appends copies of the elements in [first, last), growing through the growth policy.
+			  *
+			  * @param first
+			  * @param last
+			  */
+			 template < typename InputItr >
+			 void append_range_impl( InputItr first, InputItr last )
+			 {
+			 	append_range_impl( first, last, typename std::iterator_traits< InputItr >::iterator_category() );
+			 }
+
+			 template < typename ForwardItr >
+			 void append_range_impl( ForwardItr first, ForwardItr last, std::forward_iterator_tag )
+			 {
+			 	const size_type n = std::distance( first, last );
+			 	grow( m_end + n );
+			 	detail::copy_construct( m_alloc, first, last, m_storage + m_end );
+			 	m_end += n;
+			 }
+
+			 template < typename InputItr >
+			 void append_range_impl( InputItr first, InputItr last, std::input_iterator_tag )
+			 {
+			 	for( ; first != last; ++first ){	emplace_back( *first );	}
+			 }
+	};
+};
+
+#endif
@@ -0,0 +1,519 @@
+/**
+ * @file    soa_vector.h
+ * @brief   Structure-of-arrays sequencial container: sc::soa_vector< A, B, C > stores rows of three fields
+ *          as three contiguous columns, so a loop over one field streams only that field through the
+ *          cache. Rows are read and written through tuples of references, columns through sc::span.
+ * @author  Bruna Hellen de Castro Dantas Barbosa
+ */
+
+#ifndef SOA_VECTOR_H
+#define SOA_VECTOR_H
+
+#include "vector.h"
+
+#include <cstddef> // std::max_align_t
+#include <tuple> // std::tuple, std::tie, std::get
+
+
+namespace sc
+{
+
+	namespace detail
+	{
+		// std::index_sequence is C++14.
+		template < std::size_t... I >
+		struct index_sequence {};
+
+		template < std::size_t N, std::size_t... I >
+		struct make_index_sequence_impl : make_index_sequence_impl< N - 1, N - 1, I... > {};
+
+		template < std::size_t... I >
+		struct make_index_sequence_impl< 0, I... >{	typedef index_sequence< I... > type;	};
+
+		template < std::size_t N >
+		using make_index_sequence = typename make_index_sequence_impl< N >::type;
+
+		/// Evaluates the expressions of a pack expansion in order, e.g. swallow{ 0, ( f( x ), 0 )... }.
+		typedef int swallow[];
+
+		template < bool... > struct bool_pack;
+
+		/// True when every one of B is.
+		template < bool... B >
+		using all_of = std::is_same< bool_pack< true, B... >, bool_pack< B..., true > >;
+	}
+
+	/**
+	 * Non-owning view of a contiguous run of elements, as returned by soa_vector::column().
+	 */
+	template < typename T >
+	class span
+	{
+		public:
+
+			typedef std::size_t size_type;
+			typedef T value_type;
+			typedef T* Iterator;
+
+			span( T * data = nullptr, size_type size = 0 ): m_data(data), m_size(size){	/* Empty */	}
+
+			T * data( void ) const{	return m_data;	}
+			size_type size( void ) const{	return m_size;	}
+			bool empty( void ) const{	return m_size == 0;	}
+
+			T * begin( void ) const{	return m_data;	}
+			T * end( void ) const{	return m_data + m_size;	}
+
+			T & operator[]( size_type n ) const{	return m_data[n];	}
+
+		private:
+			T * m_data; //<! First element.
+			size_type m_size; //<! Number of elements.
+	};
+
+	/**
+	 * Random access iterator over the rows of a soa_vector. Rows aren't objects, so dereferencing returns
+	 * a tuple of references by value, and the iterator is an input iterator as far as the STL is concerned.
+	 */
+	template < typename Container, typename Reference >
+	class soa_iterator
+	{
+		public:
+
+			typedef std::ptrdiff_t difference_type;
+			typedef typename Container::value_type value_type;
+			typedef Reference reference;
+			typedef void pointer;
+			typedef std::input_iterator_tag iterator_category;
+
+			soa_iterator( Container * container = nullptr, difference_type index = 0 ): m_container(container), m_index(index){	/* Empty */	}
+
+			/// Iterator to const_iterator.
+			template < typename C, typename R, typename = typename std::enable_if< std::is_convertible< C*, Container* >::value >::type >
+			soa_iterator( const soa_iterator< C, R > & other ): m_container(other.m_container), m_index(other.m_index){	/* Empty */	}
+
+			difference_type index( void ) const{	return m_index;	}
+
+			reference operator* ( void ) const{	return ( *m_container )[ m_index ];	}
+			reference operator[] ( difference_type n ) const{	return ( *m_container )[ m_index + n ];	}
+
+			soa_iterator & operator++ ( void ){	++m_index; return *this;	}
+			soa_iterator operator++ ( int ){	soa_iterator old( *this ); ++m_index; return old;	}
+			soa_iterator & operator-- ( void ){	--m_index; return *this;	}
+			soa_iterator operator-- ( int ){	soa_iterator old( *this ); --m_index; return old;	}
+			soa_iterator & operator+= ( difference_type n ){	m_index += n; return *this;	}
+			soa_iterator & operator-= ( difference_type n ){	m_index -= n; return *this;	}
+
+			friend soa_iterator operator+ ( soa_iterator it, difference_type n ){	return it += n;	}
+			friend soa_iterator operator+ ( difference_type n, soa_iterator it ){	return it += n;	}
+			friend soa_iterator operator- ( soa_iterator it, difference_type n ){	return it -= n;	}
+			friend difference_type operator- ( const soa_iterator & a, const soa_iterator & b ){	return a.m_index - b.m_index;	}
+
+			friend bool operator== ( const soa_iterator & a, const soa_iterator & b ){	return a.m_index == b.m_index;	}
+			friend bool operator!= ( const soa_iterator & a, const soa_iterator & b ){	return a.m_index != b.m_index;	}
+			friend bool operator< ( const soa_iterator & a, const soa_iterator & b ){	return a.m_index < b.m_index;	}
+			friend bool operator> ( const soa_iterator & a, const soa_iterator & b ){	return a.m_index > b.m_index;	}
+			friend bool operator<= ( const soa_iterator & a, const soa_iterator & b ){	return a.m_index <= b.m_index;	}
+			friend bool operator>= ( const soa_iterator & a, const soa_iterator & b ){	return a.m_index >= b.m_index;	}
+
+		private:
+			template < typename C, typename R > friend class soa_iterator;
+
+			Container * m_container;
+			difference_type m_index;
+	};
+
+	/**
+	 * All the columns share a single block, each of them starting on a cache line (relative to the block).
+	 * The fields must be nothrow move constructible, so the columns can be relocated one after the other
+	 * without a way to fail halfway.
+	 */
+	template < typename... Fields >
+	class soa_vector
+	{
+
+		public:
+
+			typedef doubling_growth growth_policy;
+			typedef size_t size_type;
+			typedef std::tuple< Fields... > value_type;
+			typedef std::tuple< Fields&... > reference;
+			typedef std::tuple< const Fields&... > const_reference;
+			typedef soa_iterator< soa_vector, reference > Iterator;
+			typedef soa_iterator< const soa_vector, const_reference > const_iterator;
+
+			/// Type of the I-th field.
+			template < std::size_t I >
+			using field_type = typename std::tuple_element< I, value_type >::type;
+
+			static const std::size_t field_count = sizeof...( Fields );
+
+		private:
+			typedef std::max_align_t block_type;
+			typedef std::allocator< block_type > block_allocator;
+			typedef detail::make_index_sequence< sizeof...( Fields ) > fields;
+
+			static const size_type column_alignment = 64;
+
+			static_assert( sizeof...( Fields ) > 0, "sc::soa_vector needs at least one field" );
+			static_assert( detail::all_of< std::is_nothrow_move_constructible< Fields >::value... >::value, "sc::soa_vector relocates its columns one by one, the fields must be nothrow move constructible" );
+			static_assert( detail::all_of< ( alignof( Fields ) <= alignof( block_type ) )... >::value, "sc::soa_vector can't align over-aligned fields" );
+
+			size_type m_end; //<! Number of rows.
+			size_type m_capacity; //<! Number of rows the columns have room for.
+			block_type * m_block; //<! Storage of every column.
+			std::tuple< Fields*... > m_columns; //<! First element of each column, inside m_block.
+
+			template < std::size_t I >
+			field_type< I > * column_data( void ) const{	return std::get< I >( m_columns );	}
+
+			static size_type align_column( size_type bytes ){	return ( bytes + column_alignment - 1 ) / column_alignment * column_alignment;	}
+
+			/// Bytes of the block that holds capacity rows.
+			static size_type block_bytes( size_type capacity )
+			{
+				size_type bytes = 0;
+				(void) detail::swallow{ 0, ( bytes = align_column( bytes + capacity * sizeof( Fields ) ), 0 )... };
+				return bytes;
+			}
+
+			static size_type block_words( size_type capacity ){	return ( block_bytes( capacity ) + sizeof( block_type ) - 1 ) / sizeof( block_type );	}
+
+			/// Points each column at its place in block, for a block of capacity rows.
+			static std::tuple< Fields*... > columns_of( block_type * block, size_type capacity )
+			{
+				unsigned char * base = reinterpret_cast< unsigned char * >( block );
+				size_type offset = 0;
+				return std::tuple< Fields*... >{ column_at< Fields >( base, offset, capacity )... };
+			}
+
+			template < typename T >
+			static T * column_at( unsigned char * base, size_type & offset, size_type capacity )
+			{
+				T * column = reinterpret_cast< T * >( base + offset );
+				offset = align_column( offset + capacity * sizeof( T ) );
+				return column;
+			}
+
+			/**
+			 * @brief Constructs the fields of row from the elements of values, in order. If a constructor
+			 * throws, the fields already built are destroyed.
+			 *
+			 * @param row
+			 * @param values a tuple (of values or references) with one element per field
+			 */
+			template < std::size_t I, typename Tuple >
+			void construct_fields( size_type row, Tuple && values, std::integral_constant< std::size_t, I > )
+			{
+				std::allocator< field_type< I > > alloc;
+				std::allocator_traits< std::allocator< field_type< I > > >::construct( alloc, column_data< I >() + row,
+						std::get< I >( std::forward< Tuple >( values ) ) );
+
+				try{	construct_fields( row, std::forward< Tuple >( values ), std::integral_constant< std::size_t, I + 1 >() );	}
+				catch( ... ){	detail::destroy( alloc, column_data< I >() + row, column_data< I >() + row + 1 ); throw;	}
+			}
+
+			template < typename Tuple >
+			void construct_fields( size_type, Tuple &&, std::integral_constant< std::size_t, sizeof...( Fields ) > ){	/* Every field is built */	}
+
+			/**
+			 * @brief Copies the rows of model into this vector's storage, which must be empty and large enough.
+			 *
+			 */
+			template < std::size_t I >
+			void copy_columns( const soa_vector & model, std::integral_constant< std::size_t, I > )
+			{
+				std::allocator< field_type< I > > alloc;
+				detail::copy_construct( alloc, model.column_data< I >(), model.column_data< I >() + model.m_end, column_data< I >() );
+
+				try{	copy_columns( model, std::integral_constant< std::size_t, I + 1 >() );	}
+				catch( ... ){	detail::destroy( alloc, column_data< I >(), column_data< I >() + model.m_end ); throw;	}
+			}
+
+			void copy_columns( const soa_vector &, std::integral_constant< std::size_t, sizeof...( Fields ) > ){	/* Every column is copied */	}
+
+			template < std::size_t... I >
+			void destroy_rows( size_type first, size_type last, detail::index_sequence< I... > )
+			{
+				(void) detail::swallow{ 0, ( destroy_column< I >( first, last ), 0 )... };
+			}
+
+			template < std::size_t I >
+			void destroy_column( size_type first, size_type last )
+			{
+				std::allocator< field_type< I > > alloc;
+				detail::destroy( alloc, column_data< I >() + first, column_data< I >() + last );
+			}
+
+			template < std::size_t... I >
+			void relocate_columns( const std::tuple< Fields*... > & to, detail::index_sequence< I... > )
+			{
+				(void) detail::swallow{ 0, ( relocate_column< I >( std::get< I >( to ) ), 0 )... };
+			}
+
+			template < std::size_t I >
+			void relocate_column( field_type< I > * to )
+			{
+				std::allocator< field_type< I > > alloc;
+				detail::relocate( alloc, column_data< I >(), column_data< I >() + m_end, to );
+				detail::destroy( alloc, column_data< I >(), column_data< I >() + m_end );
+			}
+
+			template < std::size_t... I >
+			void shift_rows( size_type index, size_type count, detail::index_sequence< I... > )
+			{
+				(void) detail::swallow{ 0, ( shift_column< I >( index, count ), 0 )... };
+			}
+
+			template < std::size_t I >
+			void shift_column( size_type index, size_type count )
+			{
+				std::allocator< field_type< I > > alloc;
+				detail::shift_left( alloc, column_data< I >() + index + count, column_data< I >() + m_end, column_data< I >() + index );
+			}
+
+			template < std::size_t... I >
+			reference row( size_type n, detail::index_sequence< I... > ){	return reference( column_data< I >()[n]... );	}
+
+			template < std::size_t... I >
+			const_reference row( size_type n, detail::index_sequence< I... > ) const{	return const_reference( column_data< I >()[n]... );	}
+
+			/**
+			 * @brief Moves the rows to a block of new_capacity rows, which must hold them.
+			 *
+			 * @param new_capacity
+			 */
+			void reallocate( size_type new_capacity )
+			{
+				block_allocator alloc;
+				block_type * block = new_capacity == 0 ? nullptr : alloc.allocate( block_words( new_capacity ) );
+				const std::tuple< Fields*... > columns = columns_of( block, new_capacity );
+
+				relocate_columns( columns, fields() );
+				if( m_block != nullptr ){	alloc.deallocate( m_block, block_words( m_capacity ) );	}
+
+				m_block = block;
+				m_columns = columns;
+				m_capacity = new_capacity;
+			}
+
+			void grow( size_type required )
+			{
+				if( required > m_capacity ){	reserve( growth_policy::grow( m_capacity, required, sizeof( value_type ) ) );	}
+			}
+
+		public:
+
+//############################# [I] SPECIAL MEMBERS
+
+			 /**
+			  * @brief Constructs an empty container, no column is allocated until the first row is added.
+			  *
+			  */
+			 soa_vector( ): m_end(0), m_capacity(0), m_block(nullptr), m_columns(){	/* Empty */	}
+
+			 soa_vector( const soa_vector & model ): soa_vector()
+			 {
+			 	reserve( model.m_end );
+			 	copy_columns( model, std::integral_constant< std::size_t, 0 >() );
+			 	m_end = model.m_end;
+			 }
+
+			 soa_vector( soa_vector && model ) noexcept: m_end(model.m_end), m_capacity(model.m_capacity), m_block(model.m_block), m_columns(model.m_columns)
+			 {
+			 	model.m_end = 0;
+			 	model.m_capacity = 0;
+			 	model.m_block = nullptr;
+			 	model.m_columns = std::tuple< Fields*... >();
+			 }
+
+			 soa_vector & operator= ( soa_vector model ) noexcept
+			 {
+			 	swap( model );
+			 	return *this;
+			 }
+
+			 ~soa_vector( )
+			 {
+			 	clear();
+			 	if( m_block != nullptr ){	block_allocator().deallocate( m_block, block_words( m_capacity ) );	}
+			 }
+
+//############################# [II] IteratorS
+
+			 Iterator begin( void ){	return Iterator( this, 0 );	}
+			 Iterator end( void ){	return Iterator( this, m_end );	}
+			 const_iterator begin( void ) const{	return cbegin();	}
+			 const_iterator end( void ) const{	return cend();	}
+			 const_iterator cbegin( void ) const{	return const_iterator( this, 0 );	}
+			 const_iterator cend( void ) const{	return const_iterator( this, m_end );	}
+
+//############################# [III] Capacity
+
+			 size_type size( void ) const{	return m_end;	}
+			 size_type capacity( void ) const{	return m_capacity;	}
+			 bool empty( void ) const{	return m_end == 0;	}
+
+			 /**
+			  * @brief Requests that every column have room for at least n_size rows.
+			  *
+			  * @param n_size
+			  */
+			 void reserve( size_type n_size )
+			 {
+			 	if( n_size <= m_capacity ){	return;	}
+			 	reallocate( n_size );
+			 }
+
+			 /**
+			  * @brief Requests the columns to reduce their capacity to the number of rows.
+			  *
+			  */
+			 void shrink_to_fit( void )
+			 {
+			 	if( m_end == m_capacity ){	return;	}
+			 	reallocate( m_end );
+			 }
+
+//############################# [IV] Modifiers
+
+			 void clear( void )
+			 {
+			 	destroy_rows( 0, m_end, fields() );
+			 	m_end = 0;
+			 }
+
+			 /**
+			  * @brief Appends a row whose fields are constructed from values, one value per field.
+			  *
+			  * @param values
+			  */
+			 template < typename... Args >
+			 void emplace_back( Args&&... values )
+			 {
+			 	static_assert( sizeof...( Args ) == sizeof...( Fields ), "sc::soa_vector::emplace_back takes one value per field" );
+
+			 	if( m_end == m_capacity )
+			 	{
+			 		// values may refer to rows of this vector, which growing moves.
+			 		value_type copy( std::forward< Args >( values )... );
+			 		grow( m_end + 1 );
+			 		construct_fields( m_end, std::move( copy ), std::integral_constant< std::size_t, 0 >() );
+			 	}
+			 	else{	construct_fields( m_end, std::forward_as_tuple( std::forward< Args >( values )... ), std::integral_constant< std::size_t, 0 >() );	}
+
+			 	++m_end;
+			 }
+
+			 void push_back( const value_type & values )
+			 {
+			 	if( m_end == m_capacity ){	push_back( value_type( values ) ); return;	}
+
+			 	construct_fields( m_end, values, std::integral_constant< std::size_t, 0 >() );
+			 	++m_end;
+			 }
+
+			 void push_back( value_type && values )
+			 {
+			 	grow( m_end + 1 );
+			 	construct_fields( m_end, std::move( values ), std::integral_constant< std::size_t, 0 >() );
+			 	++m_end;
+			 }
+
+			 void pop_back( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("Can't pop out of an empty vector \n");}
+			 	destroy_rows( m_end - 1, m_end, fields() );
+			 	--m_end;
+			 }
+
+			 /**
+			  * @brief Removes the rows in [first, last), shifting the following rows down in every column.
+			  *
+			  * @param first
+			  * @param last
+			  * @return Iterator to the row that followed the last one removed.
+			  */
+			 Iterator erase( const_iterator first, const_iterator last )
+			 {
+			 	const size_type index = first - cbegin();
+			 	const size_type count = last - first;
+			 	if( count == 0 ){	return Iterator( this, index );	}
+
+			 	shift_rows( index, count, fields() );
+			 	m_end -= count;
+
+			 	return Iterator( this, index );
+			 }
+
+			 Iterator erase( const_iterator position ){	return erase( position, position + 1 );	}
+
+			 void swap( soa_vector & other ) noexcept
+			 {
+			 	std::swap( m_end, other.m_end );
+			 	std::swap( m_capacity, other.m_capacity );
+			 	std::swap( m_block, other.m_block );
+			 	std::swap( m_columns, other.m_columns );
+			 }
+
+//#############################  [V] Element access
+
+			 /**
+			  * @brief Row n as a tuple of references to its fields: std::get< 1 >( vec[n] ) = x writes the field.
+			  *
+			  * @param n
+			  * @return reference
+			  */
+			 reference operator[]( size_type n ){	return row( n, fields() );	}
+			 const_reference operator[]( size_type n ) const{	return row( n, fields() );	}
+
+			 reference at( size_type n )
+			 {
+			 	if( n >= m_end ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return row( n, fields() );
+			 }
+
+			 const_reference at( size_type n ) const
+			 {
+			 	if( n >= m_end ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return row( n, fields() );
+			 }
+
+			 reference front( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :(\n");}
+			 	return row( 0, fields() );
+			 }
+
+			 reference back( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :( \n");}
+			 	return row( m_end - 1, fields() );
+			 }
+
+			 /**
+			  * @brief Field I of row n.
+			  *
+			  * @param n
+			  */
+			 template < std::size_t I >
+			 field_type< I > & get( size_type n ){	return column_data< I >()[n];	}
+
+			 template < std::size_t I >
+			 const field_type< I > & get( size_type n ) const{	return column_data< I >()[n];	}
+
+			 /**
+			  * @brief The I-th column: one contiguous array with field I of every row, for loops that read
+			  * only some fields.
+			  *
+			  * @return span< field_type< I > >
+			  */
+			 template < std::size_t I >
+			 span< field_type< I > > column( void ){	return span< field_type< I > >( column_data< I >(), m_end );	}
+
+			 template < std::size_t I >
+			 span< const field_type< I > > column( void ) const{	return span< const field_type< I > >( column_data< I >(), m_end );	}
+	};
+};
+
+#endif
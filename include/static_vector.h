@@ -0,0 +1,473 @@
+/**
+ * @file    static_vector.h
+ * @brief   Sequencial container with the interface of sc::vector and a fixed capacity N, whose
+ *          storage is a member array: it never allocates. Built as C++20, its operations are
+ *          constexpr for trivial element types, so tables can be filled at compile time.
+ * @author  Bruna Hellen de Castro Dantas Barbosa
+ */
+
+#ifndef STATIC_VECTOR_H
+#define STATIC_VECTOR_H
+
+#include "vector.h" // SC_CONSTEXPR20
+
+
+namespace sc
+{
+
+	namespace detail
+	{
+		/*
+		 * Storage of a static_vector: N slots and the number of them in use.
+		 * Trivial types live in a plain array, so every operation can run in a constant expression.
+		 * Other types live in raw aligned storage, where the elements are constructed and destroyed one by one.
+		 */
+		template < typename T, std::size_t N, bool = std::is_trivial< T >::value >
+		struct static_storage
+		{
+			T m_data[N]; //<! Only [0, m_end) is meaningful; the slots past it are left uninitialized.
+			std::size_t m_end = 0; //<! Number of slots in use.
+
+#if __cplusplus >= 202002L
+			/// A constant expression can't leave a slot indeterminate, so there (only) every slot is zeroed.
+			constexpr static_storage( )
+			{
+				if( std::is_constant_evaluated() ){	for( T & slot : m_data ){	slot = T();	}	}
+			}
+#endif
+
+			SC_CONSTEXPR20 T * data( void ){	return m_data;	}
+			constexpr const T * data( void ) const{	return m_data;	}
+
+			template < typename... Args >
+			SC_CONSTEXPR20 void construct( std::size_t i, Args&&... args ){	m_data[i] = T( std::forward< Args >( args )... );	}
+
+			SC_CONSTEXPR20 void destroy( std::size_t, std::size_t ){ /* Trivially destructible, nothing to do */ }
+		};
+
+		template < typename T, std::size_t N >
+		struct static_storage< T, N, false >
+		{
+			typename std::aligned_storage< sizeof( T ), alignof( T ) >::type m_data[N]; //<! Only [0, m_end) is constructed.
+			std::size_t m_end = 0; //<! Number of slots in use.
+
+			static_storage( ) = default;
+			static_storage( const static_storage & ) = delete;
+			static_storage & operator=( const static_storage & ) = delete;
+			~static_storage( ){	destroy( 0, m_end );	}
+
+			T * data( void ){	return reinterpret_cast< T * >( m_data );	}
+			const T * data( void ) const{	return reinterpret_cast< const T * >( m_data );	}
+
+			template < typename... Args >
+			void construct( std::size_t i, Args&&... args ){	::new ( static_cast< void * >( data() + i ) ) T( std::forward< Args >( args )... );	}
+
+			void destroy( std::size_t first, std::size_t last ){	for( ; first != last; ++first ){	data()[first].~T();	}	}
+		};
+	}
+
+	template < typename T, std::size_t N >
+	class static_vector
+	{
+
+		public:
+
+			typedef size_t size_type;
+			typedef T value_type;
+			typedef MyIterator< T > Iterator;
+			typedef MyIterator< const T > const_iterator;
+			typedef T& reference;
+			typedef const T& const_reference;
+			typedef T* pointer;
+
+			static_assert( N > 0, "sc::static_vector needs a capacity of at least one element" );
+
+		private:
+			detail::static_storage< T, N > m_storage; //<! The N slots, and how many of them are in use.
+
+			// The element shifts are plain loops, instead of the relocation layer of sc::vector, so they
+			// can run in constant expressions.
+
+			/**
+			 * @brief Throws std::length_error if `required` elements don't fit.
+			 *
+			 * @param required
+			 */
+			SC_CONSTEXPR20 void check_capacity( size_type required ) const
+			{
+				if( required > N ){	throw std::length_error("The static_vector is full.\n");	}
+			}
+
+			/**
+			 * @brief Shifts [index, size()) n slots to the right; the gap [index, index + n) is left with
+			 * moved-from elements or unused slots, to be filled by put().
+			 *
+			 * @param index
+			 * @param n
+			 */
+			SC_CONSTEXPR20 void open_gap( size_type index, size_type n )
+			{
+				pointer data = m_storage.data();
+				for( size_type i = m_storage.m_end; i != index; --i )
+				{
+					if( i - 1 + n >= m_storage.m_end ){	m_storage.construct( i - 1 + n, std::move( data[i-1] ) );	}
+					else{	data[i-1+n] = std::move( data[i-1] );	}
+				}
+			}
+
+			/**
+			 * @brief Stores value at index, assigning it over a live slot or constructing it in an unused one.
+			 *
+			 * @param index
+			 * @param value
+			 */
+			template < typename U >
+			SC_CONSTEXPR20 void put( size_type index, U && value )
+			{
+				if( index < m_storage.m_end ){	m_storage.data()[index] = std::forward< U >( value );	}
+				else{	m_storage.construct( index, std::forward< U >( value ) );	}
+			}
+
+			SC_CONSTEXPR20 size_type index_of( const_iterator position ) const{	return position.base() - m_storage.data();	}
+
+		public:
+
+//############################# [I] SPECIAL MEMBERS
+
+			 /**
+			  * @brief Constructs an empty container.
+			  *
+			  */
+			 SC_CONSTEXPR20 static_vector( ) = default;
+
+			 /**
+			  * @brief Constructs a container with a copy of each of the elements in ilist.
+			  * Throws std::length_error if they are more than N.
+			  *
+			  * @param ilist
+			  */
+			 SC_CONSTEXPR20 static_vector( std::initializer_list< T > ilist ){	assign( ilist.begin(), ilist.end() );	}
+
+			 /**
+			  * @brief Constructs a container with a copy of each of the elements in the range [first,last).
+			  * Throws std::length_error if they are more than N.
+			  *
+			  * @param first
+			  * @param last
+			  */
+			 template < typename InputItr, typename = detail::require_iterator< InputItr > >
+			 SC_CONSTEXPR20 static_vector( InputItr first, InputItr last ){	assign( first, last );	}
+
+			 SC_CONSTEXPR20 static_vector( const static_vector & model ){	assign( model.data(), model.data() + model.size() );	}
+
+			 /**
+			  * @brief Constructs a container moving the elements of model into it one by one, as there is
+			  * no storage to take over. model keeps its (moved-from) elements.
+			  *
+			  * @param model
+			  */
+			 SC_CONSTEXPR20 static_vector( static_vector && model )
+			 {
+			 	for( size_type i = 0; i != model.size(); ++i ){	m_storage.construct( i, std::move( model.m_storage.data()[i] ) );	}
+			 	m_storage.m_end = model.size();
+			 }
+
+			 SC_CONSTEXPR20 static_vector & operator= ( const static_vector & model )
+			 {
+			 	if( this != &model ){	assign( model.data(), model.data() + model.size() );	}
+			 	return *this;
+			 }
+
+			 SC_CONSTEXPR20 static_vector & operator= ( static_vector && model )
+			 {
+			 	if( this != &model ){	assign( std::make_move_iterator( model.m_storage.data() ), std::make_move_iterator( model.m_storage.data() + model.size() ) );	}
+			 	return *this;
+			 }
+
+			 SC_CONSTEXPR20 static_vector & operator= ( std::initializer_list< T > ilist )
+			 {
+			 	assign( ilist.begin(), ilist.end() );
+			 	return *this;
+			 }
+
+//############################# [II] IteratorS
+
+			 SC_CONSTEXPR20 Iterator begin( void ){	return Iterator( m_storage.data() );	}
+			 SC_CONSTEXPR20 Iterator end( void ){	return Iterator( m_storage.data() + size() );	}
+			 SC_CONSTEXPR20 const_iterator cbegin( void ) const{	return const_iterator( m_storage.data() );	}
+			 SC_CONSTEXPR20 const_iterator cend( void ) const{	return const_iterator( m_storage.data() + size() );	}
+			 SC_CONSTEXPR20 const_iterator begin( void ) const{	return cbegin();	}
+			 SC_CONSTEXPR20 const_iterator end( void ) const{	return cend();	}
+
+//############################# [III] Capacity
+
+			 constexpr size_type size( void ) const{	return m_storage.m_end;	}
+			 constexpr size_type capacity( void ) const{	return N;	}
+			 constexpr bool empty( void ) const{	return m_storage.m_end == 0;	}
+			 constexpr bool full( void ) const{	return m_storage.m_end == N;	}
+
+			 /**
+			  * @brief There is nothing to allocate: only checks that n_size elements fit, throwing
+			  * std::length_error otherwise.
+			  *
+			  * @param n_size
+			  */
+			 SC_CONSTEXPR20 void reserve( size_type n_size ) const{	check_capacity( n_size );	}
+
+			 /**
+			  * @brief The capacity is fixed, nothing is done.
+			  *
+			  */
+			 SC_CONSTEXPR20 void shrink_to_fit( void ){ /* Empty */ }
+
+//############################# [IV] Modifiers
+
+			 SC_CONSTEXPR20 void clear( void )
+			 {
+			 	m_storage.destroy( 0, m_storage.m_end );
+			 	m_storage.m_end = 0;
+			 }
+
+			 /**
+			  * @brief Adds a new element at the end, constructed in place from args.
+			  * Throws std::length_error if the vector is full.
+			  *
+			  * @param args
+			  * @return reference to the new element
+			  */
+			 template < typename... Args >
+			 SC_CONSTEXPR20 reference emplace_back( Args&&... args )
+			 {
+			 	check_capacity( m_storage.m_end + 1 );
+			 	m_storage.construct( m_storage.m_end, std::forward< Args >( args )... );
+
+			 	return m_storage.data()[m_storage.m_end++];
+			 }
+
+			 SC_CONSTEXPR20 void push_back( const_reference ref ){	emplace_back( ref );	}
+			 SC_CONSTEXPR20 void push_back( value_type && ref ){	emplace_back( std::move( ref ) );	}
+
+			 /**
+			  * @brief Adds a new element at the end, constructed in place from args, if there is room for it.
+			  *
+			  * @param args
+			  * @return pointer to the new element, or nullptr if the vector is full
+			  */
+			 template < typename... Args >
+			 SC_CONSTEXPR20 pointer try_emplace_back( Args&&... args )
+			 {
+			 	if( full() ){	return nullptr;	}
+			 	m_storage.construct( m_storage.m_end, std::forward< Args >( args )... );
+
+			 	return m_storage.data() + m_storage.m_end++;
+			 }
+
+			 /**
+			  * @brief Adds a copy of ref at the end if there is room for it; never throws std::length_error.
+			  *
+			  * @param ref
+			  * @return true if the element was added, false if the vector is full
+			  */
+			 SC_CONSTEXPR20 bool try_push_back( const_reference ref ){	return try_emplace_back( ref ) != nullptr;	}
+			 SC_CONSTEXPR20 bool try_push_back( value_type && ref ){	return try_emplace_back( std::move( ref ) ) != nullptr;	}
+
+			 /**
+			  * @brief Inserts a new element before position, constructed from args.
+			  * A position outside of the vector leaves it unchanged, a full vector throws std::length_error.
+			  *
+			  * @param position
+			  * @param args
+			  * @return Iterator to the new element
+			  */
+			 template < typename... Args >
+			 SC_CONSTEXPR20 Iterator emplace( Iterator position, Args&&... args )
+			 {
+			 	const size_type index = index_of( position );
+			 	if( index > size() ){	return end();	}
+
+			 	check_capacity( size() + 1 );
+			 	value_type temporary( std::forward< Args >( args )... );
+			 	open_gap( index, 1 );
+			 	put( index, std::move( temporary ) );
+			 	m_storage.m_end++;
+
+			 	return Iterator( m_storage.data() + index );
+			 }
+
+			 SC_CONSTEXPR20 void push_front( const_reference ref ){	emplace( begin(), ref );	}
+			 SC_CONSTEXPR20 Iterator insert( Iterator position, const_reference ref ){	return emplace( position, ref );	}
+			 SC_CONSTEXPR20 Iterator insert( Iterator position, value_type && ref ){	return emplace( position, std::move( ref ) );	}
+
+			 /**
+			  * @brief Inserts copies of the elements in [first, last) before position.
+			  * A position outside of the vector leaves it unchanged, too many elements throw std::length_error.
+			  *
+			  * @param position
+			  * @param first
+			  * @param last
+			  * @return Iterator to the first element inserted
+			  */
+			 template < typename ForwardItr, typename = detail::require_iterator< ForwardItr > >
+			 SC_CONSTEXPR20 Iterator insert( Iterator position, ForwardItr first, ForwardItr last )
+			 {
+			 	const size_type index = index_of( position );
+			 	if( index > size() ){	return end();	}
+
+			 	const size_type n = std::distance( first, last );
+			 	check_capacity( size() + n );
+			 	open_gap( index, n );
+			 	for( size_type i = index; first != last; ++first, ++i ){	put( i, *first );	}
+			 	m_storage.m_end += n;
+
+			 	return Iterator( m_storage.data() + index );
+			 }
+
+			 SC_CONSTEXPR20 Iterator insert( Iterator position, std::initializer_list< value_type > ilist ){	return insert( position, ilist.begin(), ilist.end() );	}
+
+			 SC_CONSTEXPR20 void pop_back( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("Can't pop out of an empty vector \n");}
+
+			 	m_storage.m_end--;
+			 	m_storage.destroy( m_storage.m_end, m_storage.m_end + 1 );
+			 }
+
+			 SC_CONSTEXPR20 void pop_front( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("Can't pop out of an empty vector \n");}
+
+			 	erase( begin() );
+			 }
+
+			 /**
+			  * @brief Removes the elements in [first, last).
+			  *
+			  * @param first
+			  * @param last
+			  * @return Iterator following the last element removed
+			  */
+			 SC_CONSTEXPR20 Iterator erase( Iterator first, Iterator last )
+			 {
+			 	const size_type index = index_of( first );
+			 	const size_type count = index_of( last ) - index;
+			 	pointer data = m_storage.data();
+
+			 	for( size_type i = index + count; i != size(); ++i ){	data[i-count] = std::move( data[i] );	}
+			 	m_storage.destroy( size() - count, size() );
+			 	m_storage.m_end -= count;
+
+			 	return Iterator( data + index );
+			 }
+
+			 SC_CONSTEXPR20 Iterator erase( Iterator position ){	return erase( position, Iterator( m_storage.data() + index_of( position ) + 1 ) );	}
+
+			 /**
+			  * @brief Replaces the contents with count copies of ref. Throws std::length_error if count > N.
+			  *
+			  * @param count
+			  * @param ref
+			  */
+			 SC_CONSTEXPR20 void assign( size_type count, const_reference ref )
+			 {
+			 	check_capacity( count );
+			 	value_type value( ref ); // ref may be an element of the vector.
+			 	clear();
+			 	for( ; m_storage.m_end != count; ++m_storage.m_end ){	m_storage.construct( m_storage.m_end, value );	}
+			 }
+
+			 /**
+			  * @brief Replaces the contents with copies of the elements in [first, last).
+			  * Throws std::length_error if they are more than N.
+			  *
+			  * @param first
+			  * @param last
+			  */
+			 template < typename InputItr, typename = detail::require_iterator< InputItr > >
+			 SC_CONSTEXPR20 void assign( InputItr first, InputItr last )
+			 {
+			 	clear();
+			 	for( ; first != last; ++first ){	emplace_back( *first );	}
+			 }
+
+			 SC_CONSTEXPR20 void assign( std::initializer_list< T > ilist ){	assign( ilist.begin(), ilist.end() );	}
+
+			 /**
+			  * @brief Exchanges the contents with those of other, element by element.
+			  *
+			  * @param other
+			  */
+			 SC_CONSTEXPR20 void swap( static_vector & other )
+			 {
+			 	static_vector temporary( std::move( other ) );
+			 	other = std::move( *this );
+			 	*this = std::move( temporary );
+			 }
+
+			 friend SC_CONSTEXPR20 void swap( static_vector & first_, static_vector & second_ ){	first_.swap( second_ );	}
+
+//#############################  [V] Element access
+
+			 SC_CONSTEXPR20 const_reference back( void ) const
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :( \n");}
+			 	return m_storage.data()[size()-1];
+			 }
+
+			 SC_CONSTEXPR20 reference back( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :( \n");}
+			 	return m_storage.data()[size()-1];
+			 }
+
+			 SC_CONSTEXPR20 const_reference front( void ) const
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :(\n");}
+			 	return m_storage.data()[0];
+			 }
+
+			 SC_CONSTEXPR20 reference front( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :(\n");}
+			 	return m_storage.data()[0];
+			 }
+
+			 constexpr const_reference operator[]( size_type posi ) const{	return m_storage.data()[posi];	}
+
+			 SC_CONSTEXPR20 reference operator[]( size_type n )
+			 {
+			 	if( n >= size() ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return m_storage.data()[n];
+			 }
+
+			 SC_CONSTEXPR20 const_reference at( size_type n ) const
+			 {
+			 	if( n >= size() ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return m_storage.data()[n];
+			 }
+
+			 SC_CONSTEXPR20 reference at( size_type n )
+			 {
+			 	if( n >= size() ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return m_storage.data()[n];
+			 }
+
+			 SC_CONSTEXPR20 pointer data( void ){	return m_storage.data();	}
+			 constexpr const T * data( void ) const{	return m_storage.data();	}
+
+//############################# [VI] Operators
+
+			 SC_CONSTEXPR20 bool operator== ( const static_vector & test_v ) const
+			 {
+			 	if( size() != test_v.size() ){	return false;	}
+			 	for( size_type i = 0; i != size(); ++i )
+			 	{
+			 		if( not ( data()[i] == test_v.data()[i] ) ){	return false;	}
+			 	}
+			 	return true;
+			 }
+
+			 SC_CONSTEXPR20 bool operator!= ( const static_vector & test_v ) const{	return not ( *this == test_v );	}
+	};
+};
+
+#endif
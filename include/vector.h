@@ -12,11 +12,414 @@
 #include <stdexcept> // std::out_of_range
 #include <initializer_list> // std::initializer_list<>
 #include <stdexcept>  // std::out_of_range
+#include <memory> // std::allocator, std::allocator_traits
+#include <algorithm> // std::copy, std::move, std::move_backward, std::fill_n
+#include <iterator> // std::make_move_iterator
+#include <type_traits> // std::is_nothrow_move_constructible
+#include <utility> // std::move, std::swap
+#include <cstring> // std::memcpy, std::memmove
+#include <cassert> // assert
+
+// Members that can run in constant expressions from C++20 on (static_vector, MyIterator).
+#if __cplusplus >= 202002L
+#	define SC_CONSTEXPR20 constexpr
+#else
+#	define SC_CONSTEXPR20
+#endif
+
+#include "simd.h" // sc::simd::mismatch, find, count, less
+#include "vector_stats.h" // sc::vector_stats, SC_VECTOR_STATS hooks
+
+#if defined( __has_include )
+#	if __has_include( <memory_resource> ) && __cplusplus >= 201703L
+#		include <memory_resource> // std::pmr::polymorphic_allocator
+#		define SC_HAS_PMR 1
+#	endif
+#endif
 
 
 namespace sc
 {
 
+	/*
+	 * Relocation layer.
+	 * Every bulk copy or shift of elements done by the containers goes through these functions.
+	 * For trivially copyable types they become a single memcpy/memmove, chosen at compile time,
+	 * otherwise the elements are constructed, moved and destroyed one by one through the allocator.
+	 */
+	namespace detail
+	{
+		/// Tells whether T can be copied byte by byte, skipping its constructors and destructor.
+		template < typename T >
+		using memcpyable = std::integral_constant< bool, std::is_trivially_copyable< T >::value >;
+
+		/// Keeps the (InputItr, InputItr) overloads out of calls like assign( 10, 7 ), meant for ( count, value ).
+		template < typename InputItr >
+		using require_iterator = typename std::enable_if< not std::is_integral< InputItr >::value >::type;
+
+		/// Keeps the overloads taking an execution policy (sc::par, see parallel.h) to types declaring is_execution_policy.
+		template < typename Policy >
+		using require_execution_policy = typename Policy::is_execution_policy;
+
+		/**
+		 * Tells whether Alloc can resize a block, possibly in place (realloc, mremap), through
+		 *     pointer reallocate( pointer ptr, size_type old_n, size_type new_n );
+		 * which keeps the first min(old_n, new_n) elements byte by byte and may move the block.
+		 */
+		template < typename Alloc, typename = void >
+		struct has_reallocate : std::false_type {};
+
+		template < typename Alloc >
+		struct has_reallocate< Alloc, decltype( (void) std::declval< Alloc & >().reallocate( nullptr, 0, 0 ) ) > : std::true_type {};
+
+		/// The containers resize their storage through Alloc::reallocate only when the bytes of T can be moved around.
+		template < typename T, typename Alloc >
+		using can_reallocate = std::integral_constant< bool, memcpyable< T >::value and has_reallocate< Alloc >::value >;
+
+		/**
+		 * @brief Calls the destructor of every element in [first, last).
+		 * 
+		 * @param alloc 
+		 * @param first 
+		 * @param last 
+		 */
+		template < typename Alloc, typename T >
+		void destroy( Alloc &, T *, T *, std::true_type ){ /* Trivially destructible, nothing to do */ }
+
+		template < typename Alloc, typename T >
+		void destroy( Alloc & alloc, T * first, T * last, std::false_type )
+		{
+			for( ; first != last; ++first ){	std::allocator_traits< Alloc >::destroy( alloc, first );	}
+		}
+
+		template < typename Alloc, typename T >
+		void destroy( Alloc & alloc, T * first, T * last ){	destroy( alloc, first, last, memcpyable< T >() );	}
+
+		/**
+		 * @brief Constructs each element of [first, last) into the raw storage pointed by dest.
+		 * If a constructor throws, the elements already built are destroyed.
+		 * 
+		 * @param alloc 
+		 * @param first 
+		 * @param last 
+		 * @param dest 
+		 */
+		template < typename Alloc, typename InputItr, typename T >
+		void construct_each( Alloc & alloc, InputItr first, InputItr last, T * dest )
+		{
+			T * current = dest;
+			try
+			{
+				for( ; first != last; ++first, ++current ){	std::allocator_traits< Alloc >::construct( alloc, current, *first );	}
+			}
+			catch( ... ){	destroy( alloc, dest, current ); throw;	}
+		}
+
+		/**
+		 * @brief Copy constructs the range [first, last) into the raw storage pointed by dest.
+		 * The ranges must not overlap. If a constructor throws, the elements already built are destroyed.
+		 * 
+		 * @param alloc 
+		 * @param first 
+		 * @param last 
+		 * @param dest 
+		 */
+		template < typename Alloc, typename InputItr, typename T >
+		void copy_construct( Alloc & alloc, InputItr first, InputItr last, T * dest ){	construct_each( alloc, first, last, dest );	}
+
+		template < typename Alloc, typename T >
+		void copy_construct( Alloc &, const T * first, const T * last, T * dest, std::true_type )
+		{
+			if( first != last ){	std::memcpy( static_cast< void * >( dest ), first, ( last - first ) * sizeof( T ) );	}
+		}
+
+		template < typename Alloc, typename T >
+		void copy_construct( Alloc & alloc, const T * first, const T * last, T * dest, std::false_type )
+		{
+			construct_each( alloc, first, last, dest );
+		}
+
+		template < typename Alloc, typename T >
+		void copy_construct( Alloc & alloc, const T * first, const T * last, T * dest )
+		{
+			copy_construct( alloc, first, last, dest, memcpyable< T >() );
+		}
+
+		template < typename Alloc, typename T >
+		void copy_construct( Alloc & alloc, T * first, T * last, T * dest )
+		{
+			copy_construct( alloc, static_cast< const T * >( first ), static_cast< const T * >( last ), dest, memcpyable< T >() );
+		}
+
+		/**
+		 * @brief Constructs n copies of value into the raw storage pointed by dest.
+		 * If a constructor throws, the elements already built are destroyed.
+		 * 
+		 * @param alloc 
+		 * @param dest 
+		 * @param n 
+		 * @param value 
+		 */
+		template < typename Alloc, typename T >
+		void fill_construct( Alloc & alloc, T * dest, std::size_t n, const T & value )
+		{
+			T * current = dest;
+			try
+			{
+				for( ; n != 0; --n, ++current ){	std::allocator_traits< Alloc >::construct( alloc, current, value );	}
+			}
+			catch( ... ){	destroy( alloc, dest, current ); throw;	}
+		}
+
+		/**
+		 * @brief Moves [first, last) into the raw storage pointed by dest, which must not overlap it.
+		 * The elements are copied instead when their move constructor may throw (std::move_if_noexcept), so a
+		 * failure leaves the source untouched. The source elements still have to be destroyed by the caller.
+		 * 
+		 * @param alloc 
+		 * @param first 
+		 * @param last 
+		 * @param dest 
+		 */
+		template < typename Alloc, typename T >
+		void relocate( Alloc & alloc, T * first, T * last, T * dest, std::true_type )
+		{
+			copy_construct( alloc, static_cast< const T * >( first ), static_cast< const T * >( last ), dest, std::true_type() );
+		}
+
+		template < typename Alloc, typename T >
+		void relocate( Alloc & alloc, T * first, T * last, T * dest, std::false_type )
+		{
+			T * current = dest;
+			try
+			{
+				for( ; first != last; ++first, ++current )
+				{
+					std::allocator_traits< Alloc >::construct( alloc, current, std::move_if_noexcept( *first ) );
+				}
+			}
+			catch( ... ){	destroy( alloc, dest, current ); throw;	}
+		}
+
+		template < typename Alloc, typename T >
+		void relocate( Alloc & alloc, T * first, T * last, T * dest ){	relocate( alloc, first, last, dest, memcpyable< T >() );	}
+
+		/**
+		 * @brief Shifts [first, last) n positions to the right, opening a gap of n slots at first.
+		 * [last, last + n) must be raw storage. Returns how many slots at the beginning of the gap still hold
+		 * an object (moved-from), which must be assigned to; the rest of the gap is raw storage to construct into.
+		 * 
+		 * @param alloc 
+		 * @param first 
+		 * @param last 
+		 * @param n 
+		 * @return std::size_t 
+		 */
+		template < typename Alloc, typename T >
+		std::size_t open_gap( Alloc &, T * first, T * last, std::size_t n, std::true_type )
+		{
+			const std::size_t count = last - first;
+			if( count != 0 ){	std::memmove( static_cast< void * >( first + n ), first, count * sizeof( T ) );	}
+
+			return std::min( count, n );
+		}
+
+		template < typename Alloc, typename T >
+		std::size_t open_gap( Alloc & alloc, T * first, T * last, std::size_t n, std::false_type )
+		{
+			const std::size_t count = last - first;
+			if( count > n )
+			{
+				// The last n elements go to raw storage, the others over elements that are alive.
+				construct_each( alloc, std::make_move_iterator( last - n ), std::make_move_iterator( last ), last );
+				std::move_backward( first, last - n, last );
+				return n;
+			}
+
+			construct_each( alloc, std::make_move_iterator( first ), std::make_move_iterator( last ), first + n );
+			return count;
+		}
+
+		template < typename Alloc, typename T >
+		std::size_t open_gap( Alloc & alloc, T * first, T * last, std::size_t n )
+		{
+			return open_gap( alloc, first, last, n, memcpyable< T >() );
+		}
+
+		/**
+		 * @brief Moves [first, last) down to dest, with dest < first, over elements that are alive.
+		 * The elements left behind at the end, [dest + (last - first), last), are destroyed.
+		 * 
+		 * @param alloc 
+		 * @param first 
+		 * @param last 
+		 * @param dest 
+		 */
+		template < typename Alloc, typename T >
+		void shift_left( Alloc &, T * first, T * last, T * dest, std::true_type )
+		{
+			if( first != last ){	std::memmove( static_cast< void * >( dest ), first, ( last - first ) * sizeof( T ) );	}
+		}
+
+		template < typename Alloc, typename T >
+		void shift_left( Alloc & alloc, T * first, T * last, T * dest, std::false_type )
+		{
+			destroy( alloc, std::move( first, last, dest ), last, std::false_type() );
+		}
+
+		template < typename Alloc, typename T >
+		void shift_left( Alloc & alloc, T * first, T * last, T * dest ){	shift_left( alloc, first, last, dest, memcpyable< T >() );	}
+
+		/**
+		 * @brief Moves the elements of [first, last) for which keep( pointer ) is true down to the front of the
+		 * range, in order and in a single pass, and returns the new end. keep is called once per element, in
+		 * order. Trivially copyable elements after the first removed one are each copied down, and the
+		 * destination only advances past the kept ones, with no branch on keep. The elements left in
+		 * [new end, last) are moved-from, still to be destroyed by the caller.
+		 * 
+		 * @param first 
+		 * @param last 
+		 * @param keep 
+		 * @return T* the new end
+		 */
+		template < typename T, typename Keep >
+		T * compact( T * first, T * last, Keep & keep, std::true_type )
+		{
+			// Skips the leading run of kept elements, which stay where they are.
+			T * dest = first;
+			while( dest != last and keep( dest ) ){	++dest;	}
+			if( dest == last ){	return dest;	}
+
+			// From the first removed element on, every element is copied down and dest only advances past the
+			// kept ones: no branch to mispredict on scattered removals.
+			for( first = dest + 1; first != last; ++first )
+			{
+				const bool kept = keep( first );
+				std::memcpy( static_cast< void * >( dest ), first, sizeof( T ) );
+				dest += kept;
+			}
+
+			return dest;
+		}
+
+		template < typename T, typename Keep >
+		T * compact( T * first, T * last, Keep & keep, std::false_type )
+		{
+			T * dest = first;
+
+			for( ; first != last; ++first )
+			{
+				if( keep( first ) )
+				{
+					if( dest != first ){	*dest = std::move( *first );	}
+					++dest;
+				}
+			}
+
+			return dest;
+		}
+
+		template < typename T, typename Keep >
+		T * compact( T * first, T * last, Keep & keep ){	return compact( first, last, keep, memcpyable< T >() );	}
+
+		// Keeps the elements for which pred is false.
+		template < typename T, typename Pred >
+		struct keep_unless
+		{
+			Pred pred;
+
+			bool operator()( T * element ){	return not pred( *element );	}
+		};
+
+		// Keeps the elements whose index, counted from base, is not in the ascending list [next, last).
+		template < typename T, typename IndexItr >
+		struct keep_unlisted
+		{
+			T * base;
+			IndexItr next;
+			IndexItr last;
+
+			bool operator()( T * element )
+			{
+				const std::size_t index = element - base;
+				bool listed = false;
+				for( ; next != last and static_cast< std::size_t >( *next ) <= index; ++next ){	listed = listed or static_cast< std::size_t >( *next ) == index;	}
+
+				return not listed;
+			}
+		};
+
+		// Allocator propagation, following the allocator_traits::propagate_on_container_* rules.
+
+		template < typename Alloc >
+		void propagate_copy( Alloc & to, const Alloc & from, std::true_type ){	to = from;	}
+		template < typename Alloc >
+		void propagate_copy( Alloc &, const Alloc &, std::false_type ){ /* Keeps its own allocator */ }
+
+		template < typename Alloc >
+		void propagate_move( Alloc & to, Alloc & from, std::true_type ){	to = std::move( from );	}
+		template < typename Alloc >
+		void propagate_move( Alloc &, Alloc &, std::false_type ){ /* Keeps its own allocator */ }
+
+		template < typename Alloc >
+		void propagate_swap( Alloc & lhs, Alloc & rhs, std::true_type ){	using std::swap; swap( lhs, rhs );	}
+		template < typename Alloc >
+		void propagate_swap( Alloc &, Alloc &, std::false_type ){ /* The allocators must be equal */ }
+	}
+
+	/*
+	 * Growth policies.
+	 * When an insertion finds the vector full, the new capacity is asked to the policy through
+	 *     static std::size_t grow( std::size_t capacity, std::size_t required, std::size_t element_size );
+	 * which must return at least `required` (the size the vector needs to hold).
+	 */
+
+	/// Doubles the capacity: fewest reallocations, up to 50% of the storage unused.
+	struct doubling_growth
+	{
+		static std::size_t grow( std::size_t capacity, std::size_t required, std::size_t /* element_size */ )
+		{
+			return std::max( required, capacity == 0 ? std::size_t( 1 ) : 2 * capacity );
+		}
+	};
+
+	/// Grows the capacity by 1.5: more reallocations than doubling, but the blocks freed by earlier
+	/// growths can add up to a later request, so the allocator is able to reuse them.
+	struct golden_growth
+	{
+		static std::size_t grow( std::size_t capacity, std::size_t required, std::size_t /* element_size */ )
+		{
+			return std::max( required, capacity + capacity / 2 + 1 );
+		}
+	};
+
+	/// Doubles the capacity, then rounds the storage up to whole pages once it spans more than one,
+	/// so the tail of the last page, which the system hands out anyway, is usable by the vector.
+	template < std::size_t PageSize = 4096 >
+	struct page_growth
+	{
+		static std::size_t grow( std::size_t capacity, std::size_t required, std::size_t element_size )
+		{
+			const std::size_t bytes = doubling_growth::grow( capacity, required, element_size ) * element_size;
+			if( bytes <= PageSize ){	return bytes / element_size;	}
+
+			return ( ( bytes + PageSize - 1 ) / PageSize * PageSize ) / element_size;
+		}
+	};
+
+	/// Adds Increment elements on each growth: bounded memory overhead for memory constrained nodes,
+	/// at the cost of a quadratic number of element moves on long runs of push_back.
+	template < std::size_t Increment >
+	struct fixed_growth
+	{
+		static_assert( Increment > 0, "sc::fixed_growth needs a positive increment" );
+
+		static std::size_t grow( std::size_t capacity, std::size_t required, std::size_t /* element_size */ )
+		{
+			return std::max( required, capacity + Increment );
+		}
+	};
+
 	template <typename T>
 		class MyIterator
 		{
@@ -24,13 +427,19 @@ namespace sc
 				
 				typedef std::ptrdiff_t difference_type;
 				typedef T& reference;
-				typedef T value_type;
+				typedef typename std::remove_const< T >::type value_type;
 				typedef T* pointer;
         /// Identificar a categoria do iterador para algoritmos do STL.
-        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef std::random_access_iterator_tag iterator_category;
+#if __cplusplus >= 202002L
+        /// The elements are contiguous, std::to_address and the ranges algorithms can use the raw pointer.
+        typedef std::contiguous_iterator_tag iterator_concept;
+#endif
 			
 			private:
 				T * current; 
+
+				template < typename U > friend class MyIterator;
 			
 			public:
 		
@@ -39,8 +448,15 @@ namespace sc
 				 * 
 				 * @param ptr 
 				 */
-				MyIterator(T * ptr = nullptr ): current(ptr){ /* empty */ }
+				SC_CONSTEXPR20 MyIterator(T * ptr = nullptr ): current(ptr){ /* empty */ }
 
+				/**
+				 * @brief Converts an Iterator into a const_iterator.
+				 * 
+				 * @param other 
+				 */
+				template < typename U, typename = typename std::enable_if< std::is_convertible< U *, T * >::value >::type >
+				SC_CONSTEXPR20 MyIterator( const MyIterator< U > & other ): current(other.current){ /* empty */ }
 				
 				/**
 				 * @brief Destroy the My Iterator object
@@ -48,40 +464,55 @@ namespace sc
 				 */
 				~MyIterator() = default;
 
+				/**
+				 * @brief Returns the raw pointer to the element, also valid for the end iterator.
+				 * 
+				 * @return pointer 
+				 */
+				SC_CONSTEXPR20 pointer base( void ) const{	return current;	}
+
 				/*	Operators	*/
 
 				/**
-				 * @brief as in *it : return a reference to the object located at the position pointed by the iterator. The reference may or may not be modifiable.
+				 * @brief as in *it : return a reference to the object located at the position pointed by the iterator. It is modifiable unless T is const.
 				 * 
-				 * @return const T& 
+				 * @return T& 
 				 */
-				const T & operator* ( ) const{ return *current; }
+				SC_CONSTEXPR20 reference operator* ( ) const{ return *current; }
 				
 				/**
 				 * @brief 
 				 * 
 				 * @return pointer 
 				 */
-				pointer operator ->( void ) const { assert( current != nullptr ); return current; }
+				SC_CONSTEXPR20 pointer operator ->( void ) const { assert( current != nullptr ); return current; }
+
+				/**
+				 * @brief as in it[n] : return a reference to the object n positions after the iterator.
+				 * 
+				 * @param n 
+				 * @return T& 
+				 */
+				SC_CONSTEXPR20 reference operator[] ( difference_type n ) const{ return current[n]; }
 				
 				/**
 				 * @brief advances iterator to the next location within the list. We should provide both prefix and posfix form, or ++it and it++
 				 * 
 				 * @return MyIterator& 
 				 */
-				MyIterator & operator++( ){	current++;	return *this;	}
+				SC_CONSTEXPR20 MyIterator & operator++( ){	current++;	return *this;	}
 				
 				/**
 				 * @brief advances iterator to the next location within the list. We should provide both prefix and posfix form, or ++it and it++
 				 * 
-				 * @return MyIterator& 
+				 * @return MyIterator, pointing to the previous location 
 				 */
-				MyIterator & operator++( int )
+				SC_CONSTEXPR20 MyIterator operator++( int )
 				{
 					MyIterator temp = *this;
 					current++;
 
-					return temp; // this
+					return temp;
 				}
 				
 				/**
@@ -89,21 +520,37 @@ namespace sc
 				 * 
 				 * @return MyIterator& 
 				 */
-				MyIterator & operator-- ( ){	current--;	return *this;	}
+				SC_CONSTEXPR20 MyIterator & operator-- ( ){	current--;	return *this;	}
 				
 				/**
 				 * @brief reduces iterator to the previous location within the list. We should provide both prefix and posfix form, or --it and it--
 				 * 
-				 * @return MyIterator& 
+				 * @return MyIterator, pointing to the previous location 
 				 */
-				MyIterator & operator--( int )
+				SC_CONSTEXPR20 MyIterator operator--( int )
 				{
 					MyIterator temp = *this;
 					current--;
 
-					return temp; // this
+					return temp;
 				}
 
+				/**
+				 * @brief as in it += n : advances iterator n locations.
+				 * 
+				 * @param n 
+				 * @return MyIterator& 
+				 */
+				SC_CONSTEXPR20 MyIterator & operator+=( difference_type n ){	current += n;	return *this;	}
+
+				/**
+				 * @brief as in it -= n : reduces iterator n locations.
+				 * 
+				 * @param n 
+				 * @return MyIterator& 
+				 */
+				SC_CONSTEXPR20 MyIterator & operator-=( difference_type n ){	current -= n;	return *this;	}
+
 				/**
 				 * @brief returns the iterator to position it+n, we should provide both prefix and posfix form it+n and n+it.
 				 * 
@@ -111,7 +558,7 @@ namespace sc
 				 * @param it 
 				 * @return MyIterator 
 				 */
-				friend MyIterator operator +( difference_type n, MyIterator it){ return n+it.current; }
+				friend SC_CONSTEXPR20 MyIterator operator +( difference_type n, MyIterator it){ return n+it.current; }
 				
 				/**
 				 * @brief returns the iterator to position it+n, we should provide both prefix and posfix form it+n and n+it.
@@ -120,54 +567,83 @@ namespace sc
 				 * @param n 
 				 * @return MyIterator 
 				 */
-				friend MyIterator operator +( MyIterator it, difference_type n){ return it.current+n; }
+				friend SC_CONSTEXPR20 MyIterator operator +( MyIterator it, difference_type n){ return it.current+n; }
 				
 				/**
-				 * @brief returns the iterator to position it-n, we should provide both prefix and posfix form it-n and n-it.
+				 * @brief returns the iterator to position it-n.
 				 * 
-				 * @param n 
 				 * @param it 
+				 * @param n 
 				 * @return MyIterator 
 				 */
-				friend MyIterator operator -( difference_type n, MyIterator it){ return n-it.current;}
-				
+				friend SC_CONSTEXPR20 MyIterator operator -( MyIterator it, difference_type n){ return it.current-n;}
+
 				/**
-				 * @brief returns the iterator to position it-n, we should provide both prefix and posfix form it-n and n-it.
+				 * @brief as in it1 - it2 : returns the number of locations between both iterators, in O(1).
 				 * 
-				 * @param it 
-				 * @param n 
-				 * @return MyIterator 
+				 * @param lhs 
+				 * @param rhs 
+				 * @return difference_type 
 				 */
-				friend MyIterator operator -( MyIterator it, difference_type n){ return it.current-n;}
+				friend SC_CONSTEXPR20 difference_type operator -( const MyIterator & lhs, const MyIterator & rhs ){ return lhs.current - rhs.current; }
 
 				/**
 				 * @brief as in it1 == it2 : returns true if both iterators refer to the same location within the list, and false otherwise
 				 * 
+				 * @param lhs 
 				 * @param rhs 
 				 * @return true 
 				 * @return false 
 				 */
-				bool operator== ( const MyIterator & rhs) const{ return current == rhs.current; }
+				friend SC_CONSTEXPR20 bool operator== ( const MyIterator & lhs, const MyIterator & rhs ){ return lhs.current == rhs.current; }
 				
 				/**
 				 * @brief as in it1 != it2 : returns true if both iterators refer to a different location within the list, and false otherwise.
 				 * 
+				 * @param lhs 
 				 * @param rhs 
 				 * @return true 
 				 * @return false 
 				 */
-				bool operator != ( const MyIterator & rhs) const{ return current != rhs.current; }
+				friend SC_CONSTEXPR20 bool operator != ( const MyIterator & lhs, const MyIterator & rhs ){ return lhs.current != rhs.current; }
 
-			
+				/**
+				 * @brief as in it1 < it2 : returns true if it1 refers to a location before it2.
+				 * 
+				 * @param lhs 
+				 * @param rhs 
+				 * @return true 
+				 * @return false 
+				 */
+				friend SC_CONSTEXPR20 bool operator< ( const MyIterator & lhs, const MyIterator & rhs ){ return lhs.current < rhs.current; }
+				friend SC_CONSTEXPR20 bool operator> ( const MyIterator & lhs, const MyIterator & rhs ){ return lhs.current > rhs.current; }
+				friend SC_CONSTEXPR20 bool operator<= ( const MyIterator & lhs, const MyIterator & rhs ){ return lhs.current <= rhs.current; }
+				friend SC_CONSTEXPR20 bool operator>= ( const MyIterator & lhs, const MyIterator & rhs ){ return lhs.current >= rhs.current; }
 
 		};
 
-	template <typename T>
+	namespace detail
+	{
+		/*
+		 * Ranges given by MyIterator are copied through their raw pointers, which take the memcpy path
+		 * for trivially copyable types.
+		 */
+		template < typename Alloc, typename U, typename T >
+		void copy_construct( Alloc & alloc, MyIterator< U > first, MyIterator< U > last, T * dest )
+		{
+			copy_construct( alloc, first.base(), last.base(), dest );
+		}
+	}
+
+	template < typename T, typename Allocator = std::allocator< T >, typename Growth = doubling_growth >
 	class vector 
 	{
 		
 		public:
 			
+			typedef Allocator allocator_type;
+			typedef Growth growth_policy;
+			typedef std::allocator_traits< allocator_type > alloc_traits;
 			typedef size_t size_type;
 			const static size_type DEFAULT_SIZE = 0;
 			typedef T value_type ;
@@ -177,11 +653,429 @@ namespace sc
 			typedef const T& const_reference; 
 			typedef T* pointer;
 
+			static_assert( std::is_same< typename alloc_traits::pointer, pointer >::value,
+					"sc::vector needs an allocator that hands out raw pointers" );
+
 		private:
+#ifdef SC_VECTOR_STATS
+			vector_stats m_stats = vector_stats(); //<! Counters of this vector, first so the allocations of the constructors count.
+#endif
+			allocator_type m_alloc; //<! Allocator of the storage, also used to construct the elements.
 			size_type m_end; //<! Current list size (or index past-last valid elemen>
 			size_type m_capacity; //<! List’s storage capacity.
 			pointer m_storage; //<! Data storage area for the dynamic array.
 
+			// Only the slots in [0, m_end) hold constructed objects, the rest of
+			// [0, m_capacity) is raw memory.
+
+			// Instrumentation hooks (see vector_stats.h), empty unless SC_VECTOR_STATS is defined.
+#ifdef SC_VECTOR_STATS
+			void note_allocation( size_type n ){	detail::record_allocation( m_stats, this, n * sizeof( value_type ) );	}
+
+			void note_reallocation( size_type old_capacity, size_type new_capacity, size_type moved )
+			{
+				detail::record_reallocation( m_stats, this, old_capacity * sizeof( value_type ), new_capacity * sizeof( value_type ), moved * sizeof( value_type ) );
+			}
+
+			void note_shift( size_type moved ){	if( moved != 0 ){	detail::record_shift( m_stats, this, moved, sizeof( value_type ) );	}	}
+#else
+			void note_allocation( size_type ){	/* Empty */	}
+			void note_reallocation( size_type, size_type, size_type ){	/* Empty */	}
+			void note_shift( size_type ){	/* Empty */	}
+#endif
+
+			/**
+			 * @brief Allocates raw storage for n elements, none of them is constructed.
+			 * 
+			 * @param n 
+			 * @return pointer 
+			 */
+			pointer allocate( size_type n )
+			{
+				pointer block = alloc_traits::allocate( m_alloc, n );
+				note_allocation( n );
+				return block;
+			}
+
+			/**
+			 * @brief Releases storage of n elements obtained from allocate(). The elements must be destroyed already.
+			 * 
+			 * @param ptr 
+			 * @param n 
+			 */
+			void deallocate( pointer ptr, size_type n )
+			{
+				if( ptr != nullptr ){	alloc_traits::deallocate( m_alloc, ptr, n );	}
+			}
+
+			/**
+			 * @brief Constructs an element in the raw slot pointed by ptr, forwarding args to its constructor.
+			 * 
+			 * @param ptr 
+			 * @param args 
+			 */
+			template < typename... Args >
+			void construct_at( pointer ptr, Args&&... args )
+			{
+				alloc_traits::construct( m_alloc, ptr, std::forward< Args >( args )... );
+			}
+
+			/**
+			 * @brief Calls the destructor of every element in [first, last).
+			 * 
+			 * @param first 
+			 * @param last 
+			 */
+			void destroy( pointer first, pointer last ){	detail::destroy( m_alloc, first, last );	}
+
+			/**
+			 * @brief Copy constructs the range [first, last) into the raw storage of n elements pointed by dest.
+			 * If a constructor throws, dest is released and the exception is propagated.
+			 * 
+			 * @tparam InputItr 
+			 * @param first 
+			 * @param last 
+			 * @param dest 
+			 * @param n 
+			 */
+			template < typename InputItr >
+			void construct_into( InputItr first, InputItr last, pointer dest, size_type n )
+			{
+				try{	detail::copy_construct( m_alloc, first, last, dest );	}
+				catch( ... ){	deallocate( dest, n ); throw;	}
+			}
+
+			/**
+			 * @brief Relocates the range [first, last) into the raw storage of n elements pointed by dest
+			 * (see detail::relocate). If a constructor throws, dest is released and the exception is propagated.
+			 * 
+			 * @param first 
+			 * @param last 
+			 * @param dest 
+			 * @param n 
+			 */
+			void relocate_into( pointer first, pointer last, pointer dest, size_type n )
+			{
+				try{	detail::relocate( m_alloc, first, last, dest );	}
+				catch( ... ){	deallocate( dest, n ); throw;	}
+			}
+
+			/**
+			 * @brief Resizes the storage to new_capacity through the allocator's reallocate(), which can
+			 * extend the block in place instead of copying it. Returns false, doing nothing, when the
+			 * allocator has no reallocate() or the elements are not trivially copyable.
+			 * 
+			 * @param new_capacity 
+			 * @return Whether the storage was resized.
+			 */
+			bool reallocate_storage( size_type new_capacity ){	return reallocate_storage( new_capacity, detail::can_reallocate< value_type, allocator_type >() );	}
+
+			bool reallocate_storage( size_type new_capacity, std::true_type )
+			{
+				pointer old_storage = m_storage;
+				m_storage = m_alloc.reallocate( m_storage, m_capacity, new_capacity );
+				note_reallocation( m_capacity, new_capacity, m_storage == old_storage ? 0 : m_end );
+				m_capacity = new_capacity;
+				return true;
+			}
+
+			bool reallocate_storage( size_type, std::false_type ){	return false;	}
+
+			/**
+			 * @brief Runs f( begin, end ) over the chunks of [0, n) through policy when Parallel is true, otherwise
+			 * once over the whole range on the calling thread: when the elements can throw while being built, a
+			 * failing chunk couldn't undo the chunks built by the other threads.
+			 * 
+			 * @param policy 
+			 * @param n 
+			 * @param f 
+			 */
+			template < typename Policy, typename Function >
+			static void run_chunks( const Policy & policy, size_type n, Function f, std::true_type ){	policy.run( n, sizeof( value_type ), f );	}
+
+			template < typename Policy, typename Function >
+			static void run_chunks( const Policy &, size_type n, Function f, std::false_type ){	f( 0, n );	}
+
+			/**
+			 * @brief Constructs count copies of value into the raw storage pointed by dest, chunk by chunk through policy.
+			 * 
+			 * @param policy 
+			 * @param dest 
+			 * @param count 
+			 * @param value 
+			 */
+			template < typename Policy >
+			void fill_construct( const Policy & policy, pointer dest, size_type count, const_reference value )
+			{
+				allocator_type & alloc = m_alloc;
+				run_chunks( policy, count, [&alloc, dest, &value]( size_type begin, size_type end ){	detail::fill_construct( alloc, dest + begin, end - begin, value );	},
+						std::is_nothrow_copy_constructible< value_type >() );
+			}
+
+			/// assign( policy, count, ref ), in parallel only when copying ref can't throw.
+			template < typename Policy >
+			void assign( const Policy &, size_type count, const_reference ref, std::false_type ){	assign( count, ref );	}
+
+			template < typename Policy >
+			void assign( const Policy & policy, size_type count, const_reference ref, std::true_type )
+			{
+				// ref may point into the vector, whose elements are destroyed before the new ones are built.
+				const value_type value( ref );
+				pointer temporary = count > m_capacity ? allocate( count ) : m_storage;
+
+				destroy( m_storage, m_storage + m_end );
+				m_end = 0;
+				if( temporary != m_storage )
+				{
+					deallocate( m_storage, m_capacity );
+					m_storage = temporary;
+					m_capacity = count;
+				}
+
+				fill_construct( policy, m_storage, count, value );
+				m_end = count;
+			}
+
+			/**
+			 * @brief Returns the index of the element pointed by position.
+			 * 
+			 * @param position 
+			 * @return size_type 
+			 */
+			size_type index_of( const_iterator position ) const{	return position - cbegin();	}
+
+			/**
+			 * @brief Inserts an element constructed from args at index when the storage is full, with a
+			 * single reallocation: the new element is built first (args may refer to the old storage), and
+			 * the old elements are relocated around it.
+			 * 
+			 * @param index 
+			 * @param args 
+			 */
+			template < typename... Args >
+			void realloc_emplace( size_type index, Args&&... args )
+			{
+				realloc_emplace( detail::can_reallocate< value_type, allocator_type >(), index, std::forward< Args >( args )... );
+			}
+
+			template < typename... Args >
+			void realloc_emplace( std::true_type, size_type index, Args&&... args )
+			{
+				if( index != m_end ){	realloc_emplace( std::false_type(), index, std::forward< Args >( args )... ); return;	}
+
+				// Appending grows the storage in place; args may refer to it, so the element is built first.
+				value_type value( std::forward< Args >( args )... );
+				reallocate_storage( growth_policy::grow( m_capacity, m_end + 1, sizeof( value_type ) ) );
+				construct_at( m_storage + m_end, value );
+				++m_end;
+			}
+
+			template < typename... Args >
+			void realloc_emplace( std::false_type, size_type index, Args&&... args )
+			{
+				const size_type new_capacity = growth_policy::grow( m_capacity, m_end + 1, sizeof( value_type ) );
+				pointer temporary = allocate( new_capacity );
+
+				try{	construct_at( temporary + index, std::forward< Args >( args )... );	}
+				catch( ... ){	deallocate( temporary, new_capacity ); throw;	}
+
+				relocate_around( temporary, new_capacity, index, 1 );
+			}
+
+			/**
+			 * @brief Inserts the n elements of [first, last) at index in a new storage of the capacity chosen
+			 * by the growth policy, with a single reallocation.
+			 * 
+			 * @param index 
+			 * @param first 
+			 * @param last 
+			 * @param n 
+			 */
+			template < typename ForwardItr >
+			void realloc_insert( size_type index, ForwardItr first, ForwardItr last, size_type n )
+			{
+				const size_type new_capacity = growth_policy::grow( m_capacity, m_end + n, sizeof( value_type ) );
+				pointer temporary = allocate( new_capacity );
+
+				construct_into( first, last, temporary + index, new_capacity );
+				relocate_around( temporary, new_capacity, index, n );
+			}
+
+			/**
+			 * @brief Finishes a reallocating insertion: temporary (with room for new_capacity elements) already
+			 * holds the n new elements at index, the old elements are relocated before and after them and
+			 * temporary becomes the storage of the vector.
+			 * 
+			 * @param temporary 
+			 * @param new_capacity 
+			 * @param index 
+			 * @param n 
+			 */
+			void relocate_around( pointer temporary, size_type new_capacity, size_type index, size_type n )
+			{
+				try
+				{
+					detail::relocate( m_alloc, m_storage, m_storage + index, temporary );
+					try{	detail::relocate( m_alloc, m_storage + index, m_storage + m_end, temporary + index + n );	}
+					catch( ... ){	destroy( temporary, temporary + index ); throw;	}
+				}
+				catch( ... )
+				{
+					destroy( temporary + index, temporary + index + n );
+					deallocate( temporary, new_capacity );
+					throw;
+				}
+
+				note_reallocation( m_capacity, new_capacity, m_end );
+				destroy( m_storage, m_storage + m_end );
+				deallocate( m_storage, m_capacity );
+				m_storage = temporary;
+				m_capacity = new_capacity;
+				m_end += n;
+			}
+
+			/**
+			 * @brief Range insertion for forward iterators: the distance is computed once, and the elements
+			 * are constructed in place with at most one reallocation.
+			 * 
+			 * @param index 
+			 * @param first 
+			 * @param last 
+			 */
+			template < typename ForwardItr >
+			void insert_range( size_type index, ForwardItr first, ForwardItr last, std::forward_iterator_tag )
+			{
+				const size_type n = std::distance( first, last );
+				if( n == 0 ){	return;	}
+
+				if( m_end + n > m_capacity ){	realloc_insert( index, first, last, n );	return;	}
+
+				// The first `alive` slots of the gap hold moved-from elements, the remaining ones are raw.
+				const size_type alive = detail::open_gap( m_alloc, m_storage + index, m_storage + m_end, n );
+				note_shift( m_end - index );
+				auto middle = first;
+				std::advance( middle, alive );
+
+				std::copy( first, middle, m_storage + index );
+				detail::copy_construct( m_alloc, middle, last, m_storage + index + alive );
+				m_end += n;
+			}
+
+			/**
+			 * @brief Range insertion for input iterators, which can be read only once: the elements are
+			 * appended and then rotated into position.
+			 * 
+			 * @param index 
+			 * @param first 
+			 * @param last 
+			 */
+			template < typename InputItr >
+			void insert_range( size_type index, InputItr first, InputItr last, std::input_iterator_tag )
+			{
+				const size_type old_end = m_end;
+				for( ; first != last; ++first ){	emplace_back( *first );	}
+
+				std::rotate( m_storage + index, m_storage + old_end, m_storage + m_end );
+			}
+
+			/**
+			 * @brief Range assignment for forward iterators: the range is measured once with std::distance
+			 * (O(1) for random access ones), then copied over the live elements and into the raw slots.
+			 * 
+			 * @param first 
+			 * @param last 
+			 */
+			template < typename ForwardItr >
+			void assign_range( ForwardItr first, ForwardItr last, std::forward_iterator_tag )
+			{
+				const size_type dist = std::distance( first, last );
+
+				if( dist > m_capacity )
+				{
+					pointer temporary = allocate(dist);
+					construct_into( first, last, temporary, dist );
+
+					destroy( m_storage, m_storage + m_end );
+					deallocate( m_storage, m_capacity );
+					m_storage = temporary;
+					m_capacity = dist;
+				}
+				else if( dist > m_end )
+				{
+					auto middle = first;
+					for( auto i(0u); i < m_end; ++i, ++middle ){	m_storage[i] = *middle;	}
+					detail::copy_construct( m_alloc, middle, last, m_storage + m_end );
+				}
+				else
+				{
+					std::copy( first, last, m_storage );
+					destroy( m_storage + dist, m_storage + m_end );
+				}
+
+				m_end = dist;
+			}
+
+			/**
+			 * @brief Range assignment for input iterators, which can be read only once: the elements are
+			 * cleared and the range is appended one by one.
+			 * 
+			 * @param first 
+			 * @param last 
+			 */
+			template < typename InputItr >
+			void assign_range( InputItr first, InputItr last, std::input_iterator_tag )
+			{
+				clear();
+				for( ; first != last; ++first ){	emplace_back( *first );	}
+			}
+
+			/**
+			 * @brief Makes room for at least `required` elements, with the capacity chosen by the growth policy.
+			 * 
+			 * @param required 
+			 */
+			void grow( size_type required )
+			{
+				if( required > m_capacity ){	reserve( growth_policy::grow( m_capacity, required, sizeof( value_type ) ) );	}
+			}
+
+			/**
+			 * @brief Move assignment when the storage of model can be taken over: the allocator propagates
+			 * or both allocators are interchangeable.
+			 * 
+			 * @param model 
+			 */
+			void move_assign( vector & model, std::true_type )
+			{
+				destroy( m_storage, m_storage + m_end );
+				deallocate( m_storage, m_capacity );
+				detail::propagate_move( m_alloc, model.m_alloc, typename alloc_traits::propagate_on_container_move_assignment() );
+
+				m_end = model.m_end;
+				m_capacity = model.m_capacity;
+				m_storage = model.m_storage;
+
+				model.m_end = 0;
+				model.m_capacity = 0;
+				model.m_storage = nullptr;
+			}
+
+			/**
+			 * @brief Move assignment when the allocator doesn't propagate: the storage is taken over only if
+			 * both allocators compare equal, otherwise the elements are moved one by one.
+			 * 
+			 * @param model 
+			 */
+			void move_assign( vector & model, std::false_type )
+			{
+				if( m_alloc == model.m_alloc ){	move_assign( model, std::true_type() );	}
+				else
+				{
+					assign( std::make_move_iterator( model.m_storage ), std::make_move_iterator( model.m_storage + model.m_end ) );
+					model.clear();
+				}
+			}
+
 		public:
 
 //############################# [I] SPECIAL MEMBERS
@@ -192,19 +1086,37 @@ namespace sc
 			  * @brief Constructs an empty container, with no elements.
 			  * 
 			  */
-			 vector( ): m_end(0), m_capacity(DEFAULT_SIZE), m_storage(new value_type[m_capacity]){	/* Empty */	}
+			 vector( ): m_alloc(), m_end(0), m_capacity(DEFAULT_SIZE), m_storage(allocate(m_capacity)){	/* Empty */	}
+
+			 /**
+			  * @brief Constructs an empty container, with no elements, that allocates through alloc.
+			  * 
+			  * @param alloc 
+			  */
+			 explicit vector( const allocator_type & alloc ): m_alloc(alloc), m_end(0), m_capacity(DEFAULT_SIZE), m_storage(allocate(m_capacity)){	/* Empty */	}
 
 			 /**
 			  * @brief Constructs a container with a copy of each of the elements in model, in the same order.
 			  * 
 			  * @param model 
 			  */
-			 vector(const vector & model):m_end(model.m_end), m_capacity(model.m_capacity), m_storage(new value_type[m_capacity])
+			 vector(const vector & model):m_alloc(alloc_traits::select_on_container_copy_construction(model.m_alloc)),
+			 	m_end(model.m_end), m_capacity(model.m_capacity), m_storage(allocate(m_capacity))
 			 {
-			 	for(auto i(0u); i != m_end; ++i)
-			 	{
-					m_storage[i] = model.m_storage[i];
-			 	}
+			 	construct_into( model.m_storage, model.m_storage + m_end, m_storage, m_capacity );
+			 }
+
+			 /**
+			  * @brief Constructs a container that takes over the storage of model, leaving model empty
+			  * and with no capacity.
+			  * 
+			  * @param model 
+			  */
+			 vector(vector && model) noexcept : m_alloc(std::move(model.m_alloc)), m_end(model.m_end), m_capacity(model.m_capacity), m_storage(model.m_storage)
+			 {
+			 	model.m_end = 0;
+			 	model.m_capacity = 0;
+			 	model.m_storage = nullptr;
 			 }
 
 			 
@@ -212,35 +1124,70 @@ namespace sc
 			  * @brief Constructs a container with capacity equal to n
 			  * 
 			  * @param n 
+			  * @param alloc 
+			  */
+			 vector(size_type n, const allocator_type & alloc = allocator_type()): m_alloc(alloc), m_end(0), m_capacity(n), m_storage (allocate(m_capacity)){ /* Empty */ }
+
+			 /**
+			  * @brief Constructs a container with count copies of value, built in parallel chunks by policy (sc::par)
+			  * when copying value can't throw.
+			  * 
+			  * @param policy 
+			  * @param count 
+			  * @param value 
+			  * @param alloc 
+			  */
+			 template < typename Policy, typename = detail::require_execution_policy< Policy > >
+			 vector( const Policy & policy, size_type count, const_reference value, const allocator_type & alloc = allocator_type() ):
+			 	m_alloc(alloc), m_end(0), m_capacity(count), m_storage(allocate(m_capacity))
+			 {
+			 	try{	fill_construct( policy, m_storage, count, value );	}
+			 	catch( ... ){	deallocate( m_storage, m_capacity ); throw;	}
+			 	m_end = count;
+			 }
+
+			 /**
+			  * @brief Copy constructor whose elements are copied in parallel chunks by policy (sc::par) when copying
+			  * them can't throw.
+			  * 
+			  * @param policy 
+			  * @param model 
 			  */
-			 vector(size_type n): m_end(0), m_capacity(n), m_storage (new value_type[m_capacity]){ /* Empty */ }
+			 template < typename Policy, typename = detail::require_execution_policy< Policy > >
+			 vector( const Policy & policy, const vector & model ):m_alloc(alloc_traits::select_on_container_copy_construction(model.m_alloc)),
+			 	m_end(0), m_capacity(model.m_capacity), m_storage(allocate(m_capacity))
+			 {
+			 	allocator_type & alloc = m_alloc;
+			 	pointer from = model.m_storage, dest = m_storage;
+
+			 	try
+			 	{
+			 		run_chunks( policy, model.m_end, [&alloc, from, dest]( size_type begin, size_type end ){	detail::copy_construct( alloc, from + begin, from + end, dest + begin );	},
+			 				std::is_nothrow_copy_constructible< value_type >() );
+			 	}
+			 	catch( ... ){	deallocate( m_storage, m_capacity ); throw;	}
+			 	m_end = model.m_end;
+			 }
 
 			 /**
 			  * @brief  Constructs a container with as many elements as the range [first,last), with each element 
 				* constructed from its corresponding element in that range, in the same order.
 			  * @param first 
 			  * @param last 
+			  * @param alloc 
 			  * @return template < typename InputItr > 
 			  */
-			 template < typename InputItr >
-			 vector( InputItr first, InputItr last)
+			 template < typename InputItr, typename = detail::require_iterator< InputItr > >
+			 vector( InputItr first, InputItr last, const allocator_type & alloc = allocator_type()): m_alloc(alloc)
 			 {
-			 	size_type dist(0);
-			 	auto r = first;
+			 	// O(1) for random access iterators.
+			 	const size_type dist = std::distance( first, last );
 
-			 	while( r != last){	dist++; r++;	}
+				m_storage = allocate(dist);
+				construct_into( first, last, m_storage, dist );
 
 			 	m_end = dist;
 				m_capacity= dist;
-				m_storage = new value_type[m_capacity];
-
-				auto it(first);
-
-				for (auto i(0u); i < dist; ++i, ++it)
-				{
-					m_storage[i] = *it;
-				}
-
 			 }
 
 			 
@@ -248,20 +1195,15 @@ namespace sc
 			  * @brief Construct a new vector object
 			  * 
 			  * @param ilist 
+			  * @param alloc 
 			  */
 			 /*		Constructor from  initializer List 	*/
 			 
-			 vector(std::initializer_list<T>  ilist):
-			 	vector(ilist.size())
+			 vector(std::initializer_list<T>  ilist, const allocator_type & alloc = allocator_type()):
+			 	vector(ilist.size(), alloc)
 			 {
+			 	detail::copy_construct( m_alloc, ilist.begin(), ilist.end(), m_storage );
 			 	m_end = ilist.size();
-			 	auto count(0);
-			 	
-			 	for (auto &element : ilist)
-				{
-					m_storage[count] = element;
-					++count;
-				}
 			 } 
 
 			/**
@@ -269,7 +1211,11 @@ namespace sc
 			 * 
 			 */
 			 //Destructor:
-			 ~vector( ) {	delete [] m_storage;	}
+			 ~vector( )
+			 {
+			 	destroy( m_storage, m_storage + m_end );
+			 	deallocate( m_storage, m_capacity );
+			 }
 			 
 			 /**
 			  * @brief Assigns new contents to the container, replacing its current contents,
@@ -280,15 +1226,71 @@ namespace sc
 			  */
 			 vector & operator= ( const vector & model)
 			 {
+			 	if( this == &model ){	return *this;	}
+
+			 	// With a propagating allocator the new storage already comes from the allocator of model.
+			 	const bool propagate = alloc_traits::propagate_on_container_copy_assignment::value;
+			 	allocator_type alloc( propagate ? model.m_alloc : m_alloc );
+
+			 	pointer temporary = alloc_traits::allocate( alloc, model.m_capacity );
+			 	note_allocation( model.m_capacity );
+			 	try{	detail::copy_construct( alloc, model.m_storage, model.m_storage + model.m_end, temporary );	}
+			 	catch( ... ){	alloc_traits::deallocate( alloc, temporary, model.m_capacity ); throw;	}
+
+			 	destroy( m_storage, m_storage + m_end );
+			 	deallocate( m_storage, m_capacity );
+			 	detail::propagate_copy( m_alloc, model.m_alloc, typename alloc_traits::propagate_on_container_copy_assignment() );
+
 			 	m_end = model.m_end;
 			 	m_capacity = model.m_capacity;
-			 	m_storage = new value_type[m_capacity];
+			 	m_storage = temporary;
+
+			 	return *this;
+			 }
+
+			 /**
+			  * @brief Replaces the contents with the ones of model by taking over its storage, leaving
+			  * model empty and with no capacity. If the allocators don't propagate and compare different,
+			  * the elements are moved one by one instead.
+			  * 
+			  * @param model a vector object of the same type
+			  * @return vector& 
+			  */
+			 vector & operator= ( vector && model) noexcept( alloc_traits::propagate_on_container_move_assignment::value ||
+			 		alloc_traits::is_always_equal::value )
+			 {
+			 	if( this == &model ){	return *this;	}
 
-			 	for (auto i(0u); i != m_end; ++i){	m_storage[i] = model.m_storage[i];	}
+			 	move_assign( model, std::integral_constant< bool, alloc_traits::propagate_on_container_move_assignment::value ||
+			 			alloc_traits::is_always_equal::value >() );
 
 			 	return *this;
 			 }
 
+			 /**
+			  * @brief Returns a copy of the allocator associated with the vector.
+			  * 
+			  * @return allocator_type 
+			  */
+			 allocator_type get_allocator( void ) const{	return m_alloc;	}
+
+			 /**
+			  * @brief Counters of this vector since it was constructed (see vector_stats.h). They stay at zero
+			  * unless SC_VECTOR_STATS is defined; wasted_bytes is the capacity not holding elements right now.
+			  * 
+			  * @return vector_stats 
+			  */
+			 vector_stats stats( void ) const
+			 {
+#ifdef SC_VECTOR_STATS
+			 	vector_stats current = m_stats;
+#else
+			 	vector_stats current = vector_stats();
+#endif
+			 	current.wasted_bytes = ( m_capacity - m_end ) * sizeof( value_type );
+			 	return current;
+			 }
+
 
 //############################# [II] IteratorS
 			 
@@ -297,28 +1299,42 @@ namespace sc
 			  * 
 			  * @return Iterator 
 			  */
-			 Iterator begin( void ){	return Iterator(&m_storage[0]);	}
+			 Iterator begin( void ){	return Iterator(m_storage);	}
 			 
 			 /**
 			  * @brief Return iterator to the end
 			  * 
 			  * @return Iterator 
 			  */
-			 Iterator end( void ){	return Iterator(&m_storage[m_end]);	}
+			 Iterator end( void ){	return Iterator(m_storage + m_end);	}
 			 
 			 /**
 			  * @brief Return const_iterator to beginning
 			  * 
 			  * @return const_iterator 
 			  */
-			 const_iterator cbegin( void ) const{	return const_iterator(&m_storage[0]); }
+			 const_iterator cbegin( void ) const{	return const_iterator(m_storage); }
 			 
 			 /**
 			  * @brief Return const_iterator to the end
 			  * 
 			  * @return const_iterator 
 			  */
-			 const_iterator cend( void ) const{		return const_iterator(&m_storage[0]); }
+			 const_iterator cend( void ) const{		return const_iterator(m_storage + m_end); }
+
+			 /**
+			  * @brief Return const_iterator to beginning, for a const vector
+			  * 
+			  * @return const_iterator 
+			  */
+			 const_iterator begin( void ) const{	return cbegin();	}
+
+			 /**
+			  * @brief Return const_iterator to the end, for a const vector
+			  * 
+			  * @return const_iterator 
+			  */
+			 const_iterator end( void ) const{	return cend();	}
 
 //############################# [III] Capacity
 			 
@@ -354,10 +1370,8 @@ namespace sc
 			  */
 			 void clear( void )
 			 {
-			 	delete [] m_storage;
-				m_end = 0;
-				m_storage = nullptr; //Because the object doesn't stop existing is just cleared
-
+			 	destroy( m_storage, m_storage + m_end );
+				m_end = 0; //The storage is kept, so the capacity doesn't change
 			 }
 
 			 /**
@@ -366,18 +1380,7 @@ namespace sc
 			  * 
 			  * @param ref 
 			  */
-			 void push_front( const_reference ref)
-			 {
-			 	
-				 if( m_end == m_capacity ){	reserve(m_capacity * 2);}
-					
-			 	 for(auto i= m_end+1; i != 0; --i)
-			 	 {
-			 	 	m_storage[i] = m_storage[i-1];
-			 	 }
-								m_end++;
-                m_storage[0] = ref;
-			 }
+			 void push_front( const_reference ref){	emplace( begin(), ref );	}
 
 			 /**
 			  * @brief Adds a new element at the end of the vector, 
@@ -385,13 +1388,72 @@ namespace sc
 			  * 
 			  * @param ref 
 			  */
-			 void push_back( const_reference ref)
+			 void push_back( const_reference ref){	emplace_back( ref );	}
+
+			 /**
+			  * @brief Adds a new element at the end of the vector, moving ref into it.
+			  * 
+			  * @param ref 
+			  */
+			 void push_back( value_type && ref){	emplace_back( std::move( ref ) );	}
+
+			 /**
+			  * @brief Adds a new element at the end of the vector, constructed in place with args
+			  * as the arguments for its constructor.
+			  * 
+			  * @param args 
+			  * @return reference to the new element
+			  */
+			 template < typename... Args >
+			 reference emplace_back( Args&&... args )
 			 {
-				
-				 if( m_end == m_capacity ){	reserve( 2 * m_capacity);}
-				  
-					m_end++;
-					m_storage[m_end] = ref; 
+			 	if( m_end == m_capacity )
+			 	{
+			 		realloc_emplace( m_end, std::forward< Args >( args )... );
+			 	}
+			 	else
+			 	{
+			 		construct_at( m_storage + m_end, std::forward< Args >( args )... );
+			 		m_end++;
+			 	}
+
+			 	return m_storage[m_end-1];
+			 }
+
+			 /**
+			  * @brief Inserts a new element before position, constructed in place with args as the arguments
+			  * for its constructor. A position outside of the vector leaves it unchanged.
+			  * 
+			  * @param position 
+			  * @param args 
+			  * @return Iterator to the new element
+			  */
+			 template < typename... Args >
+			 Iterator emplace( Iterator position, Args&&... args )
+			 {
+			 	const size_type index = index_of( position );
+			 	if( index > m_end ){	return end();	}
+
+			 	if( m_end == m_capacity )
+			 	{
+			 		realloc_emplace( index, std::forward< Args >( args )... );
+			 	}
+			 	else if( index == m_end )
+			 	{
+			 		construct_at( m_storage + m_end, std::forward< Args >( args )... );
+			 		m_end++;
+			 	}
+			 	else
+			 	{
+			 		// Built before the shift, since args may refer to an element of the vector.
+			 		value_type temporary( std::forward< Args >( args )... );
+			 		detail::open_gap( m_alloc, m_storage + index, m_storage + m_end, 1 );
+			 		note_shift( m_end - index );
+			 		m_storage[index] = std::move( temporary );
+			 		m_end++;
+			 	}
+
+			 	return Iterator( m_storage + index );
 			 }
 
 			 /**
@@ -402,7 +1464,8 @@ namespace sc
 			 {
 			 	if( empty() ){	throw std::out_of_range("Can't pop out of an empty vector \n");}
 				
-				m_storage[--m_end];
+				--m_end;
+				destroy( m_storage + m_end, m_storage + m_end + 1 );
 			 }
 
 			 /**
@@ -412,8 +1475,9 @@ namespace sc
 			 void pop_front( void )
 			 {
 			 	if(empty()){	throw std::out_of_range("Can't pop out of an empty vector \n");}
-				 for(auto i(0u); i != m_end; ++i){	m_storage[i] = m_storage[i+1];}
-                m_end--;
+				detail::shift_left( m_alloc, m_storage + 1, m_storage + m_end, m_storage );
+				note_shift( m_end - 1 );
+				--m_end;
 			 }
 			 
 			 /**
@@ -423,26 +1487,16 @@ namespace sc
 			  * @param ref 
 			  * @return Iterator 
 			  */
-			 Iterator insert( Iterator position, const_reference ref)
-			 {
-				 
-				  auto first = begin();
-					unsigned int count = 0;
-
-					for(count = 0; first != position; ++first, ++count);
-
-					if(m_end == m_capacity){ reserve(m_capacity*2); }
+			 Iterator insert( Iterator position, const_reference ref){	return emplace( position, ref );	}
 
-					for(auto i(m_end+1); i != count; i--)
-					{
-						for( auto i(m_end+1); i != count; --i ){ m_storage[i] = m_storage[i-1]; }
-					} 
-
-					m_storage[count] = ref;
-					m_end++;
-
-					return first;
-			 }
+			 /**
+			  * @brief Inserts a new element before position, moving ref into it.
+			  * 
+			  * @param position 
+			  * @param ref 
+			  * @return Iterator 
+			  */
+			 Iterator insert( Iterator position, value_type && ref){	return emplace( position, std::move( ref ) );	}
 			 
 			 /**
 			  * @brief The vector is extended by inserting new elements before the element at the specified position, 
@@ -454,16 +1508,40 @@ namespace sc
 			  * @param last 
 			  * @return Iterator 
 			  */
-			 template < typename InputItr >
-			 Iterator insert( Iterator  position, InputItr first, InputItr last);
+			 template < typename InputItr, typename = detail::require_iterator< InputItr > >
+			 Iterator insert( Iterator  position, InputItr first, InputItr last)
+			 {
+			 	const size_type index = index_of( position );
+			 	if( index > m_end ){	return end();	}
+
+			 	insert_range( index, first, last, typename std::iterator_traits< InputItr >::iterator_category() );
+
+			 	return Iterator( m_storage + index );
+			 }
 			 
 			 /**
 			  * @brief The vector is extended by inserting new elements before the element at the specified position, 
 				* effectively increasing the container size by the number of elements inserted.
 			  * 
+			  * @param position 
+			  * @param ilist 
 			  * @return Iterator 
 			  */
-			 Iterator insert( Iterator position, std::initializer_list< value_type > );
+			 Iterator insert( Iterator position, std::initializer_list< value_type > ilist){	return insert( position, ilist.begin(), ilist.end() );	}
+
+			 /**
+			  * @brief Appends a copy of every element of range (anything std::begin/std::end accept) at the end of
+			  * the vector, with at most one reallocation when its iterators are forward iterators.
+			  * 
+			  * @tparam Range 
+			  * @param range 
+			  */
+			 template < typename Range >
+			 void append_range( Range && range )
+			 {
+			 	insert_range( m_end, std::begin( range ), std::end( range ),
+			 			typename std::iterator_traits< decltype( std::begin( range ) ) >::iterator_category() );
+			 }
 			 
 			 /**
 			  * @brief Requests that the vector capacity be at least enough to contain n_size elements.
@@ -472,17 +1550,17 @@ namespace sc
 			  */
 			 void reserve(size_type n_size)
 			 {
-			 	if(n_size < m_capacity){ return;} //If the capacity asked is smaller than the current one, nothing is done.
+			 	if(n_size <= m_capacity){ return;} //If the capacity asked isn't greater than the current one, nothing is done.
+			 	if( reallocate_storage( n_size ) ){	return;	}
 
-			 	pointer temporary =  new value_type[n_size];
+			 	pointer temporary =  allocate(n_size);
+			 	relocate_into( m_storage, m_storage + m_end, temporary, n_size ); //Only the live elements are relocated.
+			 	note_reallocation( m_capacity, n_size, m_end );
 
-			 	for(auto i(0u); i < m_capacity; i++){	temporary[i] = m_storage[i];} 
-
-			 	delete [] m_storage;
+			 	destroy( m_storage, m_storage + m_end );
+			 	deallocate( m_storage, m_capacity );
 				m_capacity = n_size;
 				m_storage = temporary;
-				
-
 			 }
 			 
 			 /**
@@ -491,11 +1569,42 @@ namespace sc
 			  */
 			 void shrink_to_fit( void )
 			 {
-			 	pointer temporary = new value_type[m_end];  
-				
-				for(auto i(0); i < m_end; ++i){	temporary[i] = m_storage[i];}
+			 	if( reallocate_storage( m_end ) ){	return;	}
 
-				delete [] m_storage;
+			 	pointer temporary = allocate(m_end);
+			 	relocate_into( m_storage, m_storage + m_end, temporary, m_end );
+			 	note_reallocation( m_capacity, m_end, m_end );
+
+			 	destroy( m_storage, m_storage + m_end );
+				deallocate( m_storage, m_capacity );
+				m_storage = temporary;
+				m_capacity = m_end;
+			 }
+
+			 /**
+			  * @brief shrink_to_fit whose elements are relocated in parallel chunks by policy (sc::par) when moving
+			  * them can't throw.
+			  * 
+			  * @param policy 
+			  */
+			 template < typename Policy, typename = detail::require_execution_policy< Policy > >
+			 void shrink_to_fit( const Policy & policy )
+			 {
+			 	if( reallocate_storage( m_end ) ){	return;	}
+
+			 	allocator_type & alloc = m_alloc;
+			 	pointer from = m_storage, temporary = allocate(m_end);
+
+			 	try
+			 	{
+			 		run_chunks( policy, m_end, [&alloc, from, temporary]( size_type begin, size_type end ){	detail::relocate( alloc, from + begin, from + end, temporary + begin );	},
+			 				std::is_nothrow_move_constructible< value_type >() );
+			 	}
+			 	catch( ... ){	deallocate( temporary, m_end ); throw;	}
+			 	note_reallocation( m_capacity, m_end, m_end );
+
+			 	destroy( m_storage, m_storage + m_end );
+				deallocate( m_storage, m_capacity );
 				m_storage = temporary;
 				m_capacity = m_end;
 			 }
@@ -506,37 +1615,49 @@ namespace sc
 			  */
 			 void assign( size_type count, const_reference ref)
 			 {
-				  	if(count > m_capacity){ reserve(count); }
-				 		
-							m_end = count;
-						
-								for(auto i(0u); i < count; ++i){	m_storage[i] = ref;	}	
-						
+				  	if(count > m_capacity)
+				  	{
+				  		// The new storage is filled before the old one is destroyed, so ref may point into the vector.
+				  		pointer temporary = allocate(count);
+				  		try{	detail::fill_construct( m_alloc, temporary, count, ref );	}
+				  		catch( ... ){	deallocate( temporary, count ); throw;	}
+
+				  		destroy( m_storage, m_storage + m_end );
+				  		deallocate( m_storage, m_capacity );
+				  		m_storage = temporary;
+				  		m_capacity = count;
+				  	}
+				  	else if( count > m_end )
+				  	{
+				  		std::fill_n( m_storage, m_end, ref );
+				  		detail::fill_construct( m_alloc, m_storage + m_end, count - m_end, ref );
+				  	}
+				  	else
+				  	{
+				  		std::fill_n( m_storage, count, ref );
+				  		destroy( m_storage + count, m_storage + m_end );
+				  	}
+
+					m_end = count;
 			 }
+
+			 /**
+			  * @brief assign( count, ref ) whose elements are built in parallel chunks by policy (sc::par) when
+			  * copying ref can't throw.
+			  * 
+			  * @param policy 
+			  * @param count 
+			  * @param ref 
+			  */
+			 template < typename Policy, typename = detail::require_execution_policy< Policy > >
+			 void assign( const Policy & policy, size_type count, const_reference ref ){	assign( policy, count, ref, std::is_nothrow_copy_constructible< value_type >() );	}
 			 
 			 /**
 			  * @brief In the initializer list assign, the new contents are copies of the values passed as initializer list, in the same order.
 			  * 
 			  * @param ilist 
 			  */
-			 void assign( std::initializer_list<T>  ilist)
-			 {
-			 		if(empty()) {throw std::out_of_range("Can't assign values to an empty vector. \n");}
-			
-								 	auto count = 0;
-									size_type i = 0;
-
-									while(count < m_end)
-									{ 
-			 							for (auto &element : ilist)
-										{
-												m_storage[i] = element;
-												i++;
-												count++;
-										}
-										
-									}
-			 }
+			 void assign( std::initializer_list<T>  ilist){	assign( ilist.begin(), ilist.end() );	}
 
 			 /**
 			  * @brief In the range assign, the new contents are elements constructed from each of the elements in the range between first and last, in the same order.
@@ -545,27 +1666,11 @@ namespace sc
 			  * @param first 
 			  * @param last 
 			  */
-			 template < typename InputItr >
+			 template < typename InputItr, typename = detail::require_iterator< InputItr > >
 			 void assign( InputItr first, InputItr last)
 			 {
-				
-			 	size_type dist = 0;
-			 	auto right = first;
-
-			 	while( right != last){	dist++; right++;	}
-			  
-			 	m_end = dist;
-				m_capacity = dist;
-				m_storage = new T[m_capacity];
-
-				auto value = first;
-
-				for (auto i(0u); i < dist; ++i, ++value)
-				{
-					m_storage[i] = *value;
-				}
-		
-			 } 
+			 	assign_range( first, last, typename std::iterator_traits< InputItr >::iterator_category() );
+			 }
 			 
 			 /**
 			  * @brief Removes from the vector a range of elements ([first,last)).This effectively reduces the container size by the number of elements removed, which are destroyed.
@@ -574,7 +1679,19 @@ namespace sc
 			  * @param last 
 			  * @return Iterator 
 			  */
-			 Iterator erase( Iterator first, Iterator last){}
+			 Iterator erase( Iterator first, Iterator last)
+			 {
+			 	const size_type index = index_of( first );
+			 	const size_type count = last - first;
+			 	if( count == 0 ){	return first;	}
+
+			 	// The tail moves down in one block and the last `count` slots are destroyed.
+			 	detail::shift_left( m_alloc, m_storage + index + count, m_storage + m_end, m_storage + index );
+			 	note_shift( m_end - index - count );
+			 	m_end -= count;
+
+			 	return first;
+			 }
 			 
 			 /**
 			  * @brief Removes from the vector either a single element (position).This effectively reduces the container size by the number of elements removed, which are destroyed.
@@ -584,28 +1701,14 @@ namespace sc
 			  */
 			 Iterator erase( Iterator position)
 			 {
-				
-			 	auto first = begin(); 
-				int count = 0;
-
-				 while (position != first)
-				 {
-					  ++first;
-						++count;
-				 }
-
-				 for (auto i = count; i < m_end-1; i++)
-				 {
-					  m_storage[i] = m_storage[i+1];
-				 }
-				 
-				 m_end--;
+			 	const size_type count = index_of( position );
 
-					 return Iterator(first);
+			 	detail::shift_left( m_alloc, m_storage + count + 1, m_storage + m_end, m_storage + count );
+			 	note_shift( m_end - count - 1 );
+			 	m_end--;
 
-			 	
-				
-			 	} 
+			 	return position;
+			 } 
 
 			 	//return Iterator(posi);
 
@@ -715,7 +1818,35 @@ namespace sc
 			  * 
 			  * @return const_reference 
 			  */
-			 const_reference data( void ) const{	return m_storage;}
+			 const T * data( void ) const{	return m_storage;}
+
+//############################# [V.I] Lookup
+
+			 /**
+			  * @brief Returns an iterator to the first element equal to value, or end() if there is none.
+			  * Arithmetic types are compared a SIMD register at a time.
+			  * 
+			  * @param value 
+			  * @return Iterator 
+			  */
+			 Iterator find( const_reference value ){	return Iterator( m_storage + simd::find( m_storage, m_end, value ) );	}
+			 const_iterator find( const_reference value ) const{	return const_iterator( m_storage + simd::find( m_storage, m_end, value ) );	}
+
+			 /**
+			  * @brief Returns how many elements are equal to value.
+			  * 
+			  * @param value 
+			  * @return size_type 
+			  */
+			 size_type count( const_reference value ) const{	return simd::count( m_storage, m_end, value );	}
+
+			 /**
+			  * @brief Returns true if some element is equal to value.
+			  * 
+			  * @param value 
+			  * @return bool 
+			  */
+			 bool contains( const_reference value ) const{	return simd::find( m_storage, m_end, value ) != m_end;	}
 
 //############################# [VI] Operators ##################################################################################################
 				
@@ -728,21 +1859,8 @@ namespace sc
 				 */
 		    bool operator== ( const vector& test_v)const
 		    {	
-		    	if (this->m_end == test_v.m_end)
-		    	{
-		    		auto count(0);
-			    	for (int i = 0; i < this->m_end; ++i)
-			    	{
-			    		if(this->m_storage[i] == test_v.m_storage[i]){ count++; }
-			    	}
-
-		    		return count == this->m_end;
-		    	}
-		    	else
-		    	{
-		    		return this->m_end == test_v.m_end;
-		    	}
-
+		    	// Stops at the first mismatch; arithmetic types are compared a SIMD register at a time.
+		    	return m_end == test_v.m_end and simd::mismatch( m_storage, test_v.m_storage, m_end ) == m_end;
 		    }
 		    
 				/**
@@ -752,28 +1870,106 @@ namespace sc
 				 * @return true 
 				 * @return false 
 				 */
-		    bool operator!= ( const vector& test_v)const 
-		    {
-		    	if((this->m_capacity != test_v.m_capacity) || (this->m_end != test_v.m_end)){ return true;}
-		    	
-					for(auto i(0u); i != m_end; i++)
-					{
-						if(m_storage[i] != test_v.m_storage[i])
-						{
-							return true;
-						}
-					}
-						return false;
-				
-		    }
+		    bool operator!= ( const vector& test_v)const{	return not ( *this == test_v );	}
+
+				/**
+				 * @brief Compares the contents of two vectors lexicographically, as std::lexicographical_compare.
+				 * 
+				 * @param test_v 
+				 * @return true 
+				 * @return false 
+				 */
+		    bool operator< ( const vector& test_v)const{	return simd::less( m_storage, m_end, test_v.m_storage, test_v.m_end );	}
+		    bool operator> ( const vector& test_v)const{	return test_v < *this;	}
+		    bool operator<= ( const vector& test_v)const{	return not ( test_v < *this );	}
+		    bool operator>= ( const vector& test_v)const{	return not ( *this < test_v );	}
+
+				/**
+				 * @brief Exchanges the contents of the vector with those of other. No element is copied or moved.
+				 * The allocators are swapped only if they propagate on swap, otherwise they must compare equal.
+				 * 
+				 * @param other 
+				 */
+				void swap( vector & other ) noexcept
+				{
+					detail::propagate_swap( m_alloc, other.m_alloc, typename alloc_traits::propagate_on_container_swap() );
+					std::swap( m_end, other.m_end );
+					std::swap( m_capacity, other.m_capacity );
+					std::swap( m_storage, other.m_storage );
+				}
 
 	       // [VII] Friend functions.
 		    /*
-			friend std::ostream & operator <<( std::ostream & os_, const vector<T> & v_ );
-			friend void swap( vector<T> & first_, vector<T> & second_ ); */
+			friend std::ostream & operator <<( std::ostream & os_, const vector<T> & v_ ); */
+
+				/**
+				 * @brief Exchanges the contents of first_ and second_, in constant time.
+				 * 
+				 * @param first_ 
+				 * @param second_ 
+				 */
+				friend void swap( vector & first_, vector & second_ ) noexcept {	first_.swap( second_ );	}
 
 
 	};
+
+	/**
+	 * @brief Removes every element of vec for which pred returns true, compacting the rest in a single pass
+	 * (see detail::compact), instead of one erase, and one shift of the tail, per element.
+	 * 
+	 * @param vec 
+	 * @param pred 
+	 * @return the number of elements removed
+	 */
+	template < typename T, typename Allocator, typename Growth, typename Pred >
+	typename vector< T, Allocator, Growth >::size_type erase_if( vector< T, Allocator, Growth > & vec, Pred pred )
+	{
+		detail::keep_unless< T, Pred > keep = { pred };
+		T * first = vec.data();
+		T * last = first + vec.size();
+		T * new_last = detail::compact( first, last, keep );
+
+		vec.erase( vec.begin() + ( new_last - first ), vec.end() );
+		return last - new_last;
+	}
+
+	/**
+	 * @brief Removes the elements of vec at the indices in [first, last), which must be sorted in ascending
+	 * order, compacting the rest in a single pass. Repeated indices, and those past the end, are ignored.
+	 * 
+	 * @param vec 
+	 * @param first 
+	 * @param last 
+	 * @return the number of elements removed
+	 */
+	template < typename T, typename Allocator, typename Growth, typename IndexItr >
+	typename vector< T, Allocator, Growth >::size_type erase_indices( vector< T, Allocator, Growth > & vec, IndexItr first, IndexItr last )
+	{
+		T * begin = vec.data();
+		T * end = begin + vec.size();
+		detail::keep_unlisted< T, IndexItr > keep = { begin, first, last };
+		T * new_last = detail::compact( begin, end, keep );
+
+		vec.erase( vec.begin() + ( new_last - begin ), vec.end() );
+		return end - new_last;
+	}
+
+	template < typename T, typename Allocator, typename Growth, typename IndexRange >
+	typename vector< T, Allocator, Growth >::size_type erase_indices( vector< T, Allocator, Growth > & vec, const IndexRange & indices )
+	{
+		return erase_indices( vec, std::begin( indices ), std::end( indices ) );
+	}
+
+#ifdef SC_HAS_PMR
+	namespace pmr
+	{
+		/// sc::vector whose storage comes from a std::pmr::memory_resource, such as a monotonic arena.
+		template < typename T >
+		using vector = sc::vector< T, std::pmr::polymorphic_allocator< T > >;
+	}
+#endif
 };
 
+#include "vector_bool.h" // sc::vector< bool >, packed one bit per element
+
 #endif
\ No newline at end of file
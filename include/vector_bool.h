@@ -0,0 +1,579 @@
+/**
+ * @file    vector_bool.h
+ * @brief   Bit-packed specialization sc::vector< bool >: one bit per flag in 64-bit words, with proxy
+ *          references, and the bitmap operations (count, find_first/find_next, &, |, ^, range set/reset)
+ *          done a word at a time. Included by vector.h, so every sc::vector< bool > is packed.
+ * @author  Bruna Hellen de Castro Dantas Barbosa
+ */
+
+#ifndef VECTOR_BOOL_H
+#define VECTOR_BOOL_H
+
+#include "vector.h"
+
+#include <cstdint> // std::uint64_t
+#include <limits> // std::numeric_limits
+#include <stdexcept> // std::invalid_argument
+
+
+namespace sc
+{
+
+	namespace detail
+	{
+		/// Index of the lowest bit set in word, which must not be 0.
+		inline std::size_t lowest_bit( std::uint64_t word )
+		{
+#if defined( __GNUC__ )
+			return __builtin_ctzll( word );
+#else
+			std::size_t bit = 0;
+			for( ; ( word & 1 ) == 0; word >>= 1 ){	++bit;	}
+			return bit;
+#endif
+		}
+
+		/// Writable reference to one bit of a word.
+		template < typename Word >
+		class bit_reference
+		{
+			public:
+
+				bit_reference( Word * word, Word mask ): m_word(word), m_mask(mask){	/* Empty */	}
+
+				operator bool ( void ) const{	return ( *m_word & m_mask ) != 0;	}
+				bool operator~ ( void ) const{	return ( *m_word & m_mask ) == 0;	}
+
+				bit_reference & operator= ( bool value )
+				{
+					if( value ){	*m_word |= m_mask;	}
+					else{	*m_word &= ~m_mask;	}
+					return *this;
+				}
+
+				bit_reference & operator= ( const bit_reference & other ){	return *this = bool( other );	}
+
+				void flip( void ){	*m_word ^= m_mask;	}
+
+				friend void swap( bit_reference a, bit_reference b )
+				{
+					const bool old = a;
+					a = bool( b );
+					b = old;
+				}
+
+			private:
+				Word * m_word; //<! Word holding the bit.
+				Word m_mask; //<! The bit, alone in its word.
+		};
+
+		/**
+		 * Random access iterator over packed bits: a word array and a bit index. The constant version
+		 * yields bools, the other one bit_references.
+		 */
+		template < typename Word, bool Const >
+		class bit_iterator
+		{
+			public:
+
+				typedef std::ptrdiff_t difference_type;
+				typedef bool value_type;
+				typedef void pointer;
+				typedef typename std::conditional< Const, bool, bit_reference< Word > >::type reference;
+				typedef std::random_access_iterator_tag iterator_category;
+				typedef typename std::conditional< Const, const Word, Word >::type word_type;
+
+				static const std::size_t word_bits = std::numeric_limits< Word >::digits;
+
+				bit_iterator( word_type * words = nullptr, difference_type index = 0 ): m_words(words), m_index(index){	/* Empty */	}
+
+				/// Iterator to const_iterator.
+				template < bool C, typename = typename std::enable_if< Const and not C >::type >
+				bit_iterator( const bit_iterator< Word, C > & other ): m_words(other.m_words), m_index(other.m_index){	/* Empty */	}
+
+				difference_type index( void ) const{	return m_index;	}
+
+				reference operator* ( void ) const{	return bit( std::integral_constant< bool, Const >() );	}
+				reference operator[] ( difference_type n ) const{	return *( *this + n );	}
+
+				bit_iterator & operator++ ( void ){	++m_index; return *this;	}
+				bit_iterator operator++ ( int ){	bit_iterator old( *this ); ++m_index; return old;	}
+				bit_iterator & operator-- ( void ){	--m_index; return *this;	}
+				bit_iterator operator-- ( int ){	bit_iterator old( *this ); --m_index; return old;	}
+				bit_iterator & operator+= ( difference_type n ){	m_index += n; return *this;	}
+				bit_iterator & operator-= ( difference_type n ){	m_index -= n; return *this;	}
+
+				friend bit_iterator operator+ ( bit_iterator it, difference_type n ){	return it += n;	}
+				friend bit_iterator operator+ ( difference_type n, bit_iterator it ){	return it += n;	}
+				friend bit_iterator operator- ( bit_iterator it, difference_type n ){	return it -= n;	}
+				friend difference_type operator- ( const bit_iterator & a, const bit_iterator & b ){	return a.m_index - b.m_index;	}
+
+				friend bool operator== ( const bit_iterator & a, const bit_iterator & b ){	return a.m_index == b.m_index;	}
+				friend bool operator!= ( const bit_iterator & a, const bit_iterator & b ){	return a.m_index != b.m_index;	}
+				friend bool operator< ( const bit_iterator & a, const bit_iterator & b ){	return a.m_index < b.m_index;	}
+				friend bool operator> ( const bit_iterator & a, const bit_iterator & b ){	return a.m_index > b.m_index;	}
+				friend bool operator<= ( const bit_iterator & a, const bit_iterator & b ){	return a.m_index <= b.m_index;	}
+				friend bool operator>= ( const bit_iterator & a, const bit_iterator & b ){	return a.m_index >= b.m_index;	}
+
+			private:
+				template < typename W, bool C > friend class bit_iterator;
+
+				word_type * m_words;
+				difference_type m_index;
+
+				bool bit( std::true_type ) const{	return ( m_words[ std::size_t( m_index ) / word_bits ] >> ( std::size_t( m_index ) % word_bits ) ) & 1;	}
+
+				bit_reference< Word > bit( std::false_type ) const
+				{
+					return bit_reference< Word >( m_words + std::size_t( m_index ) / word_bits, Word( 1 ) << ( std::size_t( m_index ) % word_bits ) );
+				}
+		};
+	}
+
+	/**
+	 * sc::vector< bool >, packed: size() bits in ( size() + 63 ) / 64 words, 1/8 of the memory of one byte per
+	 * flag, and the bitmap operations run on whole words. As with std::vector< bool >, operator[] and the
+	 * iterators yield proxy references instead of bool&, and there is no data() of bools; words() exposes
+	 * the packed words instead, bit i being bit i % 64 of word i / 64.
+	 *
+	 * The bits of the last word past size() are always 0, which count, find and == rely on. Assignment
+	 * copies and swaps, so stateful allocators must compare equal or propagate on swap.
+	 */
+	template < typename Allocator, typename Growth >
+	class vector< bool, Allocator, Growth >
+	{
+
+		public:
+
+			typedef Allocator allocator_type;
+			typedef Growth growth_policy;
+			typedef size_t size_type;
+			typedef bool value_type;
+			typedef std::uint64_t word_type;
+			typedef detail::bit_reference< word_type > reference;
+			typedef bool const_reference;
+			typedef detail::bit_iterator< word_type, false > Iterator;
+			typedef detail::bit_iterator< word_type, true > const_iterator;
+
+			static const size_type word_bits = 64;
+			static const size_type npos = size_type( -1 ); //<! Returned by find_first and find_next when no bit is set.
+
+		private:
+			typedef typename std::allocator_traits< allocator_type >::template rebind_alloc< word_type > word_allocator;
+			typedef std::allocator_traits< word_allocator > alloc_traits;
+
+			word_allocator m_alloc; //<! Allocator of the words.
+			size_type m_end; //<! Number of bits.
+			size_type m_capacity; //<! Number of words allocated.
+			word_type * m_words; //<! The bits, packed.
+
+			static size_type words_for( size_type bits ){	return ( bits + word_bits - 1 ) / word_bits;	}
+
+			/// Word with the lowest `bits` bits set, bits in [0, word_bits].
+			static word_type low_mask( size_type bits ){	return bits >= word_bits ? ~word_type( 0 ) : ( word_type( 1 ) << bits ) - 1;	}
+
+			static void apply( word_type & word, word_type mask, bool value ){	word = value ? ( word | mask ) : ( word & ~mask );	}
+
+			/// Moves the words to a block of `words` words.
+			void reallocate( size_type words )
+			{
+				word_type * fresh = alloc_traits::allocate( m_alloc, words );
+				std::copy( m_words, m_words + words_for( m_end ), fresh );
+				if( m_words != nullptr ){	alloc_traits::deallocate( m_alloc, m_words, m_capacity );	}
+				m_words = fresh;
+				m_capacity = words;
+			}
+
+			/// Makes room for `bits` bits, growing as the growth policy says.
+			void grow( size_type bits )
+			{
+				const size_type words = words_for( bits );
+				if( words > m_capacity ){	reallocate( growth_policy::grow( m_capacity, words, sizeof( word_type ) ) );	}
+			}
+
+			/// Zeroes the bits of the last word past the end.
+			void clear_tail( void ){	if( m_end % word_bits != 0 ){	m_words[ m_end / word_bits ] &= low_mask( m_end % word_bits );	}	}
+
+			/**
+			 * @brief Sets (value true) or clears the bits [first, last): masks on the two end words, whole
+			 * words in between.
+			 *
+			 * @param first
+			 * @param last
+			 * @param value
+			 */
+			void fill_bits( size_type first, size_type last, bool value )
+			{
+				if( first >= last ){	return;	}
+
+				const size_type head = first / word_bits;
+				const size_type tail = ( last - 1 ) / word_bits;
+				const word_type head_mask = ~low_mask( first % word_bits );
+				const word_type tail_mask = low_mask( ( last - 1 ) % word_bits + 1 );
+
+				if( head == tail ){	apply( m_words[head], head_mask & tail_mask, value );	return;	}
+
+				apply( m_words[head], head_mask, value );
+				std::fill( m_words + head + 1, m_words + tail, value ? ~word_type( 0 ) : word_type( 0 ) );
+				apply( m_words[tail], tail_mask, value );
+			}
+
+			/// Inverts the bits [first, last), with the masks of fill_bits.
+			void flip_bits( size_type first, size_type last )
+			{
+				if( first >= last ){	return;	}
+
+				const size_type head = first / word_bits;
+				const size_type tail = ( last - 1 ) / word_bits;
+				const word_type head_mask = ~low_mask( first % word_bits );
+				const word_type tail_mask = low_mask( ( last - 1 ) % word_bits + 1 );
+
+				if( head == tail ){	m_words[head] ^= head_mask & tail_mask;	return;	}
+
+				m_words[head] ^= head_mask;
+				for( size_type i = head + 1; i < tail; ++i ){	m_words[i] = ~m_words[i];	}
+				m_words[tail] ^= tail_mask;
+			}
+
+			/// Index of the first bit set at start or after it, npos if there is none.
+			size_type find_from( size_type start ) const
+			{
+				if( start >= m_end ){	return npos;	}
+
+				size_type w = start / word_bits;
+				word_type word = m_words[w] & ~low_mask( start % word_bits );
+				for( const size_type words = words_for( m_end ); word == 0; word = m_words[w] )
+				{
+					if( ++w == words ){	return npos;	}
+				}
+				return w * word_bits + detail::lowest_bit( word );
+			}
+
+			void check_range( size_type first, size_type last ) const
+			{
+				if( first > last or last > m_end ){	throw std::out_of_range("This range is out of range.\n");	}
+			}
+
+			void check_same_size( const vector & other ) const
+			{
+				if( m_end != other.m_end ){	throw std::invalid_argument("The bitwise operators need vectors of the same size.\n");	}
+			}
+
+		public:
+
+//############################# [I] SPECIAL MEMBERS
+
+			 vector( ): m_alloc(), m_end(0), m_capacity(0), m_words(nullptr){	/* Empty */	}
+
+			 explicit vector( const allocator_type & alloc ): m_alloc(alloc), m_end(0), m_capacity(0), m_words(nullptr){	/* Empty */	}
+
+			 /**
+			  * @brief Constructs an empty vector with room for n bits, as the general vector( n ).
+			  *
+			  * @param n
+			  * @param alloc
+			  */
+			 vector( size_type n, const allocator_type & alloc = allocator_type() ): vector( alloc ){	reserve( n );	}
+
+			 /**
+			  * @brief Constructs count bits equal to value.
+			  *
+			  * @param count
+			  * @param value
+			  * @param alloc
+			  */
+			 vector( size_type count, bool value, const allocator_type & alloc = allocator_type() ): vector( alloc ){	assign( count, value );	}
+
+			 template < typename InputItr, typename = detail::require_iterator< InputItr > >
+			 vector( InputItr first, InputItr last, const allocator_type & alloc = allocator_type() ): vector( alloc )
+			 {
+			 	for( ; first != last; ++first ){	push_back( *first );	}
+			 }
+
+			 vector( std::initializer_list< bool > ilist, const allocator_type & alloc = allocator_type() ): vector( ilist.begin(), ilist.end(), alloc ){	/* Empty */	}
+
+			 vector( const vector & model ): m_alloc(alloc_traits::select_on_container_copy_construction( model.m_alloc )), m_end(0), m_capacity(0), m_words(nullptr)
+			 {
+			 	if( model.m_end == 0 ){	return;	}
+			 	reallocate( words_for( model.m_end ) );
+			 	std::copy( model.m_words, model.m_words + words_for( model.m_end ), m_words );
+			 	m_end = model.m_end;
+			 }
+
+			 vector( vector && model ) noexcept: m_alloc(std::move(model.m_alloc)), m_end(model.m_end), m_capacity(model.m_capacity), m_words(model.m_words)
+			 {
+			 	model.m_end = 0;
+			 	model.m_capacity = 0;
+			 	model.m_words = nullptr;
+			 }
+
+			 vector & operator= ( vector model ) noexcept
+			 {
+			 	swap( model );
+			 	return *this;
+			 }
+
+			 ~vector( ){	if( m_words != nullptr ){	alloc_traits::deallocate( m_alloc, m_words, m_capacity );	}	}
+
+			 allocator_type get_allocator( void ) const{	return allocator_type( m_alloc );	}
+
+//############################# [II] IteratorS
+
+			 Iterator begin( void ){	return Iterator( m_words, 0 );	}
+			 Iterator end( void ){	return Iterator( m_words, m_end );	}
+			 const_iterator begin( void ) const{	return cbegin();	}
+			 const_iterator end( void ) const{	return cend();	}
+			 const_iterator cbegin( void ) const{	return const_iterator( m_words, 0 );	}
+			 const_iterator cend( void ) const{	return const_iterator( m_words, m_end );	}
+
+//############################# [III] Capacity
+
+			 size_type size( void ) const{	return m_end;	}
+			 bool empty( void ) const{	return m_end == 0;	}
+			 size_type capacity( void ) const{	return m_capacity * word_bits;	}
+
+			 /// Number of words holding the bits, words_for( size() ).
+			 size_type word_count( void ) const{	return words_for( m_end );	}
+
+			 /// The packed words; bit i is bit i % 64 of word i / 64, the bits past size() are 0.
+			 const word_type * words( void ) const{	return m_words;	}
+
+			 void reserve( size_type n_size ){	if( words_for( n_size ) > m_capacity ){	reallocate( words_for( n_size ) );	}	}
+
+			 void shrink_to_fit( void )
+			 {
+			 	if( m_capacity == words_for( m_end ) ){	return;	}
+			 	if( m_end == 0 )
+			 	{
+			 		alloc_traits::deallocate( m_alloc, m_words, m_capacity );
+			 		m_words = nullptr;
+			 		m_capacity = 0;
+			 		return;
+			 	}
+			 	reallocate( words_for( m_end ) );
+			 }
+
+//############################# [IV] Modifiers
+
+			 void clear( void ){	m_end = 0;	}
+
+			 void push_back( bool value )
+			 {
+			 	grow( m_end + 1 );
+			 	if( m_end % word_bits == 0 ){	m_words[ m_end / word_bits ] = 0;	}
+			 	if( value ){	m_words[ m_end / word_bits ] |= word_type( 1 ) << ( m_end % word_bits );	}
+			 	++m_end;
+			 }
+
+			 void pop_back( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("Can't pop out of an empty vector \n");}
+			 	--m_end;
+			 	clear_tail();
+			 }
+
+			 /**
+			  * @brief Resizes to count bits; the new ones are value, set a word at a time.
+			  *
+			  * @param count
+			  * @param value
+			  */
+			 void resize( size_type count, bool value = false )
+			 {
+			 	if( count <= m_end )
+			 	{
+			 		m_end = count;
+			 		clear_tail();
+			 		return;
+			 	}
+
+			 	grow( count );
+			 	std::fill( m_words + words_for( m_end ), m_words + words_for( count ), word_type( 0 ) );
+			 	if( value ){	fill_bits( m_end, count, true );	}
+			 	m_end = count;
+			 }
+
+			 void assign( size_type count, bool value )
+			 {
+			 	clear();
+			 	resize( count, value );
+			 }
+
+			 /// Sets every bit.
+			 void set( void )
+			 {
+			 	std::fill( m_words, m_words + words_for( m_end ), ~word_type( 0 ) );
+			 	clear_tail();
+			 }
+
+			 /**
+			  * @brief Sets bit n to value.
+			  *
+			  * @param n
+			  * @param value
+			  */
+			 void set( size_type n, bool value = true ){	at( n ) = value;	}
+
+			 /**
+			  * @brief Sets the bits [first, last) to value.
+			  *
+			  * @param first
+			  * @param last
+			  * @param value
+			  */
+			 void set( size_type first, size_type last, bool value )
+			 {
+			 	check_range( first, last );
+			 	fill_bits( first, last, value );
+			 }
+
+			 /// Clears every bit.
+			 void reset( void ){	std::fill( m_words, m_words + words_for( m_end ), word_type( 0 ) );	}
+
+			 void reset( size_type n ){	at( n ) = false;	}
+
+			 /**
+			  * @brief Clears the bits [first, last).
+			  *
+			  * @param first
+			  * @param last
+			  */
+			 void reset( size_type first, size_type last ){	set( first, last, false );	}
+
+			 /// Inverts every bit.
+			 void flip( void )
+			 {
+			 	for( size_type i = 0; i < words_for( m_end ); ++i ){	m_words[i] = ~m_words[i];	}
+			 	clear_tail();
+			 }
+
+			 void flip( size_type n ){	at( n ).flip();	}
+
+			 /**
+			  * @brief Inverts the bits [first, last).
+			  *
+			  * @param first
+			  * @param last
+			  */
+			 void flip( size_type first, size_type last )
+			 {
+			 	check_range( first, last );
+			 	flip_bits( first, last );
+			 }
+
+			 void swap( vector & other ) noexcept
+			 {
+			 	using std::swap;
+			 	swap( m_alloc, other.m_alloc );
+			 	swap( m_end, other.m_end );
+			 	swap( m_capacity, other.m_capacity );
+			 	swap( m_words, other.m_words );
+			 }
+
+			 friend void swap( vector & first_, vector & second_ ) noexcept{	first_.swap( second_ );	}
+
+//#############################  [V] Element access
+
+			 const_reference operator[]( size_type n ) const{	return ( m_words[ n / word_bits ] >> ( n % word_bits ) ) & 1;	}
+			 reference operator[]( size_type n ){	return reference( m_words + n / word_bits, word_type( 1 ) << ( n % word_bits ) );	}
+
+			 const_reference at( size_type n ) const
+			 {
+			 	if( n >= m_end ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return ( *this )[n];
+			 }
+
+			 reference at( size_type n )
+			 {
+			 	if( n >= m_end ){	throw std::out_of_range("This element is out of range.\n");	}
+			 	return ( *this )[n];
+			 }
+
+			 reference front( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :(\n");}
+			 	return ( *this )[0];
+			 }
+
+			 const_reference front( void ) const
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :(\n");}
+			 	return ( *this )[0];
+			 }
+
+			 reference back( void )
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :( \n");}
+			 	return ( *this )[ m_end - 1 ];
+			 }
+
+			 const_reference back( void ) const
+			 {
+			 	if( empty() ){	throw std::out_of_range("The vector is empty :( \n");}
+			 	return ( *this )[ m_end - 1 ];
+			 }
+
+//############################# [VI] Bitmap operations
+
+			 /// Number of bits set, a popcount per word.
+			 size_type count( void ) const{	return simd::popcount( m_words, words_for( m_end ) );	}
+
+			 bool any( void ) const{	return find_from( 0 ) != npos;	}
+			 bool none( void ) const{	return not any();	}
+			 bool all( void ) const{	return count() == m_end;	}
+
+			 /// Index of the first bit set, npos if there is none.
+			 size_type find_first( void ) const{	return find_from( 0 );	}
+
+			 /// Index of the first bit set after n, npos if there is none.
+			 size_type find_next( size_type n ) const{	return n >= m_end ? npos : find_from( n + 1 );	}
+
+			 /**
+			  * @brief Bitwise and with other, which must have the same size (std::invalid_argument otherwise).
+			  *
+			  * @param other
+			  * @return vector&
+			  */
+			 vector & operator&= ( const vector & other )
+			 {
+			 	check_same_size( other );
+			 	for( size_type i = 0; i < words_for( m_end ); ++i ){	m_words[i] &= other.m_words[i];	}
+			 	return *this;
+			 }
+
+			 vector & operator|= ( const vector & other )
+			 {
+			 	check_same_size( other );
+			 	for( size_type i = 0; i < words_for( m_end ); ++i ){	m_words[i] |= other.m_words[i];	}
+			 	return *this;
+			 }
+
+			 vector & operator^= ( const vector & other )
+			 {
+			 	check_same_size( other );
+			 	for( size_type i = 0; i < words_for( m_end ); ++i ){	m_words[i] ^= other.m_words[i];	}
+			 	return *this;
+			 }
+
+			 friend vector operator& ( vector lhs, const vector & rhs ){	lhs &= rhs; return lhs;	}
+			 friend vector operator| ( vector lhs, const vector & rhs ){	lhs |= rhs; return lhs;	}
+			 friend vector operator^ ( vector lhs, const vector & rhs ){	lhs ^= rhs; return lhs;	}
+
+//############################# [VII] Operators
+
+			 bool operator== ( const vector & other ) const
+			 {
+			 	return m_end == other.m_end and std::equal( m_words, m_words + words_for( m_end ), other.m_words );
+			 }
+
+			 bool operator!= ( const vector & other ) const{	return not ( *this == other );	}
+	};
+
+	template < typename Allocator, typename Growth >
+	const typename vector< bool, Allocator, Growth >::size_type vector< bool, Allocator, Growth >::word_bits;
+
+	template < typename Allocator, typename Growth >
+	const typename vector< bool, Allocator, Growth >::size_type vector< bool, Allocator, Growth >::npos;
+};
+
+#endif
@@ -0,0 +1,182 @@
+/**
+ * @file    vector_stats.h
+ * @brief   Opt-in instrumentation of sc::vector. Building with SC_VECTOR_STATS defined (cmake -D VECTOR_STATS=ON)
+ *          makes every vector count its allocations, reallocations, bytes moved by them and elements shifted
+ *          by insert/erase, both on its own (vector::stats()) and in global totals (sc::global_vector_stats()),
+ *          and report each event to an optional observer. Without the macro the hooks are empty and the
+ *          counters stay at zero.
+ * @author  Bruna Hellen de Castro Dantas Barbosa
+ */
+
+#ifndef VECTOR_STATS_H
+#define VECTOR_STATS_H
+
+#include <atomic> // std::atomic
+#include <cstdint> // std::uint64_t
+#include <ostream> // std::ostream
+#include <sstream> // std::ostringstream
+#include <string> // std::string
+
+
+namespace sc
+{
+
+	/// Counters of a vector, or of every vector for the global totals.
+	struct vector_stats
+	{
+		std::uint64_t allocations; //<! Storage blocks allocated.
+		std::uint64_t reallocations; //<! Times the elements were moved to a block of another capacity (growth, shrink_to_fit).
+		std::uint64_t bytes_copied; //<! Bytes of elements those reallocations moved to a new address.
+		std::uint64_t shifts; //<! Elements moved by insert, push_front and erase to open or close a gap.
+		std::uint64_t peak_capacity_bytes; //<! Largest block allocated, or grown by Allocator::reallocate.
+		std::uint64_t wasted_bytes; //<! Capacity not holding elements when the stats were taken; 0 in the global totals.
+	};
+
+	/**
+	 * Receives the events of every vector in SC_VECTOR_STATS builds, e.g. to log the vectors that reallocate
+	 * the most. The calls come from the thread that changed the vector; vector is its address.
+	 */
+	class vector_observer
+	{
+		public:
+
+			virtual ~vector_observer( ){	/* Empty */	}
+
+			virtual void on_allocate( const void * /* vector */, std::size_t /* bytes */ ){	/* Empty */	}
+			virtual void on_reallocate( const void * /* vector */, std::size_t /* old_bytes */, std::size_t /* new_bytes */, std::size_t /* bytes_copied */ ){	/* Empty */	}
+			virtual void on_shift( const void * /* vector */, std::size_t /* elements */, std::size_t /* element_size */ ){	/* Empty */	}
+	};
+
+	namespace detail
+	{
+		struct global_vector_counters
+		{
+			std::atomic< std::uint64_t > allocations;
+			std::atomic< std::uint64_t > reallocations;
+			std::atomic< std::uint64_t > bytes_copied;
+			std::atomic< std::uint64_t > shifts;
+			std::atomic< std::uint64_t > peak_capacity_bytes;
+			std::atomic< vector_observer * > observer;
+		};
+
+		/// Totals of every vector; zero initialized, as a static.
+		inline global_vector_counters & vector_counters( void )
+		{
+			static global_vector_counters counters;
+			return counters;
+		}
+
+		inline void store_max( std::atomic< std::uint64_t > & peak, std::uint64_t value )
+		{
+			std::uint64_t current = peak.load( std::memory_order_relaxed );
+			while( value > current and not peak.compare_exchange_weak( current, value, std::memory_order_relaxed ) ){	/* current was reloaded */	}
+		}
+
+		/*
+		 * Recording functions, called by sc::vector in SC_VECTOR_STATS builds: they update the counters of the
+		 * vector and the global ones, and notify the observer.
+		 */
+
+		inline void record_peak( vector_stats & stats, std::size_t bytes )
+		{
+			if( bytes > stats.peak_capacity_bytes ){	stats.peak_capacity_bytes = bytes;	}
+			store_max( vector_counters().peak_capacity_bytes, bytes );
+		}
+
+		inline void record_allocation( vector_stats & stats, const void * vector, std::size_t bytes )
+		{
+			global_vector_counters & global = vector_counters();
+
+			++stats.allocations;
+			global.allocations.fetch_add( 1, std::memory_order_relaxed );
+			record_peak( stats, bytes );
+
+			if( vector_observer * observer = global.observer.load( std::memory_order_acquire ) ){	observer->on_allocate( vector, bytes );	}
+		}
+
+		inline void record_reallocation( vector_stats & stats, const void * vector, std::size_t old_bytes, std::size_t new_bytes, std::size_t bytes_copied )
+		{
+			global_vector_counters & global = vector_counters();
+
+			++stats.reallocations;
+			stats.bytes_copied += bytes_copied;
+			record_peak( stats, new_bytes ); // Allocator::reallocate grows the block without an allocation.
+			global.reallocations.fetch_add( 1, std::memory_order_relaxed );
+			global.bytes_copied.fetch_add( bytes_copied, std::memory_order_relaxed );
+
+			if( vector_observer * observer = global.observer.load( std::memory_order_acquire ) ){	observer->on_reallocate( vector, old_bytes, new_bytes, bytes_copied );	}
+		}
+
+		inline void record_shift( vector_stats & stats, const void * vector, std::size_t elements, std::size_t element_size )
+		{
+			global_vector_counters & global = vector_counters();
+
+			stats.shifts += elements;
+			global.shifts.fetch_add( elements, std::memory_order_relaxed );
+
+			if( vector_observer * observer = global.observer.load( std::memory_order_acquire ) ){	observer->on_shift( vector, elements, element_size );	}
+		}
+	}
+
+	/**
+	 * @brief Sends the events of every vector to observer, or to no one with nullptr. The observer must outlive
+	 * its registration.
+	 *
+	 * @param observer
+	 */
+	inline void set_vector_observer( vector_observer * observer ){	detail::vector_counters().observer.store( observer, std::memory_order_release );	}
+
+	/**
+	 * @brief Totals of every vector since the start of the program or the last reset.
+	 *
+	 * @return vector_stats
+	 */
+	inline vector_stats global_vector_stats( void )
+	{
+		const detail::global_vector_counters & global = detail::vector_counters();
+
+		vector_stats stats = vector_stats();
+		stats.allocations = global.allocations.load( std::memory_order_relaxed );
+		stats.reallocations = global.reallocations.load( std::memory_order_relaxed );
+		stats.bytes_copied = global.bytes_copied.load( std::memory_order_relaxed );
+		stats.shifts = global.shifts.load( std::memory_order_relaxed );
+		stats.peak_capacity_bytes = global.peak_capacity_bytes.load( std::memory_order_relaxed );
+		return stats;
+	}
+
+	inline void reset_global_vector_stats( void )
+	{
+		detail::global_vector_counters & global = detail::vector_counters();
+
+		global.allocations.store( 0, std::memory_order_relaxed );
+		global.reallocations.store( 0, std::memory_order_relaxed );
+		global.bytes_copied.store( 0, std::memory_order_relaxed );
+		global.shifts.store( 0, std::memory_order_relaxed );
+		global.peak_capacity_bytes.store( 0, std::memory_order_relaxed );
+	}
+
+	/**
+	 * @brief Writes stats as a JSON object, one key per counter.
+	 *
+	 * @param os
+	 * @param stats
+	 */
+	inline void write_json( std::ostream & os, const vector_stats & stats )
+	{
+		os << "{\"allocations\": " << stats.allocations
+			<< ", \"reallocations\": " << stats.reallocations
+			<< ", \"bytes_copied\": " << stats.bytes_copied
+			<< ", \"shifts\": " << stats.shifts
+			<< ", \"peak_capacity_bytes\": " << stats.peak_capacity_bytes
+			<< ", \"wasted_bytes\": " << stats.wasted_bytes << "}";
+	}
+
+	inline std::string to_json( const vector_stats & stats )
+	{
+		std::ostringstream os;
+		write_json( os, stats );
+		return os.str();
+	}
+};
+
+#endif
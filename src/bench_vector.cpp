@@ -0,0 +1,1047 @@
+#include <benchmark/benchmark.h>    // Google Benchmark
+#include <algorithm>                // std::equal
+#include <chrono>                   // std::chrono::steady_clock
+#include <cstdint>                  // std::int64_t
+#include <deque>                    // std::deque
+#include <map>                      // std::map
+#include <iterator>                 // std::next
+#include <numeric>                  // std::accumulate
+#include <memory>                   // std::allocator
+#include <mutex>                    // std::mutex, std::lock_guard
+#include <string>                   // std::string, std::to_string
+#include <type_traits>              // std::is_trivially_copyable
+#include <vector>                   // std::vector
+
+#include "../include/vector.h"      // header file for benchmarked functions
+#include "../include/mremap_allocator.h"
+#include "../include/concurrent_vector.h"
+#include "../include/parallel.h"
+#include "../include/soa_vector.h"
+#include "../include/persistent_vector.h"
+#include "../include/cow_vector.h"
+#include "../include/segmented_vector.h"
+#include "../include/flat_map.h"
+
+
+// An int that is not trivially copyable, so sc::vector has to shift it element by element.
+struct BoxedInt
+{
+    int value;
+
+    BoxedInt( int v = 0 ) : value(v) { }
+    BoxedInt( const BoxedInt & other ) : value(other.value) { }
+    BoxedInt & operator=( const BoxedInt & other ) { value = other.value; return *this; }
+};
+
+// ============================================================================
+// ALLOCATION COUNTING
+// ============================================================================
+
+// Allocation totals of the current benchmark run.
+struct AllocStats
+{
+    static std::size_t allocations;
+    static std::size_t bytes;
+};
+std::size_t AllocStats::allocations = 0;
+std::size_t AllocStats::bytes = 0;
+
+// std::allocator that records every allocation in AllocStats.
+template < typename T >
+struct CountingAllocator : std::allocator< T >
+{
+    template < typename U > struct rebind { typedef CountingAllocator< U > other; };
+
+    CountingAllocator( ) = default;
+    template < typename U > CountingAllocator( const CountingAllocator< U > & ) { }
+
+    T * allocate( std::size_t n )
+    {
+        AllocStats::allocations++;
+        AllocStats::bytes += n * sizeof( T );
+        return std::allocator< T >::allocate( n );
+    }
+};
+
+// ============================================================================
+// SHIFTING INSERTS (memmove fast path against element by element shifting)
+// ============================================================================
+
+template < typename T >
+static void BM_InsertFront( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+
+    sc::vector<T> vec( n + 1 );
+    for ( auto i{0u} ; i < n ; ++i )
+        vec.push_back( T( i ) );
+
+    for ( auto _ : state )
+    {
+        vec.insert( vec.begin(), T( 1 ) );
+        vec.erase( vec.begin() );
+        benchmark::DoNotOptimize( vec.data() );
+    }
+    state.SetBytesProcessed( state.iterations() * 2 * n * sizeof( T ) );
+}
+BENCHMARK_TEMPLATE( BM_InsertFront, int )->Arg( 10000000 )->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_InsertFront, BoxedInt )->Arg( 10000000 )->Unit( benchmark::kMillisecond );
+
+template < typename T >
+static void BM_PushPopFront( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+
+    sc::vector<T> vec( n + 1 );
+    for ( auto i{0u} ; i < n ; ++i )
+        vec.push_back( T( i ) );
+
+    for ( auto _ : state )
+    {
+        vec.push_front( T( 1 ) );
+        vec.pop_front();
+        benchmark::DoNotOptimize( vec.data() );
+    }
+    state.SetBytesProcessed( state.iterations() * 2 * n * sizeof( T ) );
+}
+BENCHMARK_TEMPLATE( BM_PushPopFront, int )->Arg( 10000000 )->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_PushPopFront, BoxedInt )->Arg( 10000000 )->Unit( benchmark::kMillisecond );
+
+template < typename T >
+static void BM_Copy( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+
+    sc::vector<T> vec( n );
+    for ( auto i{0u} ; i < n ; ++i )
+        vec.push_back( T( i ) );
+
+    for ( auto _ : state )
+    {
+        sc::vector<T> copy( vec );
+        benchmark::DoNotOptimize( copy.data() );
+    }
+    state.SetBytesProcessed( state.iterations() * n * sizeof( T ) );
+}
+BENCHMARK_TEMPLATE( BM_Copy, int )->Arg( 10000000 )->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_Copy, BoxedInt )->Arg( 10000000 )->Unit( benchmark::kMillisecond );
+
+// ============================================================================
+// GROWTH POLICIES (push_back throughput and bytes moved by reallocations)
+// ============================================================================
+
+template < typename Growth >
+static void BM_PushBackGrowth( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    std::size_t reallocations = 0, bytes = 0, capacity = 0;
+
+    for ( auto _ : state )
+    {
+        AllocStats::allocations = 0;
+        AllocStats::bytes = 0;
+
+        sc::vector< int, CountingAllocator< int >, Growth > vec;
+        for ( auto i{0u} ; i < n ; ++i )
+            vec.push_back( static_cast< int >( i ) );
+        benchmark::DoNotOptimize( vec.data() );
+
+        // The default constructor allocates an empty block, which isn't a growth.
+        reallocations = AllocStats::allocations - 1;
+        bytes = AllocStats::bytes;
+        capacity = vec.capacity();
+    }
+    state.SetItemsProcessed( state.iterations() * n );
+    state.counters["reallocs"] = static_cast< double >( reallocations );
+    state.counters["alloc_bytes"] = static_cast< double >( bytes );
+    state.counters["unused_pct"] = 100.0 * static_cast< double >( capacity - n ) / static_cast< double >( capacity );
+}
+BENCHMARK_TEMPLATE( BM_PushBackGrowth, sc::doubling_growth )->Arg( 1000 )->Arg( 1000000 );
+BENCHMARK_TEMPLATE( BM_PushBackGrowth, sc::golden_growth )->Arg( 1000 )->Arg( 1000000 );
+BENCHMARK_TEMPLATE( BM_PushBackGrowth, sc::page_growth<> )->Arg( 1000 )->Arg( 1000000 );
+BENCHMARK_TEMPLATE( BM_PushBackGrowth, sc::fixed_growth<4096> )->Arg( 1000 )->Arg( 1000000 );
+
+// Growth through the allocator's reallocate(): mremap moves the pages of large blocks instead of copying them.
+template < typename Allocator >
+static void BM_PushBackRealloc( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+
+    for ( auto _ : state )
+    {
+        sc::vector< std::int64_t, Allocator > vec;
+        for ( auto i{0u} ; i < n ; ++i )
+            vec.push_back( static_cast< std::int64_t >( i ) );
+        benchmark::DoNotOptimize( vec.data() );
+    }
+    state.SetItemsProcessed( state.iterations() * n );
+    state.SetBytesProcessed( state.iterations() * n * sizeof( std::int64_t ) );
+}
+BENCHMARK_TEMPLATE( BM_PushBackRealloc, std::allocator< std::int64_t > )->Arg( 1 << 20 )->Arg( 1 << 26 )->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_PushBackRealloc, sc::mremap_allocator< std::int64_t > )->Arg( 1 << 20 )->Arg( 1 << 26 )->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_PushBackRealloc, sc::huge_page_allocator< std::int64_t > )->Arg( 1 << 20 )->Arg( 1 << 26 )->Unit( benchmark::kMillisecond );
+
+// Sequential scan of a large vector, where huge pages save TLB misses.
+template < typename Allocator >
+static void BM_ScanPages( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    sc::vector< std::int64_t, Allocator > vec;
+    vec.reserve( n );
+    for ( auto i{0u} ; i < n ; ++i )
+        vec.push_back( static_cast< std::int64_t >( i ) );
+
+    for ( auto _ : state )
+    {
+        std::int64_t sum = 0;
+        for ( std::size_t i = 0 ; i < n ; i += 8 )
+            sum += vec[ ( i * 2654435761u ) % n ];
+        benchmark::DoNotOptimize( sum );
+    }
+    state.SetItemsProcessed( state.iterations() * ( n / 8 ) );
+}
+BENCHMARK_TEMPLATE( BM_ScanPages, sc::mremap_allocator< std::int64_t > )->Arg( 1 << 26 )->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_ScanPages, sc::huge_page_allocator< std::int64_t > )->Arg( 1 << 26 )->Unit( benchmark::kMillisecond );
+
+// ============================================================================
+// BATCHED ERASE (sc::erase_if against std::remove_if + erase, dropping 30%)
+// ============================================================================
+
+static int value_of( int value ) { return value; }
+static int value_of( const BoxedInt & value ) { return value.value; }
+
+// Drops about 30% of the elements, scattered so the branch predictor can't learn the pattern.
+struct Dropped
+{
+    template < typename T >
+    bool operator()( const T & value ) const { return ( static_cast< unsigned >( value_of( value ) ) * 2654435761u ) % 10 < 3; }
+};
+
+template < typename T >
+static void BM_EraseIf( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+
+    for ( auto _ : state )
+    {
+        state.PauseTiming();
+        sc::vector<T> vec( n );
+        for ( auto i{0u} ; i < n ; ++i )
+            vec.push_back( T( i ) );
+        state.ResumeTiming();
+
+        sc::erase_if( vec, Dropped() );
+        benchmark::DoNotOptimize( vec.data() );
+    }
+    state.SetItemsProcessed( state.iterations() * n );
+}
+BENCHMARK_TEMPLATE( BM_EraseIf, int )->Arg( 10000000 )->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_EraseIf, BoxedInt )->Arg( 10000000 )->Unit( benchmark::kMillisecond );
+
+template < typename T >
+static void BM_RemoveIfErase( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+
+    for ( auto _ : state )
+    {
+        state.PauseTiming();
+        sc::vector<T> vec( n );
+        for ( auto i{0u} ; i < n ; ++i )
+            vec.push_back( T( i ) );
+        state.ResumeTiming();
+
+        vec.erase( std::remove_if( vec.begin(), vec.end(), Dropped() ), vec.end() );
+        benchmark::DoNotOptimize( vec.data() );
+    }
+    state.SetItemsProcessed( state.iterations() * n );
+}
+BENCHMARK_TEMPLATE( BM_RemoveIfErase, int )->Arg( 10000000 )->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_RemoveIfErase, BoxedInt )->Arg( 10000000 )->Unit( benchmark::kMillisecond );
+
+// ============================================================================
+// LOOKUP (SIMD find and count against std::find and std::count)
+// ============================================================================
+
+template < typename T >
+static void BM_FindCount( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+
+    sc::vector<T> vec( n );
+    for ( auto i{0u} ; i < n ; ++i )
+        vec.push_back( static_cast< T >( i % 100 ) );
+
+    for ( auto _ : state )
+    {
+        // Not present: find scans everything.
+        benchmark::DoNotOptimize( vec.find( T( 100 ) ) );
+        benchmark::DoNotOptimize( vec.count( T( 7 ) ) );
+    }
+    state.SetItemsProcessed( state.iterations() * 2 * n );
+}
+BENCHMARK_TEMPLATE( BM_FindCount, int )->Arg( 1000000 );
+BENCHMARK_TEMPLATE( BM_FindCount, double )->Arg( 1000000 );
+
+template < typename T >
+static void BM_StdFindCount( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+
+    std::vector<T> vec;
+    for ( auto i{0u} ; i < n ; ++i )
+        vec.push_back( static_cast< T >( i % 100 ) );
+
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( std::find( vec.begin(), vec.end(), T( 100 ) ) );
+        benchmark::DoNotOptimize( std::count( vec.begin(), vec.end(), T( 7 ) ) );
+    }
+    state.SetItemsProcessed( state.iterations() * 2 * n );
+}
+BENCHMARK_TEMPLATE( BM_StdFindCount, int )->Arg( 1000000 );
+BENCHMARK_TEMPLATE( BM_StdFindCount, double )->Arg( 1000000 );
+
+// ============================================================================
+// CONCURRENT APPEND (sc::concurrent_vector against sc::vector behind a mutex)
+// ============================================================================
+
+// Each iteration appends a batch to a vector shared by every thread of the run.
+static const int append_batch = 1000;
+
+static sc::concurrent_vector< int > * shared_concurrent = nullptr;
+
+static void BM_ConcurrentPushBack( benchmark::State & state )
+{
+    if ( state.thread_index() == 0 )
+        shared_concurrent = new sc::concurrent_vector< int >;
+
+    for ( auto _ : state )
+        for ( int i = 0 ; i < append_batch ; ++i )
+            shared_concurrent->push_back( i );
+
+    if ( state.thread_index() == 0 )
+    {
+        delete shared_concurrent;
+        shared_concurrent = nullptr;
+    }
+    state.SetItemsProcessed( state.iterations() * append_batch );
+}
+BENCHMARK( BM_ConcurrentPushBack )->ThreadRange( 1, 64 )->UseRealTime();
+
+static void BM_ConcurrentGrowBy( benchmark::State & state )
+{
+    if ( state.thread_index() == 0 )
+        shared_concurrent = new sc::concurrent_vector< int >;
+
+    for ( auto _ : state )
+        benchmark::DoNotOptimize( shared_concurrent->grow_by( append_batch, 7 ) );
+
+    if ( state.thread_index() == 0 )
+    {
+        delete shared_concurrent;
+        shared_concurrent = nullptr;
+    }
+    state.SetItemsProcessed( state.iterations() * append_batch );
+}
+BENCHMARK( BM_ConcurrentGrowBy )->ThreadRange( 1, 64 )->UseRealTime();
+
+static sc::vector< int > * shared_locked = nullptr;
+static std::mutex shared_lock;
+
+static void BM_MutexPushBack( benchmark::State & state )
+{
+    if ( state.thread_index() == 0 )
+        shared_locked = new sc::vector< int >;
+
+    for ( auto _ : state )
+        for ( int i = 0 ; i < append_batch ; ++i )
+        {
+            std::lock_guard< std::mutex > guard( shared_lock );
+            shared_locked->push_back( i );
+        }
+
+    if ( state.thread_index() == 0 )
+    {
+        delete shared_locked;
+        shared_locked = nullptr;
+    }
+    state.SetItemsProcessed( state.iterations() * append_batch );
+}
+BENCHMARK( BM_MutexPushBack )->ThreadRange( 1, 64 )->UseRealTime();
+
+// ============================================================================
+// PARALLEL BULK OPERATIONS (sc::par against the sequential versions)
+// ============================================================================
+
+static void BM_FillConstruct( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    for ( auto _ : state )
+    {
+        sc::vector< int > vec( n );
+        vec.assign( n, 7 );
+        benchmark::DoNotOptimize( vec.data() );
+    }
+    state.SetBytesProcessed( state.iterations() * n * sizeof( int ) );
+}
+BENCHMARK( BM_FillConstruct )->Arg( 1 << 26 )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+static void BM_ParFillConstruct( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    for ( auto _ : state )
+    {
+        sc::vector< int > vec( sc::par, n, 7 );
+        benchmark::DoNotOptimize( vec.data() );
+    }
+    state.SetBytesProcessed( state.iterations() * n * sizeof( int ) );
+}
+BENCHMARK( BM_ParFillConstruct )->Arg( 1 << 26 )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+static void BM_CopyConstruct( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    const sc::vector< int > model( sc::par, n, 7 );
+    for ( auto _ : state )
+    {
+        sc::vector< int > vec( model );
+        benchmark::DoNotOptimize( vec.data() );
+    }
+    state.SetBytesProcessed( state.iterations() * n * sizeof( int ) );
+}
+BENCHMARK( BM_CopyConstruct )->Arg( 1 << 26 )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+static void BM_ParCopyConstruct( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    const sc::vector< int > model( sc::par, n, 7 );
+    for ( auto _ : state )
+    {
+        sc::vector< int > vec( sc::par, model );
+        benchmark::DoNotOptimize( vec.data() );
+    }
+    state.SetBytesProcessed( state.iterations() * n * sizeof( int ) );
+}
+BENCHMARK( BM_ParCopyConstruct )->Arg( 1 << 26 )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+static void BM_Accumulate( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    const sc::vector< double > vec( sc::par, n, 0.5 );
+    for ( auto _ : state )
+        benchmark::DoNotOptimize( std::accumulate( vec.begin(), vec.end(), 0.0 ) );
+    state.SetBytesProcessed( state.iterations() * n * sizeof( double ) );
+}
+BENCHMARK( BM_Accumulate )->Arg( 1 << 25 )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+static void BM_ParReduce( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    const sc::vector< double > vec( sc::par, n, 0.5 );
+    for ( auto _ : state )
+        benchmark::DoNotOptimize( sc::reduce( sc::par, vec.begin(), vec.end(), 0.0 ) );
+    state.SetBytesProcessed( state.iterations() * n * sizeof( double ) );
+}
+BENCHMARK( BM_ParReduce )->Arg( 1 << 25 )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+// ============================================================================
+// STRUCTURE OF ARRAYS (a scan reading 2 of 10 fields, sc::vector of records against sc::soa_vector)
+// ============================================================================
+
+struct Record
+{
+    std::int64_t id;
+    double price;
+    double quantity;
+    std::int64_t fields[7];
+};
+
+static void BM_ScanRecords( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    sc::vector< Record > records( n );
+    for ( auto i{0u} ; i < n ; ++i )
+        records.push_back( Record{ i, 1.0 * i, 2.0, {} } );
+
+    for ( auto _ : state )
+    {
+        double total = 0;
+        for ( const auto & record : records )
+            total += record.price * record.quantity;
+        benchmark::DoNotOptimize( total );
+    }
+    state.SetItemsProcessed( state.iterations() * n );
+}
+BENCHMARK( BM_ScanRecords )->Arg( 1 << 22 );
+
+typedef sc::soa_vector< std::int64_t, double, double, std::int64_t, std::int64_t, std::int64_t, std::int64_t,
+        std::int64_t, std::int64_t, std::int64_t > RecordColumns;
+
+static void BM_ScanColumns( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    RecordColumns records;
+    records.reserve( n );
+    for ( auto i{0u} ; i < n ; ++i )
+        records.emplace_back( std::int64_t( i ), 1.0 * i, 2.0, 0, 0, 0, 0, 0, 0, 0 );
+
+    for ( auto _ : state )
+    {
+        const auto price = records.column< 1 >();
+        const auto quantity = records.column< 2 >();
+        double total = 0;
+        for ( std::size_t i = 0 ; i < price.size() ; ++i )
+            total += price[i] * quantity[i];
+        benchmark::DoNotOptimize( total );
+    }
+    state.SetItemsProcessed( state.iterations() * n );
+}
+BENCHMARK( BM_ScanColumns )->Arg( 1 << 22 );
+
+// ============================================================================
+// VERSIONED SNAPSHOTS (one element changed per version, sc::vector copies against sc::persistent_vector)
+// ============================================================================
+
+static void BM_VersionByCopy( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    sc::vector< std::int64_t > current( n );
+    for ( auto i{0u} ; i < n ; ++i )
+        current.push_back( i );
+
+    std::size_t index = 0;
+    for ( auto _ : state )
+    {
+        sc::vector< std::int64_t > next( current );
+        next[index] += 1;
+        current = std::move( next );
+        index = ( index + 7919 ) % n;
+    }
+    benchmark::DoNotOptimize( current[0] );
+}
+BENCHMARK( BM_VersionByCopy )->RangeMultiplier( 32 )->Range( 1 << 10, 1 << 20 );
+
+static void BM_VersionByPersistent( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    sc::transient_vector< std::int64_t > builder;
+    for ( auto i{0u} ; i < n ; ++i )
+        builder.push_back( i );
+    sc::persistent_vector< std::int64_t > current = builder.persistent();
+
+    std::size_t index = 0;
+    for ( auto _ : state )
+    {
+        current = current.set( index, current[index] + 1 );
+        index = ( index + 7919 ) % n;
+    }
+    benchmark::DoNotOptimize( current[0] );
+}
+BENCHMARK( BM_VersionByPersistent )->RangeMultiplier( 32 )->Range( 1 << 10, 1 << 20 );
+
+// ============================================================================
+// HUGE APPENDS (sc::vector doubling against sc::segmented_vector chunks, with the longest stall)
+// ============================================================================
+
+// n push_back, timed in batches of 4096 to report the slowest batch, where the vector copies itself.
+template < typename Container >
+static void BM_Append( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    double stall = 0;
+
+    for ( auto _ : state )
+    {
+        Container c;
+        for ( std::size_t i = 0 ; i < n ; )
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for ( const std::size_t batch_end = std::min( n, i + 4096 ) ; i < batch_end ; ++i )
+                c.push_back( static_cast< std::int64_t >( i ) );
+            stall = std::max( stall, std::chrono::duration< double, std::micro >( std::chrono::steady_clock::now() - start ).count() );
+        }
+        benchmark::DoNotOptimize( c.size() );
+    }
+    state.SetItemsProcessed( state.iterations() * n );
+    state.counters["max_stall_us"] = stall;
+}
+BENCHMARK_TEMPLATE( BM_Append, sc::vector< std::int64_t > )->Arg( 1 << 22 )->Arg( 1 << 25 )->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_Append, sc::segmented_vector< std::int64_t > )->Arg( 1 << 22 )->Arg( 1 << 25 )->Unit( benchmark::kMillisecond );
+
+// Sum of every element, one vectorizable loop per chunk.
+static void BM_SumSegments( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    sc::segmented_vector< std::int64_t > c;
+    for ( auto i{0u} ; i < n ; ++i )
+        c.push_back( i );
+
+    for ( auto _ : state )
+    {
+        std::int64_t total = 0;
+        c.for_each_segment( [&total]( const std::int64_t * first, const std::int64_t * last ) { total = std::accumulate( first, last, total ); } );
+        benchmark::DoNotOptimize( total );
+    }
+    state.SetItemsProcessed( state.iterations() * n );
+}
+BENCHMARK( BM_SumSegments )->Arg( 1 << 22 );
+
+static void BM_SumContiguous( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    sc::vector< std::int64_t > c( n );
+    for ( auto i{0u} ; i < n ; ++i )
+        c.push_back( i );
+
+    for ( auto _ : state )
+        benchmark::DoNotOptimize( std::accumulate( c.begin(), c.end(), std::int64_t( 0 ) ) );
+    state.SetItemsProcessed( state.iterations() * n );
+}
+BENCHMARK( BM_SumContiguous )->Arg( 1 << 22 );
+
+// ============================================================================
+// BITMAPS (packed sc::vector< bool > against one byte per flag)
+// ============================================================================
+
+// A filter bitmap with about 1 row in 8 selected.
+template < typename Bitmap >
+static Bitmap make_filter( std::size_t n )
+{
+    Bitmap bits;
+    for ( std::size_t i = 0 ; i < n ; ++i )
+        bits.push_back( ( i * 2654435761u ) % 8 == 0 );
+    return bits;
+}
+
+static void BM_BitmapCount( benchmark::State & state )
+{
+    const auto bits = make_filter< sc::vector< bool > >( static_cast< std::size_t >( state.range(0) ) );
+    for ( auto _ : state )
+        benchmark::DoNotOptimize( bits.count() );
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+    state.counters["bytes"] = static_cast< double >( bits.word_count() * sizeof( std::uint64_t ) );
+}
+BENCHMARK( BM_BitmapCount )->Arg( 1 << 26 );
+
+static void BM_ByteFlagsCount( benchmark::State & state )
+{
+    const auto flags = make_filter< sc::vector< unsigned char > >( static_cast< std::size_t >( state.range(0) ) );
+    for ( auto _ : state )
+        benchmark::DoNotOptimize( std::count( flags.begin(), flags.end(), 1 ) );
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+    state.counters["bytes"] = static_cast< double >( flags.size() );
+}
+BENCHMARK( BM_ByteFlagsCount )->Arg( 1 << 26 );
+
+// Intersection of two filters, then a walk over the rows selected by both.
+static void BM_BitmapAndScan( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    const auto a = make_filter< sc::vector< bool > >( n );
+    auto b = make_filter< sc::vector< bool > >( n );
+    b.flip();
+
+    for ( auto _ : state )
+    {
+        const sc::vector< bool > both = a & b;
+        std::size_t rows = 0;
+        for ( auto i = both.find_first() ; i != sc::vector< bool >::npos ; i = both.find_next( i ) )
+            rows += i;
+        benchmark::DoNotOptimize( rows );
+    }
+    state.SetItemsProcessed( state.iterations() * n );
+}
+BENCHMARK( BM_BitmapAndScan )->Arg( 1 << 26 );
+
+static void BM_ByteFlagsAndScan( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    const auto a = make_filter< sc::vector< unsigned char > >( n );
+    auto b = make_filter< sc::vector< unsigned char > >( n );
+    for ( auto & flag : b )
+        flag = not flag;
+
+    for ( auto _ : state )
+    {
+        sc::vector< unsigned char > both( a );
+        for ( std::size_t i = 0 ; i < n ; ++i )
+            both[i] &= b[i];
+        std::size_t rows = 0;
+        for ( std::size_t i = 0 ; i < n ; ++i )
+            if ( both[i] )
+                rows += i;
+        benchmark::DoNotOptimize( rows );
+    }
+    state.SetItemsProcessed( state.iterations() * n );
+}
+BENCHMARK( BM_ByteFlagsAndScan )->Arg( 1 << 26 );
+
+// ============================================================================
+// SORTED LOOKUP TABLES (sc::flat_map against std::map)
+// ============================================================================
+
+// Distinct keys in no particular order: i times an odd constant, modulo 2^64.
+static std::uint64_t table_key( std::size_t i ) { return static_cast< std::uint64_t >( i ) * 0x9E3779B97F4A7C15ull; }
+
+static void fill_table( std::map< std::uint64_t, std::uint64_t > & table, std::size_t n )
+{
+    for ( std::size_t i = 0 ; i < n ; ++i )
+        table.emplace( table_key( i ), i );
+}
+
+static void fill_table( sc::flat_map< std::uint64_t, std::uint64_t > & table, std::size_t n )
+{
+    table.reserve( n );
+    for ( std::size_t i = 0 ; i < n ; ++i )
+        table.append_unsorted( table_key( i ), i );
+    table.sort_unique();
+}
+
+template < typename Map >
+static void BM_TableBuild( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    for ( auto _ : state )
+    {
+        Map table;
+        fill_table( table, n );
+        benchmark::DoNotOptimize( table.size() );
+    }
+    state.SetItemsProcessed( state.iterations() * n );
+}
+BENCHMARK_TEMPLATE( BM_TableBuild, std::map< std::uint64_t, std::uint64_t > )->Arg( 1 << 20 )->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_TableBuild, sc::flat_map< std::uint64_t, std::uint64_t > )->Arg( 1 << 20 )->Unit( benchmark::kMillisecond );
+
+// Hits in a scattered order, so each lookup starts from a cold path.
+template < typename Map >
+static void BM_TableFind( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    Map table;
+    fill_table( table, n );
+
+    std::size_t probe = 0;
+    for ( auto _ : state )
+    {
+        std::uint64_t sum = 0;
+        for ( std::size_t i = 0 ; i < 1024 ; ++i, probe = ( probe + 40503 ) % n )
+            sum += table.find( table_key( probe ) )->second;
+        benchmark::DoNotOptimize( sum );
+    }
+    state.SetItemsProcessed( state.iterations() * 1024 );
+}
+BENCHMARK_TEMPLATE( BM_TableFind, std::map< std::uint64_t, std::uint64_t > )->Arg( 1 << 10 )->Arg( 1 << 20 );
+BENCHMARK_TEMPLATE( BM_TableFind, sc::flat_map< std::uint64_t, std::uint64_t > )->Arg( 1 << 10 )->Arg( 1 << 20 );
+
+// ============================================================================
+// CONTAINER COMPARISON (sc::vector side by side with std::vector and std::deque)
+// ============================================================================
+
+// Element types: scalars, a string long enough to live on the heap and a 64 byte POD.
+struct Pod64
+{
+    std::int64_t v[8];
+};
+bool operator==( const Pod64 & lhs, const Pod64 & rhs ) { return std::equal( lhs.v, lhs.v + 8, rhs.v ); }
+
+template < typename T >
+struct Value
+{
+    static T make( std::size_t i ) { return static_cast< T >( i ); }
+    static std::size_t weight( const T & value ) { return static_cast< std::size_t >( value ); }
+};
+
+template < >
+struct Value< std::string >
+{
+    static std::string make( std::size_t i ) { return "element number " + std::to_string( i ); }
+    static std::size_t weight( const std::string & value ) { return value.size(); }
+};
+
+template < >
+struct Value< Pod64 >
+{
+    static Pod64 make( std::size_t i ) { Pod64 pod = { { static_cast< std::int64_t >( i ) } }; return pod; }
+    static std::size_t weight( const Pod64 & value ) { return static_cast< std::size_t >( value.v[0] ); }
+};
+
+// The containers compared, all of them allocating through CountingAllocator.
+template < typename T > using sc_vector = sc::vector< T, CountingAllocator< T > >;
+template < typename T > using std_vector = std::vector< T, CountingAllocator< T > >;
+template < typename T > using std_deque = std::deque< T, CountingAllocator< T > >;
+
+// Operations missing from some of the containers.
+template < typename Container, typename U >
+void push_front( Container & c, U && value ) { c.insert( c.begin(), std::forward< U >( value ) ); }
+template < typename T, typename A, typename U >
+void push_front( std::deque< T, A > & c, U && value ) { c.push_front( std::forward< U >( value ) ); }
+
+template < typename Container >
+void reserve( Container & c, std::size_t n ) { c.reserve( n ); }
+template < typename T, typename A >
+void reserve( std::deque< T, A > &, std::size_t ) { /* No reserve, it just grows */ }
+
+template < typename Container >
+void fill( Container & c, std::size_t n )
+{
+    typedef typename Container::value_type T;
+    for ( auto i{0u} ; i < n ; ++i )
+        c.push_back( Value< T >::make( i ) );
+}
+
+// Sizes from 8 up to 100M elements. Large element types stop at 2M, so every run fits in memory.
+template < typename Container >
+void all_sizes( benchmark::internal::Benchmark * b )
+{
+    typedef typename Container::value_type T;
+    const bool small = sizeof( T ) <= 8 and std::is_trivially_copyable< T >::value;
+
+    for ( std::int64_t n = 8 ; n <= ( small ? 16777216 : 2097152 ) ; n *= 8 )
+        b->Arg( n );
+    if ( small )
+        b->Arg( 100000000 );
+}
+
+// For the operations that are O(n) per element on a vector.
+template < typename Container >
+void quadratic_sizes( benchmark::internal::Benchmark * b )
+{
+    for ( std::int64_t n = 8 ; n <= 32768 ; n *= 8 )
+        b->Arg( n );
+}
+
+// Adds the time per operation (in seconds), allocations and bytes allocated per iteration to the report.
+// AllocStats must be cleared right before the timed loop.
+static void report( benchmark::State & state, std::size_t ops_per_iteration )
+{
+    const double ops = static_cast< double >( state.iterations() * ops_per_iteration );
+
+    state.SetItemsProcessed( state.iterations() * ops_per_iteration );
+    state.counters["time_per_op"] = benchmark::Counter( ops, benchmark::Counter::kIsRate | benchmark::Counter::kInvert );
+    state.counters["allocs"] = benchmark::Counter( static_cast< double >( AllocStats::allocations ), benchmark::Counter::kAvgIterations );
+    state.counters["alloc_bytes"] = benchmark::Counter( static_cast< double >( AllocStats::bytes ), benchmark::Counter::kAvgIterations );
+}
+
+static void reset_stats( void )
+{
+    AllocStats::allocations = 0;
+    AllocStats::bytes = 0;
+}
+
+// n push_back into an empty container.
+template < typename Container >
+static void BM_PushBack( benchmark::State & state )
+{
+    typedef typename Container::value_type T;
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    const T value = Value< T >::make( 1 );
+
+    reset_stats();
+    for ( auto _ : state )
+    {
+        Container c;
+        for ( auto i{0u} ; i < n ; ++i )
+            c.push_back( value );
+        benchmark::DoNotOptimize( &c.back() );
+    }
+    report( state, n );
+}
+
+// n push_back into a container that reserved room for all of them first.
+template < typename Container >
+static void BM_Reserve( benchmark::State & state )
+{
+    typedef typename Container::value_type T;
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    const T value = Value< T >::make( 1 );
+
+    reset_stats();
+    for ( auto _ : state )
+    {
+        Container c;
+        reserve( c, n );
+        for ( auto i{0u} ; i < n ; ++i )
+            c.push_back( value );
+        benchmark::DoNotOptimize( &c.back() );
+    }
+    report( state, n );
+}
+
+// n push_front into an empty container (insert at begin() on the vectors).
+template < typename Container >
+static void BM_PushFront( benchmark::State & state )
+{
+    typedef typename Container::value_type T;
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    const T value = Value< T >::make( 1 );
+
+    reset_stats();
+    for ( auto _ : state )
+    {
+        Container c;
+        for ( auto i{0u} ; i < n ; ++i )
+            push_front( c, value );
+        benchmark::DoNotOptimize( &c.front() );
+    }
+    report( state, n );
+}
+
+// One insert in the middle of n elements; the pop_back that keeps the size fixed is O(1).
+template < typename Container >
+static void BM_Insert( benchmark::State & state )
+{
+    typedef typename Container::value_type T;
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    const T value = Value< T >::make( 1 );
+
+    Container c;
+    fill( c, n );
+    reserve( c, n + 1 );
+
+    reset_stats();
+    for ( auto _ : state )
+    {
+        c.insert( std::next( c.begin(), n / 2 ), value );
+        c.pop_back();
+        benchmark::DoNotOptimize( &c.front() );
+    }
+    report( state, 1 );
+}
+
+// One erase in the middle of n elements; the push_back that keeps the size fixed is O(1).
+template < typename Container >
+static void BM_Erase( benchmark::State & state )
+{
+    typedef typename Container::value_type T;
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    const T value = Value< T >::make( 1 );
+
+    Container c;
+    fill( c, n );
+
+    reset_stats();
+    for ( auto _ : state )
+    {
+        c.erase( std::next( c.begin(), n / 2 ) );
+        c.push_back( value );
+        benchmark::DoNotOptimize( &c.front() );
+    }
+    report( state, 1 );
+}
+
+template < typename Container >
+static void BM_CopyContainer( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+
+    Container c;
+    fill( c, n );
+
+    reset_stats();
+    for ( auto _ : state )
+    {
+        Container copy( c );
+        benchmark::DoNotOptimize( &copy.back() );
+    }
+    report( state, n );
+}
+
+// operator== on two equal containers, the worst case.
+template < typename Container >
+static void BM_Compare( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+
+    Container lhs, rhs;
+    fill( lhs, n );
+    fill( rhs, n );
+
+    reset_stats();
+    for ( auto _ : state )
+    {
+        bool equal = ( lhs == rhs );
+        benchmark::DoNotOptimize( equal );
+    }
+    report( state, n );
+}
+
+// A range-for over every element.
+template < typename Container >
+static void BM_Iterate( benchmark::State & state )
+{
+    typedef typename Container::value_type T;
+    const auto n = static_cast< std::size_t >( state.range(0) );
+
+    Container c;
+    fill( c, n );
+
+    reset_stats();
+    for ( auto _ : state )
+    {
+        std::size_t sum = 0;
+        for ( const auto & value : c )
+            sum += Value< T >::weight( value );
+        benchmark::DoNotOptimize( sum );
+    }
+    report( state, n );
+}
+
+#define COMPARE_CONTAINER( Container )                                                                          \
+    BENCHMARK_TEMPLATE( BM_PushBack, Container )->Apply( all_sizes< Container > );                              \
+    BENCHMARK_TEMPLATE( BM_Reserve, Container )->Apply( all_sizes< Container > );                               \
+    BENCHMARK_TEMPLATE( BM_PushFront, Container )->Apply( quadratic_sizes< Container > );                       \
+    BENCHMARK_TEMPLATE( BM_Insert, Container )->Apply( all_sizes< Container > );                                \
+    BENCHMARK_TEMPLATE( BM_Erase, Container )->Apply( all_sizes< Container > );                                 \
+    BENCHMARK_TEMPLATE( BM_CopyContainer, Container )->Apply( all_sizes< Container > );                         \
+    BENCHMARK_TEMPLATE( BM_Compare, Container )->Apply( all_sizes< Container > );                               \
+    BENCHMARK_TEMPLATE( BM_Iterate, Container )->Apply( all_sizes< Container > )
+
+#define COMPARE_ELEMENT( T )                \
+    COMPARE_CONTAINER( sc_vector< T > );    \
+    COMPARE_CONTAINER( std_vector< T > );   \
+    COMPARE_CONTAINER( std_deque< T > )
+
+COMPARE_ELEMENT( int );
+COMPARE_ELEMENT( double );
+COMPARE_ELEMENT( std::string );
+COMPARE_ELEMENT( Pod64 );
+
+// ============================================================================
+// COPY-HEAVY PIPELINE (sc::vector copies against sc::cow_vector sharing)
+// ============================================================================
+
+// A batch goes through 8 stages that each take their own copy; only the last one changes an element.
+template < typename Container >
+static std::int64_t read_stage( Container batch )
+{
+    const Container & view = batch;
+    return std::accumulate( view.begin(), view.end(), std::int64_t( 0 ) );
+}
+
+static void write_stage( sc_vector< std::int64_t > batch ) { batch[0] = -1; benchmark::DoNotOptimize( batch.data() ); }
+static void write_stage( sc::cow_vector< std::int64_t, CountingAllocator< std::int64_t > > batch ) { batch.set( 0, -1 ); benchmark::DoNotOptimize( batch.get().data() ); }
+
+template < typename Container >
+static void BM_Pipeline( benchmark::State & state )
+{
+    const auto n = static_cast< std::size_t >( state.range(0) );
+    Container batch;
+    for ( auto i{0u} ; i < n ; ++i )
+        batch.push_back( i );
+
+    reset_stats();
+    for ( auto _ : state )
+    {
+        std::int64_t total = 0;
+        for ( int stage = 0 ; stage < 7 ; ++stage )
+            total += read_stage( batch );
+        write_stage( batch );
+        benchmark::DoNotOptimize( total );
+    }
+    report( state, 8 );
+}
+BENCHMARK_TEMPLATE( BM_Pipeline, sc_vector< std::int64_t > )->RangeMultiplier( 32 )->Range( 1 << 10, 1 << 20 );
+BENCHMARK_TEMPLATE( BM_Pipeline, sc::cow_vector< std::int64_t, CountingAllocator< std::int64_t > > )->RangeMultiplier( 32 )->Range( 1 << 10, 1 << 20 );
+
+BENCHMARK_MAIN();
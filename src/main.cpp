@@ -1,9 +1,31 @@
 #include <iterator>             // std::begin(), std::end()
 #include <functional>           // std::function
 #include <algorithm>            // std::min_element
+#include <memory>               // std::allocator
+#include <vector>               // std::vector
+#include <sstream>              // std::istringstream
+#include <string>               // std::string
+#include <limits>               // std::numeric_limits
+#include <cstdio>               // std::remove
+#include <thread>               // std::thread
+#include <numeric>              // std::iota
 
 #include "gtest/gtest.h"        // gtest lib
 #include "../include/vector.h"   // header file for tested functions
+#include "../include/small_vector.h"
+#include "../include/static_vector.h"
+#include "../include/ring_vector.h"
+#include "../include/gap_vector.h"
+#include "../include/mmap_vector.h"
+#include "../include/mremap_allocator.h"
+#include "../include/concurrent_vector.h"
+#include "../include/parallel.h"
+#include "../include/soa_vector.h"
+#include "../include/persistent_vector.h"
+#include "../include/cow_vector.h"
+#include "../include/segmented_vector.h"
+#include "../include/flat_set.h"
+#include "../include/flat_map.h"
 
 
 
@@ -95,7 +117,6 @@ TEST(IntVector, AssignOperator)
     for( auto i{0u} ; i < vec2.size() ; ++i )
         ASSERT_EQ( i+1, vec2[i] );
 }
-/*
 TEST(IntVector, MoveAssignOperator)
 {
     // Range = the entire vector.
@@ -113,7 +134,42 @@ TEST(IntVector, MoveAssignOperator)
     for( auto i{0u} ; i < vec2.size() ; ++i )
         ASSERT_EQ( i+1, vec2[i] );
 }
-*/
+
+TEST(IntVector, MoveConstructor)
+{
+    sc::vector<int> vec{ 1, 2, 3, 4, 5 };
+    auto storage = vec.data();
+
+    sc::vector<int> vec2( std::move( vec ) );
+    ASSERT_EQ( vec2.size(), 5 );
+    EXPECT_EQ( vec2.data(), storage );
+    EXPECT_EQ( vec.size(), 0 );
+    EXPECT_EQ( vec.capacity(), 0 );
+    EXPECT_TRUE( vec.empty() );
+
+    for( auto i{0u} ; i < vec2.size() ; ++i )
+        ASSERT_EQ( i+1, vec2[i] );
+
+    // A moved-from vector can be used again.
+    vec.push_back( 42 );
+    vec.push_back( 43 );
+    ASSERT_EQ( vec.size(), 2 );
+    EXPECT_EQ( vec.back(), 43 );
+}
+
+TEST(IntVector, Swap)
+{
+    sc::vector<int> vec{ 1, 2, 3 };
+    sc::vector<int> vec2{ 4, 5, 6, 7, 8 };
+
+    vec.swap( vec2 );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 4, 5, 6, 7, 8 } ) );
+    ASSERT_EQ( vec2 , ( sc::vector<int>{ 1, 2, 3 } ) );
+
+    swap( vec, vec2 );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 1, 2, 3 } ) );
+    ASSERT_EQ( vec2 , ( sc::vector<int>{ 4, 5, 6, 7, 8 } ) );
+}
 
 TEST(IntVector, ListInitializerAssign)
 {
@@ -435,7 +491,80 @@ TEST(IntVector, OperatorDifferent)
     ASSERT_NE( vec, vec3 );
     ASSERT_NE( vec,vec4 );
 } 
-/*
+
+TEST(IntVector, OperatorLess)
+{
+    sc::vector<int> vec { 1, 2, 3, 4, 5 };
+
+    ASSERT_TRUE( vec < ( sc::vector<int>{ 1, 2, 4 } ) );
+    ASSERT_TRUE( ( sc::vector<int>{ 1, 2 } ) < vec );
+    ASSERT_FALSE( vec < vec );
+    ASSERT_TRUE( vec <= vec and vec >= vec );
+    ASSERT_TRUE( vec > ( sc::vector<int>{} ) );
+}
+
+TEST(IntVector, FindCountContains)
+{
+    sc::vector<int> vec { 1, 2, 3, 2, 5 };
+
+    ASSERT_EQ( vec.find( 2 ) , std::next( vec.begin(), 1 ) );
+    ASSERT_EQ( vec.find( 7 ) , vec.end() );
+    ASSERT_EQ( vec.count( 2 ) , 2 );
+    ASSERT_TRUE( vec.contains( 5 ) );
+    ASSERT_FALSE( vec.contains( 0 ) );
+}
+
+// Checks the comparisons against the STL at every length and mismatch position around the SIMD block
+// sizes, so the vector loop, the scalar tail and the hand-off between them are all covered.
+template < typename T >
+void check_simd_kernels( void )
+{
+    for ( std::size_t n = 0 ; n < 80 ; ++n )
+    {
+        std::vector< T > a( n );
+        for ( std::size_t i = 0 ; i < n ; ++i )
+            a[i] = static_cast< T >( i % 7 );
+
+        ASSERT_EQ( sc::simd::count( a.data(), n, T( 3 ) ), static_cast< std::size_t >( std::count( a.begin(), a.end(), T( 3 ) ) ) );
+        for ( std::size_t at = 0 ; at < n ; ++at )
+        {
+            std::vector< T > b( a );
+            b[at] = T( 100 );
+            ASSERT_EQ( sc::simd::mismatch( a.data(), b.data(), n ), at );
+            ASSERT_EQ( sc::simd::find( b.data(), n, T( 100 ) ), at );
+            ASSERT_TRUE( sc::simd::less( a.data(), n, b.data(), n ) );
+            ASSERT_FALSE( sc::simd::less( b.data(), n, a.data(), n ) );
+        }
+        ASSERT_EQ( sc::simd::mismatch( a.data(), a.data(), n ), n );
+        ASSERT_EQ( sc::simd::find( a.data(), n, T( 100 ) ), n );
+    }
+}
+
+TEST(SimdKernels, MatchTheStl)
+{
+    check_simd_kernels< char >();
+    check_simd_kernels< unsigned short >();
+    check_simd_kernels< int >();
+    check_simd_kernels< long long >();
+    check_simd_kernels< float >();
+    check_simd_kernels< double >();
+}
+
+TEST(SimdKernels, FloatingPointSemantics)
+{
+    const double nan = std::numeric_limits< double >::quiet_NaN();
+    sc::vector< double > vec { 0.0, 1.0, nan, 3.0 };
+
+    // NaN is never equal, not even to itself; -0.0 equals 0.0.
+    ASSERT_NE( vec , vec );
+    ASSERT_EQ( ( sc::vector< double >{ -0.0, 1.0 } ) , ( sc::vector< double >{ 0.0, 1.0 } ) );
+    ASSERT_FALSE( vec.contains( nan ) );
+    ASSERT_EQ( vec.find( -0.0 ) , vec.begin() );
+
+    // Unordered elements are skipped, as in std::lexicographical_compare.
+    ASSERT_TRUE( vec < ( sc::vector< double >{ 0.0, 1.0, nan, 4.0 } ) );
+}
+
 TEST(IntVector, InsertSingleValueAtPosition)
 {
     // #1 From an empty vector.
@@ -450,8 +579,8 @@ TEST(IntVector, InsertSingleValueAtPosition)
     // Insert at the end
     vec.insert( vec.end(), 7 );
     ASSERT_EQ( vec , ( sc::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7 } ) );
-} */
-/*
+}
+
 TEST(IntVector, InsertRange)
 {
     // Aux arrays.
@@ -478,8 +607,8 @@ TEST(IntVector, InsertRange)
     vec1.insert( std::next( vec1.end(), 2 ) , source.begin(), source.end() );
     ASSERT_EQ( vec1 , ( sc::vector<int>{ 1, 2, 3, 4, 5 } ) );
 
-} */
-/*
+}
+
 TEST(IntVector, InsertInitializarList)
 {
     // Aux arrays.
@@ -505,7 +634,58 @@ TEST(IntVector, InsertInitializarList)
     vec1 = vec2;
     vec1.insert( std::next( vec1.end(), 2 ) , { 6, 7, 8, 9, 10 } );
     ASSERT_EQ( vec1 , ( sc::vector<int>{ 1, 2, 3, 4, 5 } ) );
-} */
+}
+
+TEST(IntVector, AppendRange)
+{
+    sc::vector<int> vec { 1, 2, 3 };
+    sc::vector<int> source { 4, 5, 6, 7 };
+
+    vec.reserve( 4 );
+    vec.append_range( source );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 1, 2, 3, 4, 5, 6, 7 } ) );
+    // A single reallocation, sized by the growth policy.
+    EXPECT_EQ( vec.capacity(), 8 );
+
+    std::istringstream input( "8 9 10" );
+    vec.append_range( std::vector<int>( std::istream_iterator<int>( input ), std::istream_iterator<int>() ) );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 } ) );
+
+    // Input iterators can only be read once.
+    std::istringstream input2( "-1 0" );
+    vec.insert( vec.begin(), std::istream_iterator<int>( input2 ), std::istream_iterator<int>() );
+    ASSERT_EQ( vec , ( sc::vector<int>{ -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 } ) );
+}
+
+TEST(IntVector, AssignInputIterator)
+{
+    sc::vector<int> vec { 1, 2 };
+
+    // The range can only be read once, so it can't be counted first.
+    std::istringstream input( "3 4 5 6 7" );
+    vec.assign( std::istream_iterator<int>( input ), std::istream_iterator<int>() );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 3, 4, 5, 6, 7 } ) );
+
+    std::istringstream input2( "8" );
+    vec.assign( std::istream_iterator<int>( input2 ), std::istream_iterator<int>() );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 8 } ) );
+
+    const std::vector<int> source { 9, 10, 11 };
+    vec.assign( source.begin(), source.end() );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 9, 10, 11 } ) );
+}
+
+TEST(IntVector, InsertOwnElement)
+{
+    sc::vector<int> vec { 1, 2, 3 };
+    ASSERT_EQ( vec.capacity(), 3 );
+
+    // The storage is full: the element must be read before it is reallocated.
+    vec.push_back( vec[0] );
+    vec.insert( vec.begin(), vec[3] );
+    vec.push_front( vec.back() );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 1, 1, 1, 2, 3, 1 } ) );
+}
 
 TEST(IntVector, AssignCountValue2)
 {
@@ -533,7 +713,6 @@ TEST(IntVector, AssignCountValue2)
         ASSERT_EQ( vec.capacity() , 8 );
 } 
 
-/*
 TEST(IntVector, EraseRange)
 {
     // Initial vector.
@@ -564,7 +743,7 @@ TEST(IntVector, EraseRange)
     past_last = vec.erase( vec.begin(), vec.end() );
     ASSERT_EQ( vec.end() , past_last );
     ASSERT_TRUE( vec.empty() );
-} */
+}
 
 TEST(IntVector, ErasePos)
 {
@@ -593,6 +772,1798 @@ TEST(IntVector, ErasePos)
     ASSERT_EQ( vec.size() , 4 );
 }
 
+TEST(IntVector, EraseIf)
+{
+    sc::vector<int> vec { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    auto removed = sc::erase_if( vec, []( int x ){ return x % 3 == 0 or x == 1; } );
+    ASSERT_EQ( removed , 4 );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 2, 4, 5, 7, 8, 10 } ) );
+
+    // Nothing, then everything.
+    ASSERT_EQ( sc::erase_if( vec, []( int ){ return false; } ) , 0 );
+    ASSERT_EQ( vec.size() , 6 );
+    ASSERT_EQ( sc::erase_if( vec, []( int ){ return true; } ) , 6 );
+    ASSERT_TRUE( vec.empty() );
+}
+
+TEST(IntVector, EraseIndices)
+{
+    sc::vector<int> vec { 0, 1, 2, 3, 4, 5, 6, 7 };
+    auto removed = sc::erase_indices( vec, std::vector< std::size_t >{ 0, 3, 4, 4, 7, 20 } );
+    ASSERT_EQ( removed , 4 );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 1, 2, 5, 6 } ) );
+
+    const int indices[] = { 1, 2 };
+    sc::erase_indices( vec, indices, indices + 2 );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 1, 6 } ) );
+}
+
+TEST(IntVector, RandomAccessIterator)
+{
+    static_assert( std::is_same< std::iterator_traits< sc::vector<int>::Iterator >::iterator_category,
+                                 std::random_access_iterator_tag >::value, "sc::vector has random access iterators" );
+#if __cplusplus >= 202002L
+    static_assert( std::contiguous_iterator< sc::vector<int>::Iterator >, "sc::vector has contiguous iterators" );
+    static_assert( std::contiguous_iterator< sc::vector<int>::const_iterator >, "sc::vector has contiguous iterators" );
+#endif
+
+    sc::vector<int> vec { 5, 3, 1, 4, 2 };
+    std::sort( vec.begin(), vec.end() );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 1, 2, 3, 4, 5 } ) );
+
+    auto it = vec.begin();
+    EXPECT_EQ( vec.end() - it, 5 );
+    EXPECT_EQ( it[3], 4 );
+    it += 4;
+    EXPECT_EQ( *it, 5 );
+    it -= 2;
+    EXPECT_EQ( *it++, 3 );
+    EXPECT_EQ( *it--, 4 );
+    EXPECT_TRUE( vec.begin() < it and it <= it and vec.end() > it );
+
+    EXPECT_EQ( std::lower_bound( vec.begin(), vec.end(), 4 ) - vec.begin(), 3 );
+    EXPECT_EQ( std::distance( vec.begin(), vec.end() ), 5 );
+
+    *vec.begin() = 0;
+    EXPECT_EQ( vec[0], 0 );
+}
+
+TEST(IntVector, ConstIterators)
+{
+    const sc::vector<int> vec { 1, 2, 3 };
+    sc::vector<int>::const_iterator first = vec.begin();
+    EXPECT_EQ( vec.cend() - vec.cbegin(), 3 );
+    EXPECT_EQ( vec.end(), vec.cend() );
+    EXPECT_EQ( vec.data() + 1, &first[1] );
+
+    int sum = 0;
+    for ( const auto & e : vec )
+        sum += e;
+    EXPECT_EQ( sum, 6 );
+
+    // An Iterator converts to a const_iterator.
+    sc::vector<int> vec2 { 1, 2, 3 };
+    sc::vector<int>::const_iterator last = vec2.end();
+    EXPECT_EQ( last - vec2.cbegin(), 3 );
+    EXPECT_TRUE( vec2.begin() == vec2.cbegin() );
+
+    sc::vector<int> copy( vec.begin(), vec.end() );
+    EXPECT_EQ( copy, vec2 );
+}
+
+// ============================================================================
+// TESTING VECTOR AS A CONTAINER OF NON TRIVIAL OBJECTS
+// ============================================================================
+
+// Counts how many objects are alive and how many copies were made,
+// and has no default constructor.
+struct Tracked
+{
+    static int alive;
+    static int copies;
+    int value;
+
+    explicit Tracked( int v ) : value(v) { ++alive; }
+    Tracked( const Tracked & other ) : value(other.value) { ++alive; ++copies; }
+    Tracked( Tracked && other ) noexcept : value(other.value) { ++alive; }
+    Tracked & operator=( const Tracked & other ) { value = other.value; ++copies; return *this; }
+    Tracked & operator=( Tracked && other ) noexcept { value = other.value; return *this; }
+    ~Tracked() { --alive; }
+
+    bool operator==( const Tracked & rhs ) const { return value == rhs.value; }
+    bool operator!=( const Tracked & rhs ) const { return value != rhs.value; }
+};
+int Tracked::alive = 0;
+int Tracked::copies = 0;
+
+TEST(TrackedVector, ReserveDoesNotConstruct)
+{
+    Tracked::alive = 0;
+    {
+        sc::vector<Tracked> vec( 1000 );
+        EXPECT_EQ( Tracked::alive, 0 );
+
+        vec.reserve( 1 << 16 );
+        EXPECT_EQ( Tracked::alive, 0 );
+        EXPECT_EQ( vec.capacity(), 1u << 16 );
+    }
+    EXPECT_EQ( Tracked::alive, 0 );
+}
+
+TEST(TrackedVector, OnlyLiveElementsAreAlive)
+{
+    Tracked::alive = 0;
+    {
+        sc::vector<Tracked> vec( 4 );
+        for ( auto i{0} ; i < 4 ; ++i )
+            vec.push_back( Tracked( i ) );
+        ASSERT_EQ( Tracked::alive, 4 );
+
+        vec.reserve( 100 );
+        ASSERT_EQ( Tracked::alive, 4 );
+
+        vec.push_front( Tracked( -1 ) );
+        ASSERT_EQ( Tracked::alive, 5 );
+        EXPECT_EQ( vec.front().value, -1 );
+        EXPECT_EQ( vec.back().value, 3 );
+
+        vec.pop_back();
+        ASSERT_EQ( Tracked::alive, 4 );
+        vec.pop_front();
+        ASSERT_EQ( Tracked::alive, 3 );
+        vec.erase( vec.begin() );
+        ASSERT_EQ( Tracked::alive, 2 );
+        for ( auto i{0u} ; i < vec.size() ; ++i )
+            ASSERT_EQ( vec[i].value, static_cast<int>(i) + 1 );
+
+        vec.shrink_to_fit();
+        ASSERT_EQ( Tracked::alive, 2 );
+
+        vec.clear();
+        ASSERT_EQ( Tracked::alive, 0 );
+        EXPECT_EQ( vec.capacity(), 2u );
+    }
+    EXPECT_EQ( Tracked::alive, 0 );
+}
+
+TEST(TrackedVector, CopyAndAssign)
+{
+    Tracked::alive = 0;
+    {
+        sc::vector<Tracked> vec( 8 );
+        vec.assign( 3, Tracked( 7 ) );
+        ASSERT_EQ( Tracked::alive, 3 );
+
+        sc::vector<Tracked> vec2( vec );
+        ASSERT_EQ( Tracked::alive, 6 );
+        ASSERT_EQ( vec, vec2 );
+
+        vec2.assign( 10, Tracked( 1 ) );
+        ASSERT_EQ( Tracked::alive, 13 );
+
+        vec2 = vec;
+        ASSERT_EQ( Tracked::alive, 6 );
+        ASSERT_EQ( vec, vec2 );
+    }
+    EXPECT_EQ( Tracked::alive, 0 );
+}
+
+TEST(TrackedVector, GrowthMovesElements)
+{
+    Tracked::alive = 0;
+    {
+        sc::vector<Tracked> vec( 4 );
+        for ( auto i{0} ; i < 4 ; ++i )
+            vec.push_back( Tracked( i ) );
+
+        Tracked::copies = 0;
+        vec.reserve( 64 );
+        vec.push_front( Tracked( -1 ) ); // one copy, for the new element
+        vec.insert( vec.begin(), Tracked( -2 ) ); // moved in, no copy
+        vec.erase( vec.begin() );
+        vec.pop_front();
+        vec.shrink_to_fit();
+        EXPECT_EQ( Tracked::copies, 1 );
+        ASSERT_EQ( Tracked::alive, 4 );
+
+        sc::vector<Tracked> vec2( std::move( vec ) );
+        vec = std::move( vec2 );
+        EXPECT_EQ( Tracked::copies, 1 );
+        ASSERT_EQ( Tracked::alive, 4 );
+        for ( auto i{0u} ; i < vec.size() ; ++i )
+            ASSERT_EQ( vec[i].value, static_cast<int>(i) );
+    }
+    EXPECT_EQ( Tracked::alive, 0 );
+}
+
+TEST(TrackedVector, EmplaceConstructsInPlace)
+{
+    Tracked::alive = 0;
+    {
+        sc::vector<Tracked> vec;
+        Tracked::copies = 0;
+
+        auto & last = vec.emplace_back( 3 );
+        EXPECT_EQ( last.value, 3 );
+        vec.emplace_back( 4 );
+        vec.emplace( vec.begin(), 1 );
+        vec.emplace( std::next( vec.begin(), 1 ), 2 );
+        vec.push_back( Tracked( 5 ) );
+        vec.insert( vec.end(), Tracked( 6 ) );
+        EXPECT_EQ( Tracked::copies, 0 );
+
+        ASSERT_EQ( vec.size(), 6 );
+        for ( auto i{0u} ; i < vec.size() ; ++i )
+            ASSERT_EQ( vec[i].value, static_cast<int>(i) + 1 );
+        ASSERT_EQ( Tracked::alive, 6 );
+    }
+    EXPECT_EQ( Tracked::alive, 0 );
+}
+
+TEST(TrackedVector, InsertRangeInPlace)
+{
+    Tracked::alive = 0;
+    {
+        sc::vector<Tracked> source;
+        for ( auto i{0} ; i < 3 ; ++i )
+            source.emplace_back( 10 + i );
+
+        // Gap larger than the elements after it, and smaller than them.
+        for ( auto position : { 1u, 4u } )
+        {
+            sc::vector<Tracked> vec( 16 );
+            for ( auto i{0} ; i < 5 ; ++i )
+                vec.emplace_back( i );
+
+            vec.insert( std::next( vec.begin(), position ), source.begin(), source.end() );
+            ASSERT_EQ( vec.size(), 8 );
+            ASSERT_EQ( vec.capacity(), 16 );
+            ASSERT_EQ( Tracked::alive, 3 + 8 );
+
+            for ( auto i{0u} ; i < vec.size() ; ++i )
+            {
+                int expected = i < position ? i : ( i < position + 3 ? 10 + i - position : i - 3 );
+                ASSERT_EQ( vec[i].value, expected );
+            }
+        }
+        ASSERT_EQ( Tracked::alive, 3 );
+    }
+    EXPECT_EQ( Tracked::alive, 0 );
+}
+
+TEST(StringVector, EraseIfAndIndices)
+{
+    sc::vector< std::string > vec { "keep", "drop", "keep too", "drop", "drop", "last" };
+    ASSERT_EQ( sc::erase_if( vec, []( const std::string & s ){ return s == "drop"; } ) , 3 );
+    ASSERT_EQ( vec , ( sc::vector< std::string >{ "keep", "keep too", "last" } ) );
+
+    ASSERT_EQ( sc::erase_indices( vec, std::vector< int >{ 1 } ) , 1 );
+    ASSERT_EQ( vec , ( sc::vector< std::string >{ "keep", "last" } ) );
+
+    vec.erase( vec.begin(), vec.begin() + 1 );
+    ASSERT_EQ( vec , ( sc::vector< std::string >{ "last" } ) );
+}
+
+TEST(StringVector, EmplaceAndAppend)
+{
+    sc::vector<std::string> vec;
+    vec.emplace_back( 3, 'a' );
+    vec.push_back( "bb" );
+    vec.emplace( vec.begin(), "c" );
+    vec.append_range( std::vector<std::string>{ "d", "e" } );
+
+    ASSERT_EQ( vec , ( sc::vector<std::string>{ "c", "aaa", "bb", "d", "e" } ) );
+}
+
+// ============================================================================
+// TESTING VECTOR WITH CUSTOM ALLOCATORS
+// ============================================================================
+
+// Bookkeeping shared by every copy of an ArenaAllocator.
+struct Arena
+{
+    int id;
+    long allocations = 0;
+    long live_bytes = 0;
+
+    explicit Arena( int i ) : id(i) { }
+};
+
+// Stateful allocator; Propagate selects the propagate_on_container_* traits.
+template < typename T, bool Propagate >
+struct ArenaAllocator
+{
+    typedef T value_type;
+    typedef std::integral_constant< bool, Propagate > propagate_on_container_copy_assignment;
+    typedef std::integral_constant< bool, Propagate > propagate_on_container_move_assignment;
+    typedef std::integral_constant< bool, Propagate > propagate_on_container_swap;
+    typedef std::false_type is_always_equal;
+
+    Arena * arena;
+
+    explicit ArenaAllocator( Arena * a ) : arena(a) { }
+    template < typename U >
+    ArenaAllocator( const ArenaAllocator< U, Propagate > & other ) : arena(other.arena) { }
+
+    T * allocate( std::size_t n )
+    {
+        arena->allocations++;
+        arena->live_bytes += n * sizeof(T);
+        return std::allocator<T>().allocate( n );
+    }
+    void deallocate( T * p, std::size_t n )
+    {
+        arena->live_bytes -= n * sizeof(T);
+        std::allocator<T>().deallocate( p, n );
+    }
+
+    bool operator==( const ArenaAllocator & rhs ) const { return arena == rhs.arena; }
+    bool operator!=( const ArenaAllocator & rhs ) const { return arena != rhs.arena; }
+};
+
+template < bool Propagate >
+using ArenaVector = sc::vector< int, ArenaAllocator< int, Propagate > >;
+
+TEST(AllocatorVector, StorageComesFromAllocator)
+{
+    Arena arena( 1 );
+    {
+        ArenaVector<false> vec( 4, ArenaAllocator< int, false >( &arena ) );
+        for ( auto i{0} ; i < 100 ; ++i )
+            vec.push_back( i );
+        EXPECT_GT( arena.allocations, 1 );
+        EXPECT_EQ( arena.live_bytes, static_cast<long>( vec.capacity() * sizeof(int) ) );
+
+        vec.shrink_to_fit();
+        EXPECT_EQ( arena.live_bytes, static_cast<long>( 100 * sizeof(int) ) );
+    }
+    EXPECT_EQ( arena.live_bytes, 0 );
+}
+
+TEST(AllocatorVector, CopyAssignPropagation)
+{
+    Arena arena1( 1 ), arena2( 2 );
+    {
+        ArenaAllocator< int, true > alloc1( &arena1 ), alloc2( &arena2 );
+        ArenaVector<true> vec( { 1, 2, 3 }, alloc1 );
+        ArenaVector<true> vec2( alloc2 );
+        vec2 = vec;
+        EXPECT_EQ( vec2.get_allocator().arena, &arena1 );
+        EXPECT_EQ( vec2 , vec );
+
+        ArenaAllocator< int, false > alloc3( &arena1 ), alloc4( &arena2 );
+        ArenaVector<false> vec3( { 1, 2, 3 }, alloc3 );
+        ArenaVector<false> vec4( alloc4 );
+        vec4 = vec3;
+        EXPECT_EQ( vec4.get_allocator().arena, &arena2 );
+        EXPECT_EQ( vec4 , vec3 );
+    }
+    EXPECT_EQ( arena1.live_bytes, 0 );
+    EXPECT_EQ( arena2.live_bytes, 0 );
+}
+
+TEST(AllocatorVector, MoveAssignWithDifferentAllocators)
+{
+    Arena arena1( 1 ), arena2( 2 );
+    {
+        ArenaAllocator< int, false > alloc1( &arena1 ), alloc2( &arena2 );
+        ArenaVector<false> vec( { 1, 2, 3 }, alloc1 );
+        ArenaVector<false> vec2( alloc2 );
+        auto storage = vec.data();
+
+        // The allocators differ and don't propagate: elements are moved, not the storage.
+        vec2 = std::move( vec );
+        EXPECT_NE( vec2.data(), storage );
+        EXPECT_EQ( vec2.get_allocator().arena, &arena2 );
+        EXPECT_EQ( vec2 , ArenaVector<false>( { 1, 2, 3 }, alloc1 ) );
+        EXPECT_TRUE( vec.empty() );
+
+        // Same allocator: the storage is taken over.
+        ArenaVector<false> vec3( alloc2 );
+        storage = vec2.data();
+        vec3 = std::move( vec2 );
+        EXPECT_EQ( vec3.data(), storage );
+    }
+    EXPECT_EQ( arena1.live_bytes, 0 );
+    EXPECT_EQ( arena2.live_bytes, 0 );
+}
+
+#ifdef SC_HAS_PMR
+TEST(AllocatorVector, PmrMonotonicBuffer)
+{
+    alignas( std::max_align_t ) char buffer[4096];
+    std::pmr::monotonic_buffer_resource arena( buffer, sizeof(buffer), std::pmr::null_memory_resource() );
+
+    sc::pmr::vector<int> vec( &arena );
+    vec.reserve( 256 );
+    for ( auto i{0} ; i < 256 ; ++i )
+        vec.push_back( i );
+
+    auto first = reinterpret_cast< char * >( vec.data() );
+    EXPECT_GE( first, buffer );
+    EXPECT_LE( first + vec.size() * sizeof(int), buffer + sizeof(buffer) );
+    for ( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i], static_cast<int>(i) );
+}
+#endif
+
+// ============================================================================
+// TESTING VECTOR GROWTH POLICIES
+// ============================================================================
+
+template < typename Growth >
+std::vector< std::size_t > capacities_after_push_back( std::size_t count )
+{
+    sc::vector< int, std::allocator<int>, Growth > vec;
+    std::vector< std::size_t > capacities;
+
+    for ( auto i{0u} ; i < count ; ++i )
+    {
+        vec.push_back( static_cast<int>(i) );
+        if ( capacities.empty() or capacities.back() != vec.capacity() )
+            capacities.push_back( vec.capacity() );
+    }
+    for ( auto i{0u} ; i < count ; ++i )
+        EXPECT_EQ( vec[i], static_cast<int>(i) );
+
+    return capacities;
+}
+
+TEST(GrowthVector, GrowsFromZeroCapacity)
+{
+    sc::vector<int> vec;
+    ASSERT_EQ( vec.capacity(), 0 );
+
+    vec.push_back( 1 );
+    EXPECT_EQ( vec.capacity(), 1 );
+
+    sc::vector<int> vec2;
+    vec2.push_front( 1 );
+    vec2.insert( vec2.begin(), 0 );
+    EXPECT_EQ( vec2 , ( sc::vector<int>{ 0, 1 } ) );
+}
+
+TEST(GrowthVector, Doubling)
+{
+    EXPECT_EQ( capacities_after_push_back< sc::doubling_growth >( 9 ),
+               ( std::vector< std::size_t >{ 1, 2, 4, 8, 16 } ) );
+}
+
+TEST(GrowthVector, Golden)
+{
+    EXPECT_EQ( capacities_after_push_back< sc::golden_growth >( 10 ),
+               ( std::vector< std::size_t >{ 1, 2, 4, 7, 11 } ) );
+}
+
+TEST(GrowthVector, FixedIncrement)
+{
+    EXPECT_EQ( capacities_after_push_back< sc::fixed_growth<4> >( 10 ),
+               ( std::vector< std::size_t >{ 4, 8, 12 } ) );
+}
+
+TEST(GrowthVector, PageRounded)
+{
+    auto capacities = capacities_after_push_back< sc::page_growth<4096> >( 5000 );
+    for ( auto capacity : capacities )
+    {
+        // Storage larger than a page always ends at a page boundary.
+        if ( capacity * sizeof(int) > 4096 )
+        {
+            EXPECT_EQ( capacity * sizeof(int) % 4096, 0u );
+        }
+    }
+    EXPECT_EQ( capacities.back(), 8192u );
+}
+
+TEST(GrowthVector, ReserveSameCapacityKeepsStorage)
+{
+    sc::vector<int> vec{ 1, 2, 3 };
+    auto storage = vec.data();
+
+    vec.reserve( vec.capacity() );
+    EXPECT_EQ( vec.data(), storage );
+}
+
+// ============================================================================
+// TESTING SMALL VECTOR
+// ============================================================================
+
+TEST(SmallVector, StaysInlineUpToN)
+{
+    Arena arena( 1 );
+    ArenaAllocator< int, false > alloc( &arena );
+    sc::small_vector< int, 4, ArenaAllocator< int, false > > vec( alloc );
+
+    EXPECT_EQ( vec.capacity(), 4 );
+    for ( auto i{0} ; i < 4 ; ++i )
+        vec.push_back( i );
+    EXPECT_TRUE( vec.is_inline() );
+    EXPECT_EQ( arena.allocations, 0 );
+
+    // Spills to the heap past N.
+    vec.push_back( 4 );
+    EXPECT_FALSE( vec.is_inline() );
+    EXPECT_EQ( arena.allocations, 1 );
+    EXPECT_EQ( vec.capacity(), 8 );
+    for ( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i], static_cast<int>(i) );
+}
+
+TEST(SmallVector, ShrinkToFitGoesBackInline)
+{
+    sc::small_vector< int, 4 > vec{ 1, 2, 3, 4, 5, 6 };
+    ASSERT_FALSE( vec.is_inline() );
+
+    vec.pop_back();
+    vec.shrink_to_fit();
+    EXPECT_FALSE( vec.is_inline() );
+    EXPECT_EQ( vec.capacity(), 5 );
+
+    vec.pop_back();
+    vec.pop_front();
+    vec.shrink_to_fit();
+    EXPECT_TRUE( vec.is_inline() );
+    EXPECT_EQ( vec.capacity(), 4 );
+    EXPECT_EQ( vec , ( sc::small_vector< int, 4 >{ 2, 3, 4 } ) );
+}
+
+TEST(SmallVector, CopyAndMove)
+{
+    Tracked::alive = 0;
+    {
+        sc::small_vector< Tracked, 2 > small;
+        small.emplace_back( 1 );
+        sc::small_vector< Tracked, 2 > big;
+        for ( auto i{0} ; i < 5 ; ++i )
+            big.emplace_back( i );
+
+        auto copy( big );
+        EXPECT_EQ( copy, big );
+
+        // A heap block is taken over, inline elements are moved.
+        auto storage = big.data();
+        auto moved( std::move( big ) );
+        EXPECT_EQ( moved.data(), storage );
+        EXPECT_TRUE( big.empty() );
+        EXPECT_TRUE( big.is_inline() );
+
+        auto moved_small( std::move( small ) );
+        EXPECT_TRUE( moved_small.is_inline() );
+        EXPECT_EQ( moved_small.front().value, 1 );
+
+        swap( moved, moved_small );
+        EXPECT_EQ( moved.size(), 1 );
+        EXPECT_EQ( moved_small, copy );
+        EXPECT_EQ( Tracked::alive, 1 + 5 + 5 );
+    }
+    EXPECT_EQ( Tracked::alive, 0 );
+}
+
+TEST(SmallVector, Modifiers)
+{
+    sc::small_vector< int, 8 > vec{ 1, 2, 5 };
+    vec.insert( std::next( vec.begin(), 2 ), { 3, 4 } );
+    vec.push_front( 0 );
+    vec.emplace( vec.end(), 6 );
+    ASSERT_EQ( vec , ( sc::small_vector< int, 8 >{ 0, 1, 2, 3, 4, 5, 6 } ) );
+
+    vec.erase( vec.begin() );
+    vec.erase( std::next( vec.begin(), 1 ), std::next( vec.begin(), 3 ) );
+    ASSERT_EQ( vec , ( sc::small_vector< int, 8 >{ 1, 4, 5, 6 } ) );
+
+    vec.assign( 10, 7 );
+    EXPECT_EQ( vec.size(), 10 );
+    EXPECT_FALSE( vec.is_inline() );
+    EXPECT_EQ( vec.back(), 7 );
+}
+
+TEST(StaticVector, FillsUpToN)
+{
+    sc::static_vector< int, 4 > vec{ 1, 2, 3 };
+    EXPECT_EQ( vec.capacity(), 4 );
+    EXPECT_TRUE( vec.try_push_back( 4 ) );
+    EXPECT_TRUE( vec.full() );
+
+    // A full vector rejects try_push_back and throws on push_back.
+    EXPECT_FALSE( vec.try_push_back( 5 ) );
+    EXPECT_THROW( vec.push_back( 5 ), std::length_error );
+    EXPECT_THROW( vec.insert( vec.begin(), 0 ), std::length_error );
+    EXPECT_THROW( ( sc::static_vector< int, 2 >{ 1, 2, 3 } ), std::length_error );
+    ASSERT_EQ( vec , ( sc::static_vector< int, 4 >{ 1, 2, 3, 4 } ) );
+}
+
+TEST(StaticVector, Modifiers)
+{
+    sc::static_vector< std::string, 8 > vec{ "b", "e" };
+    vec.insert( std::next( vec.begin(), 1 ), { "c", "d" } );
+    vec.push_front( "a" );
+    vec.emplace_back( 2, 'f' );
+    ASSERT_EQ( vec , ( sc::static_vector< std::string, 8 >{ "a", "b", "c", "d", "e", "ff" } ) );
+
+    vec.erase( vec.begin() );
+    vec.erase( std::next( vec.begin(), 1 ), std::next( vec.begin(), 3 ) );
+    ASSERT_EQ( vec , ( sc::static_vector< std::string, 8 >{ "b", "e", "ff" } ) );
+
+    sc::static_vector< std::string, 8 > vec2( std::move( vec ) );
+    vec.assign( 3, "x" );
+    vec.swap( vec2 );
+    EXPECT_EQ( vec , ( sc::static_vector< std::string, 8 >{ "b", "e", "ff" } ) );
+    EXPECT_EQ( vec2 , ( sc::static_vector< std::string, 8 >{ "x", "x", "x" } ) );
+}
+
+TEST(StaticVector, OnlyLiveElementsAreAlive)
+{
+    Tracked::alive = 0;
+    {
+        sc::static_vector< Tracked, 16 > vec;
+        EXPECT_EQ( Tracked::alive, 0 );
+        vec.emplace_back( 1 );
+        vec.emplace_back( 2 );
+        vec.pop_back();
+        EXPECT_EQ( Tracked::alive, 1 );
+    }
+    EXPECT_EQ( Tracked::alive, 0 );
+}
+
+TEST(RingVector, WorkQueue)
+{
+    sc::ring_vector< int > queue;
+    int next_in = 0, next_out = 0;
+
+    // Keeps around 5 elements alive while pushing 100, so the head wraps many times.
+    for( ; next_in < 100 ; ++next_in )
+    {
+        queue.push_back( next_in );
+        if( queue.size() > 5 )
+        {
+            EXPECT_EQ( queue.front(), next_out++ );
+            queue.pop_front();
+        }
+    }
+    EXPECT_EQ( queue.capacity(), 8 );
+    for( auto i{0u} ; i < queue.size() ; ++i )
+        EXPECT_EQ( queue[i], next_out + static_cast<int>(i) );
+}
+
+TEST(RingVector, BothEnds)
+{
+    sc::ring_vector< std::string > vec{ "c", "d" };
+    vec.push_front( "b" );
+    vec.emplace_front( 1, 'a' );
+    vec.push_back( "e" );
+    EXPECT_EQ( vec.size(), 5 );
+    EXPECT_TRUE( std::equal( vec.begin(), vec.end(), std::vector< std::string >{ "a", "b", "c", "d", "e" }.begin() ) );
+    EXPECT_EQ( vec.end() - vec.begin(), 5 );
+    EXPECT_EQ( vec.begin()[2], "c" );
+
+    vec.pop_front();
+    vec.pop_back();
+    ASSERT_EQ( vec , ( sc::ring_vector< std::string >{ "b", "c", "d" } ) );
+    EXPECT_THROW( vec.at( 3 ), std::out_of_range );
+}
+
+TEST(RingVector, InsertOwnElement)
+{
+    sc::ring_vector< std::string > vec{ "a", "b", "c" };
+    ASSERT_EQ( vec.capacity(), vec.size() );
+
+    // The storage is full: the element must be read before the ring is reallocated.
+    vec.push_back( vec.front() );
+    vec.shrink_to_fit();
+    vec.push_front( vec.back() );
+    vec.shrink_to_fit();
+    vec.emplace_back( vec[1] );
+    ASSERT_EQ( vec , ( sc::ring_vector< std::string >{ "a", "a", "b", "c", "a", "a" } ) );
+}
+
+TEST(RingVector, Linearize)
+{
+    sc::ring_vector< int > vec( 4 );
+    vec.push_back( 3 );
+    vec.push_back( 4 );
+    vec.push_front( 2 );
+    vec.push_front( 1 );
+    EXPECT_FALSE( vec.is_linear() );
+
+    const int * data = vec.data();
+    EXPECT_TRUE( vec.is_linear() );
+    EXPECT_EQ( vec.capacity(), 4 );
+    EXPECT_TRUE( std::equal( data, data + 4, std::vector< int >{ 1, 2, 3, 4 }.begin() ) );
+
+    sc::ring_vector< std::string > strings( 4 );
+    strings.push_back( "y" );
+    strings.push_front( "x" );
+    EXPECT_EQ( std::string( strings.linearize()[0] ) + strings.linearize()[1], "xy" );
+}
+
+TEST(RingVector, OnlyLiveElementsAreAlive)
+{
+    Tracked::alive = 0;
+    {
+        sc::ring_vector< Tracked > vec( 4 );
+        vec.emplace_back( 1 );
+        vec.emplace_front( 0 );
+        vec.emplace_front( -1 );
+        EXPECT_EQ( Tracked::alive, 3 );
+        vec.emplace_back( 2 );
+        vec.emplace_back( 3 ); // Grows while wrapped.
+        EXPECT_EQ( Tracked::alive, 5 );
+        EXPECT_EQ( vec.front().value, -1 );
+        EXPECT_EQ( vec.back().value, 3 );
+
+        sc::ring_vector< Tracked > copy( vec );
+        EXPECT_EQ( Tracked::alive, 10 );
+        copy.pop_front();
+        copy.clear();
+        EXPECT_EQ( Tracked::alive, 5 );
+    }
+    EXPECT_EQ( Tracked::alive, 0 );
+}
+
+TEST(GapVector, EditsAtCursor)
+{
+    sc::gap_vector< char > text;
+    for ( char c : std::string( "hello world" ) )
+        text.push_back( c );
+
+    // Types at a cursor in the middle: after the first insert the gap sits there, nothing else moves.
+    auto cursor = text.begin() + 5;
+    for ( char c : std::string( ", dear" ) )
+        cursor = text.insert( cursor, c ) + 1;
+    EXPECT_EQ( text.gap_position(), 11 );
+    EXPECT_EQ( std::string( text.begin(), text.end() ), "hello, dear world" );
+
+    // Backspaces at the cursor.
+    text.erase( text.begin() + 6, text.begin() + 11 );
+    text.erase( text.begin() + 5 );
+    EXPECT_EQ( text.gap_position(), 5 );
+    EXPECT_EQ( text[4], 'o' );
+    EXPECT_EQ( text[5], ' ' );
+
+    EXPECT_FALSE( text.is_compact() );
+    const char * data = text.compact();
+    EXPECT_TRUE( text.is_compact() );
+    EXPECT_EQ( std::string( data, data + text.size() ), "hello world" );
+}
+
+TEST(GapVector, Modifiers)
+{
+    sc::gap_vector< std::string > vec{ "b", "e" };
+    vec.insert( vec.begin() + 1, { "c", "d" } );
+    vec.push_front( "a" );
+    vec.emplace_back( 2, 'f' );
+    ASSERT_EQ( vec , ( sc::gap_vector< std::string >{ "a", "b", "c", "d", "e", "ff" } ) );
+
+    vec.pop_front();
+    vec.pop_back();
+    vec.erase( vec.begin() + 1, vec.begin() + 3 );
+    ASSERT_EQ( vec , ( sc::gap_vector< std::string >{ "b", "e" } ) );
+    EXPECT_EQ( vec.front(), "b" );
+    EXPECT_EQ( vec.back(), "e" );
+    EXPECT_THROW( vec.at( 2 ), std::out_of_range );
+
+    sc::gap_vector< std::string > copy( vec );
+    vec.insert( vec.begin() + 1, vec.front() ); // Inserts its own element.
+    EXPECT_EQ( vec , ( sc::gap_vector< std::string >{ "b", "b", "e" } ) );
+    EXPECT_EQ( copy , ( sc::gap_vector< std::string >{ "b", "e" } ) );
+}
+
+TEST(GapVector, OnlyLiveElementsAreAlive)
+{
+    Tracked::alive = 0;
+    {
+        sc::gap_vector< Tracked > vec( 4 );
+        for ( int i = 0 ; i < 10 ; ++i )
+            vec.emplace( vec.begin() + i / 2, i );
+        EXPECT_EQ( Tracked::alive, 10 );
+
+        // Moves the gap back and forth across the elements.
+        vec.erase( vec.begin() + 1 );
+        vec.erase( vec.begin() + 8 );
+        vec.emplace( vec.begin(), -1 );
+        EXPECT_EQ( Tracked::alive, 9 );
+
+        std::vector< int > values;
+        for ( const auto & t : vec )
+            values.push_back( t.value );
+        EXPECT_EQ( values, ( std::vector< int >{ -1, 1, 5, 7, 9, 8, 6, 4, 2 } ) );
+
+        vec.compact();
+        vec.shrink_to_fit();
+        EXPECT_EQ( vec.capacity(), 9 );
+        EXPECT_EQ( Tracked::alive, 9 );
+    }
+    EXPECT_EQ( Tracked::alive, 0 );
+}
+
+// A fresh path for the file of an mmap_vector, removed by the destructor.
+struct TempFile
+{
+    std::string path;
+
+    TempFile( void )
+    {
+        char name[] = "/tmp/sc_mmap_vector_XXXXXX";
+        int fd = ::mkstemp( name );
+        ::close( fd );
+        path = name;
+    }
+
+    ~TempFile( ){ std::remove( path.c_str() ); }
+};
+
+TEST(MmapVector, PersistsAcrossOpens)
+{
+    TempFile file;
+    {
+        sc::mmap_vector< int > vec( file.path );
+        ASSERT_TRUE( vec.empty() );
+        for ( int i = 0 ; i < 10000 ; ++i )
+            vec.push_back( i );
+        vec.sync();
+        EXPECT_EQ( vec.size(), 10000 );
+        EXPECT_GE( vec.capacity(), 10000 );
+    }
+    {
+        sc::mmap_vector< int > vec( file.path );
+        ASSERT_EQ( vec.size(), 10000 );
+        for ( int i = 0 ; i < 10000 ; ++i )
+            ASSERT_EQ( vec[i], i );
+
+        vec.pop_back();
+        vec.shrink_to_fit();
+        EXPECT_EQ( vec.capacity(), 9999 );
+    }
+
+    sc::mmap_vector< int > vec( file.path, sc::mmap_vector< int >::read_only );
+    EXPECT_TRUE( vec.is_read_only() );
+    EXPECT_EQ( vec.size(), 9999 );
+    EXPECT_EQ( vec.back(), 9998 );
+    EXPECT_TRUE( std::is_sorted( vec.begin(), vec.end() ) );
+}
+
+TEST(MmapVector, Modifiers)
+{
+    TempFile file;
+    sc::mmap_vector< int > vec( file.path );
+
+    vec.insert( vec.begin(), { 1, 2, 3, 4, 5 } );
+    vec.insert( vec.begin() + 2, 10 );
+    EXPECT_EQ( std::vector< int >( vec.begin(), vec.end() ), ( std::vector< int >{ 1, 2, 10, 3, 4, 5 } ) );
+
+    // Inserting part of itself, past the capacity so the mapping may move.
+    vec.insert( vec.end(), vec.begin(), vec.end() );
+    EXPECT_EQ( vec.size(), 12 );
+    EXPECT_EQ( vec.count( 10 ), 2 );
+
+    vec.erase( vec.begin() + 1, vec.begin() + 9 );
+    EXPECT_EQ( std::vector< int >( vec.begin(), vec.end() ), ( std::vector< int >{ 1, 3, 4, 5 } ) );
+
+    // Within the capacity: the parts of the range in the shifted tail are read from their new place.
+    vec.reserve( 100 );
+    vec.insert( vec.begin() + 1, vec.begin(), vec.begin() + 3 );
+    EXPECT_EQ( std::vector< int >( vec.begin(), vec.end() ), ( std::vector< int >{ 1, 1, 3, 4, 3, 4, 5 } ) );
+    vec.insert( vec.begin(), vec.back() );
+    vec.erase( vec.begin() + 1, vec.begin() + 4 );
+    EXPECT_EQ( std::vector< int >( vec.begin(), vec.end() ), ( std::vector< int >{ 5, 4, 3, 4, 5 } ) );
+    vec.clear();
+    vec.insert( vec.begin(), { 1, 3, 4, 5 } );
+    EXPECT_EQ( *vec.find( 4 ), 4 );
+    EXPECT_FALSE( vec.contains( 10 ) );
+    EXPECT_THROW( vec.at( 4 ), std::out_of_range );
+
+    // The same element access as sc::vector, so the data can be copied out with the iterators.
+    sc::vector< int > copy( vec.cbegin(), vec.cend() );
+    EXPECT_EQ( copy.size(), 4 );
+    EXPECT_EQ( copy[3], 5 );
+
+    sc::mmap_vector< int > moved( std::move( vec ) );
+    EXPECT_EQ( moved.size(), 4 );
+    EXPECT_EQ( vec.size(), 0 );
+
+    moved.clear();
+    EXPECT_TRUE( moved.empty() );
+}
+
+TEST(MmapVector, PushOwnElement)
+{
+    TempFile file;
+    sc::mmap_vector< int > vec( file.path );
+    vec.push_back( 7 );
+
+    // Each push at full capacity remaps, possibly elsewhere, while the argument points into the old mapping.
+    for ( int i = 1 ; i < 2000 ; ++i )
+    {
+        vec.shrink_to_fit();
+        ASSERT_EQ( vec.capacity(), i );
+        vec.push_back( vec[ i - 1 ] );
+    }
+    EXPECT_EQ( vec.count( 7 ), 2000 );
+}
+
+TEST(MmapVector, OpenErrors)
+{
+    TempFile file;
+    {
+        sc::mmap_vector< int > vec( file.path );
+        vec.push_back( 42 );
+    }
+
+    // Read-only mode never changes the file.
+    {
+        sc::mmap_vector< int > vec( file.path, sc::mmap_vector< int >::read_only );
+        EXPECT_THROW( vec.push_back( 1 ), std::logic_error );
+        EXPECT_THROW( vec.reserve( 100 ), std::logic_error );
+        vec.data()[0] = 7;
+        EXPECT_EQ( vec.front(), 7 );
+    }
+    EXPECT_EQ( sc::mmap_vector< int >( file.path, sc::mmap_vector< int >::read_only ).front(), 42 );
+
+    EXPECT_THROW( sc::mmap_vector< double >( file.path ), std::runtime_error );
+    EXPECT_THROW( sc::mmap_vector< int >( file.path + ".missing", sc::mmap_vector< int >::read_only ), std::system_error );
+}
+
+TEST(MremapAllocator, GrowsInPlace)
+{
+    // Mappings from 4 KiB on, so the vector goes through malloc, realloc, the switch and mremap.
+    sc::vector< int, sc::mremap_allocator< int, 4096 > > vec;
+    for ( int i = 0 ; i < 100000 ; ++i )
+        vec.push_back( i );
+    ASSERT_EQ( vec.size(), 100000 );
+    for ( int i = 0 ; i < 100000 ; ++i )
+        ASSERT_EQ( vec[i], i );
+
+    // The appended element can refer to the storage that is being grown.
+    vec.shrink_to_fit();
+    EXPECT_EQ( vec.capacity(), 100000 );
+    vec.push_back( vec[0] );
+    EXPECT_EQ( vec.back(), 0 );
+
+    vec.erase( vec.begin() + 10, vec.end() );
+    vec.shrink_to_fit();
+    EXPECT_EQ( vec.capacity(), 10 );
+    EXPECT_EQ( vec.back(), 9 );
+
+    vec.reserve( 5000 );
+    EXPECT_EQ( vec.capacity(), 5000 );
+    EXPECT_EQ( vec, ( sc::vector< int, sc::mremap_allocator< int, 4096 > >{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 } ) );
+}
+
+TEST(MremapAllocator, NotTriviallyCopyable)
+{
+    // Strings can't be moved byte by byte, the vector allocates and relocates them as usual.
+    sc::vector< std::string, sc::huge_page_allocator< std::string > > vec;
+    for ( int i = 0 ; i < 1000 ; ++i )
+        vec.push_back( std::to_string( i ) );
+    vec.insert( vec.begin(), "first" );
+    vec.shrink_to_fit();
+
+    EXPECT_EQ( vec.size(), 1001 );
+    EXPECT_EQ( vec.front(), "first" );
+    EXPECT_EQ( vec.back(), "999" );
+}
+
+TEST(ConcurrentVector, ParallelPushBack)
+{
+    const int threads = 8, per_thread = 20000;
+    sc::concurrent_vector< int > vec;
+
+    std::vector< std::thread > workers;
+    for ( int t = 0 ; t < threads ; ++t )
+        workers.emplace_back( [&vec, t, per_thread]( ){
+            for ( int i = 0 ; i < per_thread ; ++i )
+                vec.push_back( t * per_thread + i );
+        } );
+    for ( auto & worker : workers )
+        worker.join();
+
+    ASSERT_EQ( vec.size(), threads * per_thread );
+    sc::vector< int > flat = vec.to_vector();
+    ASSERT_EQ( flat.size(), threads * per_thread );
+    std::sort( flat.begin(), flat.end() );
+    for ( int i = 0 ; i < threads * per_thread ; ++i )
+        ASSERT_EQ( flat[i], i );
+}
+
+TEST(ConcurrentVector, StableReferences)
+{
+    sc::concurrent_vector< std::string > vec;
+    const std::string & first = *vec.push_back( "first" );
+    auto it = vec.grow_by( 3, "x" );
+    EXPECT_EQ( it - vec.begin(), 1 );
+
+    for ( int i = 0 ; i < 100000 ; ++i )
+        vec.emplace_back( std::to_string( i ) );
+
+    EXPECT_EQ( &first, &vec[0] );
+    EXPECT_EQ( first, "first" );
+    EXPECT_EQ( vec[3], "x" );
+    EXPECT_EQ( vec[100003], "99999" );
+    EXPECT_THROW( vec.at( 100004 ), std::out_of_range );
+    EXPECT_EQ( std::count( vec.cbegin(), vec.cend(), "x" ), 3 );
+
+    vec.grow_by( 2 );
+    EXPECT_EQ( vec.size(), 100006 );
+    EXPECT_TRUE( vec[100005].empty() );
+}
+
+TEST(ConcurrentVector, OnlyLiveElementsAreAlive)
+{
+    Tracked::alive = 0;
+    {
+        sc::concurrent_vector< Tracked > vec;
+        vec.reserve( 1000 );
+        for ( int i = 0 ; i < 100 ; ++i )
+            vec.emplace_back( i );
+        vec.grow_by( 50, Tracked( -1 ) );
+        EXPECT_EQ( Tracked::alive, 150 );
+
+        vec.clear();
+        EXPECT_EQ( Tracked::alive, 0 );
+        vec.emplace_back( 7 );
+        EXPECT_EQ( vec[0].value, 7 );
+    }
+    EXPECT_EQ( Tracked::alive, 0 );
+}
+
+// Small chunks and no threshold, so even short vectors are split over the threads of the pool.
+static sc::thread_pool test_pool( 4 );
+static const sc::parallel_policy test_par = { 64, 0, &test_pool };
+
+TEST(Parallel, ConstructAssignCopy)
+{
+    sc::vector< int > filled( test_par, 100000, 7 );
+    ASSERT_EQ( filled.size(), 100000 );
+    EXPECT_EQ( filled.count( 7 ), 100000 );
+
+    sc::vector< int > copy( test_par, filled );
+    EXPECT_EQ( copy, filled );
+
+    copy.assign( test_par, 50000, copy[0] );
+    EXPECT_EQ( copy.size(), 50000 );
+    EXPECT_EQ( copy.count( 7 ), 50000 );
+    copy.assign( test_par, 200000, 3 );
+    EXPECT_EQ( copy.count( 3 ), 200000 );
+
+    copy.erase( copy.begin() + 1000, copy.end() );
+    copy.shrink_to_fit( test_par );
+    EXPECT_EQ( copy.capacity(), 1000 );
+    EXPECT_EQ( copy.count( 3 ), 1000 );
+
+    // Copying strings may throw, they are built on the calling thread.
+    sc::vector< std::string > strings( test_par, 1000, std::string( 100, 'x' ) );
+    sc::vector< std::string > strings_copy( sc::par, strings );
+    EXPECT_EQ( strings_copy, strings );
+    strings_copy.shrink_to_fit( sc::par );
+    EXPECT_EQ( strings_copy.capacity(), 1000 );
+}
+
+TEST(Parallel, Algorithms)
+{
+    sc::vector< int > vec( test_par, 100000, 1 );
+
+    sc::for_each( test_par, vec.begin(), vec.end(), []( int & x ){ x *= 2; } );
+    EXPECT_EQ( sc::reduce( test_par, vec.begin(), vec.end(), 0 ), 200000 );
+
+    std::iota( vec.begin(), vec.end(), 0 );
+    sc::vector< long long > squares( test_par, vec.size(), 0 );
+    sc::transform( test_par, vec.cbegin(), vec.cend(), squares.begin(), []( int x ){ return 1LL * x * x; } );
+    EXPECT_EQ( squares[99999], 99999LL * 99999 );
+    EXPECT_EQ( sc::reduce( test_par, squares.begin(), squares.end(), 0LL ), 99999LL * 100000 * 199999 / 6 );
+    EXPECT_EQ( sc::reduce( test_par, vec.begin(), vec.end(), 0, []( int a, int b ){ return std::max( a, b ); } ), 99999 );
+
+    sc::fill( test_par, vec.begin(), vec.end(), 5 );
+    sc::vector< int > out( vec.size() );
+    out.assign( vec.size(), 0 );
+    EXPECT_EQ( sc::copy( sc::par, vec.begin(), vec.end(), out.begin() ), out.end() );
+    EXPECT_EQ( out, vec );
+
+    EXPECT_THROW( sc::for_each( test_par, vec.begin(), vec.end(), []( int & ){ throw std::runtime_error( "chunk" ); } ), std::runtime_error );
+    EXPECT_EQ( sc::reduce( sc::par, vec.begin(), vec.begin(), 42 ), 42 );
+}
+
+TEST(SoaVector, RowsAndColumns)
+{
+    sc::soa_vector< int, double, std::string > table;
+    EXPECT_TRUE( table.empty() );
+
+    for ( int i = 0 ; i < 1000 ; ++i )
+        table.emplace_back( i, i * 0.5, std::to_string( i ) );
+    table.push_back( std::make_tuple( -1, -0.5, std::string( "last" ) ) );
+
+    ASSERT_EQ( table.size(), 1001 );
+    EXPECT_GE( table.capacity(), 1001 );
+    EXPECT_EQ( std::get< 2 >( table[10] ), "10" );
+    EXPECT_EQ( table.get< 1 >( 1000 ), -0.5 );
+    EXPECT_EQ( std::get< 0 >( table.back() ), -1 );
+    EXPECT_THROW( table.at( 1001 ), std::out_of_range );
+
+    // Rows are tuples of references.
+    std::get< 1 >( table[3] ) = 42.0;
+    EXPECT_EQ( table.get< 1 >( 3 ), 42.0 );
+    int key; std::string name;
+    std::tie( key, std::ignore, name ) = table[7];
+    EXPECT_EQ( key, 7 );
+    EXPECT_EQ( name, "7" );
+
+    // Each column is contiguous.
+    sc::span< int > keys = table.column< 0 >();
+    ASSERT_EQ( keys.size(), 1001 );
+    EXPECT_EQ( &keys[1], &keys[0] + 1 );
+    EXPECT_EQ( std::accumulate( keys.begin(), keys.end() - 1, 0 ), 999 * 1000 / 2 );
+    EXPECT_EQ( reinterpret_cast< std::uintptr_t >( table.column< 1 >().data() ) % alignof( double ), 0u );
+}
+
+TEST(SoaVector, Modifiers)
+{
+    sc::soa_vector< int, std::string > table;
+    for ( int i = 0 ; i < 10 ; ++i )
+        table.emplace_back( i, std::string( 20, char( 'a' + i ) ) );
+
+    // The row added can refer to the vector itself while it grows.
+    table.shrink_to_fit();
+    table.push_back( table[0] );
+    EXPECT_EQ( table.get< 1 >( 10 ), std::string( 20, 'a' ) );
+
+    auto next = table.erase( table.begin() + 2, table.begin() + 5 );
+    EXPECT_EQ( next - table.begin(), 2 );
+    EXPECT_EQ( std::get< 0 >( *next ), 5 );
+    table.erase( table.cbegin() );
+    table.pop_back();
+    ASSERT_EQ( table.size(), 6 );
+    EXPECT_EQ( std::vector< int >( table.column< 0 >().begin(), table.column< 0 >().end() ), ( std::vector< int >{ 1, 5, 6, 7, 8, 9 } ) );
+
+    sc::soa_vector< int, std::string > copy( table );
+    EXPECT_EQ( copy.get< 1 >( 5 ), std::string( 20, 'j' ) );
+    sc::soa_vector< int, std::string > moved( std::move( copy ) );
+    EXPECT_EQ( moved.size(), 6 );
+    EXPECT_TRUE( copy.empty() );
+    copy = moved;
+    EXPECT_EQ( copy.get< 0 >( 1 ), 5 );
+
+    int rows = 0;
+    for ( auto row : moved )
+        rows += std::get< 0 >( row ) > 0;
+    EXPECT_EQ( rows, 6 );
+
+    moved.clear();
+    EXPECT_TRUE( moved.empty() );
+}
+
+TEST(SoaVector, OnlyLiveElementsAreAlive)
+{
+    Tracked::alive = 0;
+    {
+        sc::soa_vector< Tracked, int, Tracked > table;
+        for ( int i = 0 ; i < 100 ; ++i )
+            table.emplace_back( Tracked( i ), i, Tracked( -i ) );
+        EXPECT_EQ( Tracked::alive, 200 );
+
+        table.erase( table.begin(), table.begin() + 50 );
+        table.pop_back();
+        EXPECT_EQ( Tracked::alive, 98 );
+        EXPECT_EQ( table.get< 0 >( 0 ).value, 50 );
+        EXPECT_EQ( table.get< 2 >( 48 ).value, -98 );
+    }
+    EXPECT_EQ( Tracked::alive, 0 );
+}
+
+TEST(PersistentVector, VersionsAreIndependent)
+{
+    // Enough elements for a tree of three levels (more than 32 * 32 + 32).
+    const int n = 40000;
+    std::vector< sc::persistent_vector< int > > versions( 1 );
+    for ( int i = 0 ; i < n ; ++i )
+        versions.push_back( versions.back().push_back( i ) );
+
+    for ( int size : { 0, 1, 32, 33, 1056, 1057, n } )
+    {
+        const auto & version = versions[size];
+        ASSERT_EQ( int( version.size() ), size );
+        for ( int i = 0 ; i < size ; ++i )
+            ASSERT_EQ( version[i], i );
+    }
+
+    auto full = versions.back();
+    auto edited = full.set( 0, -1 ).set( 20000, -2 ).set( n - 1, -3 );
+    EXPECT_EQ( full[0], 0 );
+    EXPECT_EQ( full[20000], 20000 );
+    EXPECT_EQ( full[n - 1], n - 1 );
+    EXPECT_EQ( edited[0], -1 );
+    EXPECT_EQ( edited[20000], -2 );
+    EXPECT_EQ( edited.back(), -3 );
+    EXPECT_NE( full, edited );
+
+    // Popping back down through every tail and root change gives the older versions again.
+    auto popped = full;
+    for ( int size = n ; size > 0 ; --size )
+    {
+        popped = popped.pop_back();
+        if ( size % 997 == 0 || size <= 33 || size == 1057 || size == 1025 )
+        {
+            ASSERT_EQ( popped, versions[size - 1] );
+        }
+    }
+    EXPECT_TRUE( popped.empty() );
+    EXPECT_THROW( popped.pop_back(), std::out_of_range );
+    EXPECT_THROW( full.at( n ), std::out_of_range );
+    EXPECT_THROW( full.set( n, 0 ), std::out_of_range );
+
+    int expected = 0;
+    for ( int value : full )
+        ASSERT_EQ( value, expected++ );
+    EXPECT_EQ( std::accumulate( full.begin() + 10, full.end() - 10, 0LL ), ( n - 11 ) * ( n - 10LL ) / 2 - 45 );
+}
+
+TEST(PersistentVector, TransientAndConversions)
+{
+    sc::vector< int > flat = { 1, 2, 3 };
+    sc::persistent_vector< int > base( flat );
+    EXPECT_EQ( base, sc::persistent_vector< int >( { 1, 2, 3 } ) );
+
+    sc::transient_vector< int > builder = base.transient();
+    for ( int i = 4 ; i <= 5000 ; ++i )
+        builder.push_back( i );
+    builder.set( 0, 100 );
+    builder.pop_back();
+    sc::persistent_vector< int > built = builder.persistent();
+
+    // The builder keeps going without touching the published version.
+    builder.set( 1, 200 );
+    builder.push_back( 7 );
+    EXPECT_EQ( built.size(), 4999u );
+    EXPECT_EQ( built[0], 100 );
+    EXPECT_EQ( built[1], 2 );
+    EXPECT_EQ( builder[1], 200 );
+    EXPECT_EQ( builder.size(), 5000u );
+    EXPECT_EQ( base.size(), 3u );
+    EXPECT_EQ( base[0], 1 );
+
+    sc::vector< int > back = built.to_vector();
+    ASSERT_EQ( back.size(), 4999u );
+    EXPECT_EQ( back[0], 100 );
+    EXPECT_EQ( back[4998], 4999 );
+    EXPECT_TRUE( std::equal( back.begin(), back.end(), built.begin() ) );
+}
+
+TEST(PersistentVector, BackwardIteration)
+{
+    const sc::persistent_vector< int > small { 1, 2, 3, 4, 5 };
+    EXPECT_EQ( *std::prev( small.end() ), 5 );
+    typedef std::reverse_iterator< sc::persistent_vector< int >::const_iterator > reverse;
+    EXPECT_EQ( std::vector< int >( reverse( small.end() ), reverse( small.begin() ) ), ( std::vector< int >{ 5, 4, 3, 2, 1 } ) );
+
+    // Sizes around the leaf width, with and without a full tail, and deep enough for a branch level.
+    for ( int n : { 31, 32, 33, 64, 100, 1057 } )
+    {
+        sc::transient_vector< int > builder;
+        for ( int i = 0 ; i < n ; ++i )
+            builder.push_back( i );
+        const sc::persistent_vector< int > vec = builder.persistent();
+
+        int expected = n;
+        for ( auto it = vec.end() ; it != vec.begin() ; )
+            ASSERT_EQ( *--it, --expected );
+        EXPECT_EQ( expected, 0 );
+    }
+}
+
+TEST(PersistentVector, ThreadsShareVersions)
+{
+    sc::persistent_vector< int > base( sc::vector< int >( { 0, 1, 2, 3 } ) );
+    for ( int i = 4 ; i < 3000 ; ++i )
+        base = base.push_back( i );
+
+    // Every thread derives its own versions from the shared one, which must stay untouched.
+    std::vector< std::thread > threads;
+    std::vector< long long > sums( 4 );
+    for ( int t = 0 ; t < 4 ; ++t )
+        threads.emplace_back( [&base, &sums, t]( )
+        {
+            sc::persistent_vector< int > mine = base;
+            for ( int i = 0 ; i < 1000 ; ++i )
+                mine = mine.set( ( i * 37 ) % 3000, -t ).push_back( t ).pop_back();
+            sums[t] = std::accumulate( mine.begin(), mine.end(), 0LL );
+        } );
+    for ( auto & thread : threads )
+        thread.join();
+
+    for ( int i = 0 ; i < 3000 ; ++i )
+        ASSERT_EQ( base[i], i );
+    // The 1000 indices ( i * 37 ) % 3000 are distinct; thread t wrote -t to each of them.
+    long long touched = 0;
+    for ( int i = 0 ; i < 1000 ; ++i )
+        touched += ( i * 37 ) % 3000;
+    for ( int t = 0 ; t < 4 ; ++t )
+        EXPECT_EQ( sums[t], 2999LL * 3000 / 2 - touched - 1000LL * t );
+}
+
+TEST(PersistentVector, OnlyLiveElementsAreAlive)
+{
+    Tracked::alive = 0;
+    {
+        sc::transient_vector< Tracked > builder;
+        for ( int i = 0 ; i < 2000 ; ++i )
+            builder.emplace_back( i );
+        auto first = builder.persistent();
+        EXPECT_EQ( Tracked::alive, 2000 );
+
+        // Editing a shared leaf copies those 32 elements once.
+        builder.set( 5, Tracked( -5 ) );
+        builder.set( 6, Tracked( -6 ) );
+        EXPECT_EQ( Tracked::alive, 2032 );
+
+        auto second = first.pop_back().push_back( Tracked( 1 ) );
+        EXPECT_EQ( second.back().value, 1 );
+        EXPECT_EQ( first.back().value, 1999 );
+    }
+    EXPECT_EQ( Tracked::alive, 0 );
+}
+
+TEST(CowVector, CopiesShareUntilModified)
+{
+    sc::cow_vector< Tracked > original;
+    for ( int i = 0 ; i < 10 ; ++i )
+        original.emplace_back( i );
+
+    Tracked::copies = 0;
+    sc::cow_vector< Tracked > a( original ), b = original;
+    EXPECT_EQ( Tracked::copies, 0 );
+    EXPECT_EQ( original.use_count(), 3u );
+    EXPECT_EQ( a.get().data(), original.get().data() );
+    EXPECT_EQ( a, original );
+
+    // The first modification of a copy detaches it, once.
+    a.push_back( Tracked( 10 ) );
+    a.set( 0, Tracked( -1 ) );
+    a.pop_back();
+    EXPECT_EQ( Tracked::copies, 10 );
+    EXPECT_EQ( original.use_count(), 2u );
+    EXPECT_EQ( a.use_count(), 1u );
+    EXPECT_EQ( a[0].value, -1 );
+    EXPECT_EQ( original.get()[0].value, 0 ); // original[0] would expose, and so detach, the buffer b shares.
+    EXPECT_NE( a, original );
+
+    // Clearing a shared copy drops the buffer instead of copying it.
+    b.clear();
+    EXPECT_TRUE( b.empty() );
+    EXPECT_EQ( original.use_count(), 1u );
+    EXPECT_EQ( Tracked::copies, 10 );
+    EXPECT_EQ( original.size(), 10u );
+
+    sc::cow_vector< Tracked > moved( std::move( original ) );
+    EXPECT_TRUE( original.empty() );
+    EXPECT_EQ( original.use_count(), 0u );
+    EXPECT_EQ( moved.back().value, 9 );
+    EXPECT_THROW( original.pop_back(), std::out_of_range );
+    EXPECT_THROW( moved.set( 10, Tracked( 0 ) ), std::out_of_range );
+}
+
+TEST(CowVector, MutableAccessStopsSharing)
+{
+    sc::cow_vector< int > vec = { 1, 2, 3, 4 };
+    int & first = vec[0];
+    sc::cow_vector< int > copy( vec );
+    EXPECT_NE( copy.get().data(), vec.get().data() );
+
+    // Writing through the old reference can't reach the copy.
+    first = 100;
+    EXPECT_EQ( vec[0], 100 );
+    EXPECT_EQ( copy[0], 1 );
+
+    copy.insert( copy.cbegin() + 1, 7 );
+    copy.erase( copy.cend() - 1 );
+    const sc::cow_vector< int > & view = copy;
+    EXPECT_EQ( view.get(), sc::vector< int >( { 1, 7, 2, 3 } ) );
+}
+
+TEST(CowVector, ThreadsDetachTheirCopies)
+{
+    sc::cow_vector< int > shared_buffer( sc::vector< int >( { 0, 1, 2, 3, 4, 5, 6, 7 } ) );
+
+    std::vector< std::thread > threads;
+    for ( int t = 0 ; t < 4 ; ++t )
+        threads.emplace_back( [&shared_buffer, t]( )
+        {
+            for ( int i = 0 ; i < 200 ; ++i )
+            {
+                sc::cow_vector< int > copy( shared_buffer );
+                copy.set( t, -t );
+                EXPECT_EQ( copy[t], -t );
+            }
+        } );
+    for ( auto & thread : threads )
+        thread.join();
+
+    EXPECT_EQ( shared_buffer.use_count(), 1u );
+    EXPECT_EQ( shared_buffer.get(), sc::vector< int >( { 0, 1, 2, 3, 4, 5, 6, 7 } ) );
+}
+
+TEST(SegmentedVector, StableReferences)
+{
+    // 16 ints per chunk, so the elements spread over many of them.
+    typedef sc::segmented_vector< int, 64 > Small;
+    EXPECT_EQ( Small::chunk_size, 16u );
+    struct Twelve { int values[3]; };
+    EXPECT_EQ( ( sc::segmented_vector< Twelve, 100 >::chunk_size ), 8u );
+
+    Small vec;
+    int & first = vec.emplace_back( 0 );
+    const int * sixteenth = nullptr;
+    for ( int i = 1 ; i < 1000 ; ++i )
+    {
+        vec.push_back( i );
+        if ( i == 15 )
+            sixteenth = &vec.back();
+    }
+    EXPECT_EQ( &first, &vec[0] );
+    EXPECT_EQ( sixteenth, &vec[15] );
+    EXPECT_EQ( vec.size(), 1000u );
+    EXPECT_EQ( vec.capacity(), 1008u );
+    for ( int i = 0 ; i < 1000 ; ++i )
+        ASSERT_EQ( vec[i], i );
+    EXPECT_EQ( std::accumulate( vec.begin(), vec.end(), 0 ), 999 * 1000 / 2 );
+    EXPECT_THROW( vec.at( 1000 ), std::out_of_range );
+
+    // One call per chunk, the last one partial.
+    std::vector< std::size_t > runs;
+    vec.for_each_segment( [&runs]( int * first, int * last ) { runs.push_back( last - first ); } );
+    ASSERT_EQ( runs.size(), 63u );
+    EXPECT_EQ( runs.front(), 16u );
+    EXPECT_EQ( runs.back(), 8u );
+
+    sc::vector< int > flat = vec.flatten();
+    ASSERT_EQ( flat.size(), 1000u );
+    EXPECT_TRUE( std::equal( flat.begin(), flat.end(), vec.begin() ) );
+}
+
+TEST(SegmentedVector, CapacityAndCopies)
+{
+    Tracked::alive = 0;
+    {
+        sc::segmented_vector< Tracked, 64 > vec;
+        vec.reserve( 40 );
+        EXPECT_EQ( vec.capacity(), 48u );
+        for ( int i = 0 ; i < 40 ; ++i )
+            vec.emplace_back( i );
+        EXPECT_EQ( vec.capacity(), 48u );
+
+        sc::segmented_vector< Tracked, 64 > copy( vec );
+        EXPECT_EQ( copy, vec );
+        EXPECT_EQ( Tracked::alive, 80 );
+
+        copy.pop_back();
+        copy.pop_back();
+        EXPECT_EQ( copy.back().value, 37 );
+        EXPECT_NE( copy, vec );
+
+        vec = std::move( copy );
+        EXPECT_EQ( vec.size(), 38u );
+        EXPECT_EQ( Tracked::alive, 38 );
+
+        vec.clear();
+        EXPECT_TRUE( vec.empty() );
+        EXPECT_EQ( vec.capacity(), 48u );
+        vec.shrink_to_fit();
+        EXPECT_EQ( vec.capacity(), 0u );
+        EXPECT_THROW( vec.pop_back(), std::out_of_range );
+
+        vec = { Tracked( 1 ), Tracked( 2 ) };
+        EXPECT_EQ( vec.front().value, 1 );
+    }
+    EXPECT_EQ( Tracked::alive, 0 );
+}
+
+TEST(VectorBool, PackedBits)
+{
+    sc::vector< bool > bits;
+    for ( int i = 0 ; i < 200 ; ++i )
+        bits.push_back( i % 3 == 0 );
+    EXPECT_EQ( bits.size(), 200u );
+    EXPECT_EQ( bits.word_count(), 4u );
+    EXPECT_LE( bits.capacity(), 256u );
+    EXPECT_EQ( bits.count(), 67u );
+
+    for ( int i = 0 ; i < 200 ; ++i )
+        ASSERT_EQ( bits[i], i % 3 == 0 );
+
+    // Writes through the proxy references, as with bool&.
+    bits[1] = true;
+    bits.at( 0 ) = false;
+    bits.flip( 2 );
+    auto it = bits.begin() + 3;
+    *it = false;
+    EXPECT_EQ( std::count( bits.cbegin(), bits.cend(), true ), 67 );
+    EXPECT_TRUE( bits[1] );
+    EXPECT_FALSE( bits[0] );
+    EXPECT_TRUE( bits[2] );
+    EXPECT_THROW( bits.at( 200 ), std::out_of_range );
+
+    bits.pop_back();
+    bits.resize( 130 );
+    EXPECT_EQ( bits.count(), std::size_t( std::count( bits.begin(), bits.end(), true ) ) );
+    bits.resize( 300, true );
+    EXPECT_EQ( bits.size(), 300u );
+    EXPECT_TRUE( bits[299] );
+    EXPECT_TRUE( bits[130] );
+    EXPECT_FALSE( bits[128] );
+
+    sc::vector< bool > copy( bits );
+    EXPECT_EQ( copy, bits );
+    copy.flip();
+    EXPECT_EQ( copy.count(), 300 - bits.count() );
+    EXPECT_NE( copy, bits );
+}
+
+TEST(VectorBool, WordOperations)
+{
+    sc::vector< bool > bits( 1000, false );
+    EXPECT_TRUE( bits.none() );
+    EXPECT_EQ( bits.find_first(), sc::vector< bool >::npos );
+
+    // Ranges inside one word, across two and across many.
+    bits.set( 3, 9, true );
+    bits.set( 60, 70, true );
+    bits.set( 200, 900, true );
+    EXPECT_EQ( bits.count(), 6u + 10u + 700u );
+    bits.reset( 250, 850 );
+    EXPECT_EQ( bits.count(), 6u + 10u + 100u );
+    EXPECT_THROW( bits.set( 10, 1001, true ), std::out_of_range );
+
+    std::vector< std::size_t > found;
+    for ( auto i = bits.find_first() ; i != sc::vector< bool >::npos ; i = bits.find_next( i ) )
+        found.push_back( i );
+    ASSERT_EQ( found.size(), bits.count() );
+    EXPECT_EQ( found.front(), 3u );
+    EXPECT_EQ( found[6], 60u );
+    EXPECT_EQ( found.back(), 899u );
+    EXPECT_EQ( bits.find_next( 999 ), sc::vector< bool >::npos );
+
+    sc::vector< bool > evens;
+    for ( int i = 0 ; i < 1000 ; ++i )
+        evens.push_back( i % 2 == 0 );
+
+    EXPECT_EQ( ( bits & evens ).count(), 3u + 5u + 50u );
+    EXPECT_EQ( ( bits | evens ).count(), 500u + 3u + 5u + 50u );
+    EXPECT_EQ( ( bits ^ evens ).count(), 500u + 3u + 5u + 50u - ( 3u + 5u + 50u ) );
+    EXPECT_THROW( bits &= sc::vector< bool >( 999, true ), std::invalid_argument );
+
+    sc::vector< bool > full( 130, true );
+    EXPECT_TRUE( full.all() );
+    full.reset();
+    EXPECT_TRUE( full.none() );
+    full.set();
+    EXPECT_EQ( full.count(), 130u );
+    EXPECT_EQ( full, sc::vector< bool >( 130, true ) );
+
+    // Flipped ranges inside one word, across two, and over the whole vector.
+    full.flip( 2, 5 );
+    full.flip( 60, 70 );
+    EXPECT_EQ( full.count(), 130u - 3u - 10u );
+    full.flip( 0, 130 );
+    EXPECT_EQ( full.count(), 3u + 10u );
+    EXPECT_EQ( full.find_first(), 2u );
+    EXPECT_EQ( full.find_next( 4 ), 60u );
+    EXPECT_THROW( full.flip( 10, 131 ), std::out_of_range );
+    EXPECT_EQ( sc::vector< bool >( { true, false, true } ).count(), 2u );
+}
+
+TEST(FlatSet, SortedUniqueKeys)
+{
+    sc::flat_set< int > set { 5, 1, 3, 1, 5 };
+    EXPECT_EQ( set.size(), 3u );
+    EXPECT_TRUE( std::is_sorted( set.begin(), set.end() ) );
+    EXPECT_TRUE( set.contains( 3 ) );
+    EXPECT_FALSE( set.contains( 2 ) );
+    EXPECT_EQ( set.find( 4 ), set.end() );
+    EXPECT_EQ( *set.lower_bound( 2 ), 3 );
+    EXPECT_EQ( *set.upper_bound( 3 ), 5 );
+    EXPECT_EQ( set.lower_bound( 6 ), set.end() );
+    EXPECT_EQ( set.upper_bound( 0 ), set.begin() );
+
+    EXPECT_TRUE( set.insert( 4 ).second );
+    EXPECT_FALSE( set.insert( 4 ).second );
+    EXPECT_EQ( set, sc::flat_set< int >( { 1, 3, 4, 5 } ) );
+    EXPECT_EQ( set.erase( 3 ), 1u );
+    EXPECT_EQ( set.erase( 3 ), 0u );
+    EXPECT_EQ( *set.erase( set.begin() ), 4 );
+
+    // Every lower_bound and upper_bound agrees with the std ones, at every size.
+    for ( int n = 0 ; n < 70 ; ++n )
+    {
+        sc::vector< int > keys( n );
+        for ( int i = 0 ; i < n ; ++i )
+            keys.push_back( 2 * i );
+        const sc::flat_set< int > evens( sc::sorted_unique, keys );
+        for ( int key = -1 ; key <= 2 * n ; ++key )
+        {
+            ASSERT_EQ( evens.lower_bound( key ) - evens.begin(), std::lower_bound( keys.begin(), keys.end(), key ) - keys.begin() );
+            ASSERT_EQ( evens.upper_bound( key ) - evens.begin(), std::upper_bound( keys.begin(), keys.end(), key ) - keys.begin() );
+        }
+    }
+}
+
+TEST(FlatSet, BulkInsertion)
+{
+    sc::flat_set< int > set { 10, 20, 30 };
+    set.insert_range( { 25, 5, 20, 35, 5 } );
+    EXPECT_EQ( set, sc::flat_set< int >( sc::sorted_unique, { 5, 10, 20, 25, 30, 35 } ) );
+
+    sc::flat_set< std::string, std::greater< std::string > > words;
+    for ( const char * word : { "pear", "apple", "fig", "apple", "kiwi" } )
+        words.append_unsorted( word );
+    words.sort_unique();
+    EXPECT_EQ( words.keys(), sc::vector< std::string >( { "pear", "kiwi", "fig", "apple" } ) );
+    EXPECT_TRUE( words.contains( "fig" ) );
+}
+
+TEST(FlatMap, LookupAndColumns)
+{
+    sc::flat_map< int, std::string > map { { 3, "three" }, { 1, "one" }, { 2, "two" }, { 1, "uno" } };
+    EXPECT_EQ( map.size(), 3u );
+    EXPECT_EQ( map.at( 1 ), "one" );
+    EXPECT_THROW( map.at( 4 ), std::out_of_range );
+    EXPECT_EQ( map.keys(), sc::vector< int >( { 1, 2, 3 } ) );
+    EXPECT_EQ( map.values(), sc::vector< std::string >( { "one", "two", "three" } ) );
+
+    map[4] = "four";
+    map[2] += "!";
+    EXPECT_EQ( map.find( 2 )->second, "two!" );
+    EXPECT_EQ( map.find( 5 ), map.end() );
+    EXPECT_FALSE( map.try_emplace( 4, "cuatro" ).second );
+    EXPECT_TRUE( map.insert( std::make_pair( 0, std::string( "zero" ) ) ).second );
+
+    int previous = -1;
+    for ( const auto & entry : map )
+    {
+        EXPECT_LT( previous, entry.first );
+        previous = entry.first;
+    }
+    EXPECT_EQ( previous, 4 );
+
+    EXPECT_EQ( map.erase( 0 ), 1u );
+    EXPECT_EQ( ( *map.lower_bound( 3 ) ).second, "three" );
+    EXPECT_EQ( map.upper_bound( 4 ), map.end() );
+    EXPECT_THROW( ( sc::flat_map< int, int >( sc::vector< int >( { 1, 2 } ), sc::vector< int >( { 1 } ) ) ), std::invalid_argument );
+}
+
+TEST(FlatMap, BulkInsertionKeepsTheFirstValue)
+{
+    sc::flat_map< int, int > map { { 10, 1 }, { 20, 2 } };
+    map.insert_range( { { 20, -1 }, { 15, 3 }, { 5, 4 }, { 15, -1 } } );
+    EXPECT_EQ( map.keys(), sc::vector< int >( { 5, 10, 15, 20 } ) );
+    EXPECT_EQ( map.values(), sc::vector< int >( { 4, 1, 3, 2 } ) );
+
+    // Build mode: append everything, sort once.
+    sc::flat_map< int, int > squares;
+    for ( int i = 999 ; i >= 0 ; --i )
+        squares.append_unsorted( i % 500, i * i );
+    squares.sort_unique();
+    ASSERT_EQ( squares.size(), 500u );
+    for ( int i = 0 ; i < 500 ; ++i )
+        ASSERT_EQ( squares.at( i ), ( i + 500 ) * ( i + 500 ) );
+}
+
+struct CountingObserver : sc::vector_observer
+{
+    int allocations = 0, reallocations = 0;
+    std::size_t shifted = 0;
+
+    void on_allocate( const void *, std::size_t ) override { ++allocations; }
+    void on_reallocate( const void *, std::size_t, std::size_t, std::size_t ) override { ++reallocations; }
+    void on_shift( const void *, std::size_t elements, std::size_t ) override { shifted += elements; }
+};
+
+TEST(VectorStats, CountsGrowthAndShifts)
+{
+    sc::reset_global_vector_stats();
+    CountingObserver observer;
+    sc::set_vector_observer( &observer );
+
+    sc::vector< int > vec;
+    vec.reserve( 4 );
+    for ( int i = 0 ; i < 6 ; ++i )
+        vec.push_back( i );
+    vec.insert( vec.begin() + 2, 42 ); // Fits the capacity: shifts 4 elements.
+    vec.erase( vec.begin() );
+    sc::vector_stats stats = vec.stats();
+
+    sc::set_vector_observer( nullptr );
+    EXPECT_EQ( stats.wasted_bytes, ( vec.capacity() - vec.size() ) * sizeof( int ) );
+
+#ifdef SC_VECTOR_STATS
+    // reserve(4) allocates, the fifth push_back moves the 4 elements to a larger block.
+    EXPECT_GE( stats.allocations, 2u );
+    EXPECT_GE( stats.reallocations, 2u );
+    EXPECT_GE( stats.bytes_copied, 4 * sizeof( int ) );
+    EXPECT_EQ( stats.shifts, 4u + 6u );
+    EXPECT_EQ( stats.peak_capacity_bytes, vec.capacity() * sizeof( int ) );
+
+    EXPECT_EQ( observer.allocations, int( stats.allocations ) );
+    EXPECT_EQ( observer.reallocations, int( stats.reallocations ) );
+    EXPECT_EQ( observer.shifted, stats.shifts );
+
+    sc::vector_stats global = sc::global_vector_stats();
+    EXPECT_GE( global.allocations, stats.allocations );
+    EXPECT_EQ( global.shifts, stats.shifts );
+#else
+    EXPECT_EQ( stats.allocations, 0u );
+    EXPECT_EQ( stats.shifts, 0u );
+    EXPECT_EQ( observer.allocations, 0 );
+    EXPECT_EQ( sc::global_vector_stats().allocations, 0u );
+#endif
+
+    vec.clear();
+    EXPECT_EQ( vec.stats().wasted_bytes, vec.capacity() * sizeof( int ) );
+}
+
+TEST(VectorStats, PeakFollowsAllocatorReallocate)
+{
+    sc::reset_global_vector_stats();
+
+    // Past the 4 KiB threshold the block grows through mremap_allocator::reallocate, not allocate.
+    sc::vector< int, sc::mremap_allocator< int, 4096 > > vec;
+    for ( int i = 0 ; i < 100000 ; ++i )
+        vec.push_back( i );
+    sc::vector_stats stats = vec.stats();
+    EXPECT_EQ( stats.wasted_bytes, ( vec.capacity() - vec.size() ) * sizeof( int ) );
+
+#ifdef SC_VECTOR_STATS
+    EXPECT_GT( stats.reallocations, 0u );
+    EXPECT_EQ( stats.peak_capacity_bytes, vec.capacity() * sizeof( int ) );
+    EXPECT_GE( sc::global_vector_stats().peak_capacity_bytes, stats.peak_capacity_bytes );
+#endif
+}
+
+TEST(VectorStats, Json)
+{
+    sc::vector_stats stats = sc::vector_stats();
+    stats.allocations = 3;
+    stats.shifts = 7;
+    EXPECT_EQ( sc::to_json( stats ), "{\"allocations\": 3, \"reallocations\": 0, \"bytes_copied\": 0, "
+                                     "\"shifts\": 7, \"peak_capacity_bytes\": 0, \"wasted_bytes\": 0}" );
+}
+
+#if __cplusplus >= 202002L
+constexpr sc::static_vector< int, 16 > squares( void )
+{
+    sc::static_vector< int, 16 > table;
+    for( int i = 0; table.try_push_back( i * i ); ++i );
+    return table;
+}
+
+// Every modifier and the iterators, in a constant expression.
+constexpr int edited( void )
+{
+    sc::static_vector< int, 8 > vec { 3, 4, 5 };
+    vec.push_front( 1 );
+    vec.insert( vec.begin() + 1, 2 );
+    vec.insert( vec.end(), { 6, 7 } );
+    vec.emplace( vec.end(), 8 );
+    vec.erase( vec.begin() + 2 );
+    vec.erase( vec.begin(), vec.begin() + 2 );
+    vec.pop_front();
+    vec.pop_back();
+
+    int digits = 0;
+    for( int value : vec )
+        digits = digits * 10 + value;
+    return digits;
+}
+
+TEST(StaticVector, ConstexprTable)
+{
+    constexpr auto table = squares();
+    static_assert( table.size() == 16, "the table is built at compile time" );
+    static_assert( table[15] == 225, "the table is built at compile time" );
+    EXPECT_EQ( table.back(), 225 );
+
+    static_assert( edited() == 567, "insert and erase run at compile time" );
+    constexpr sc::static_vector< int, 8 > partial { 1, 2 };
+    static_assert( partial.size() == 2 and partial.end() - partial.begin() == 2, "a partly filled vector is a constant" );
+}
+#endif
+
 
 int main(int argc, char** argv)
 {